@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2019 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Assets/Palette.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/Reader.h"
+
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST_CASE("PaletteBenchmark.benchIndexedToRgba", "[PaletteBenchmark]") {
+            auto paletteData = std::vector<unsigned char>(768);
+            for (size_t i = 0; i < paletteData.size(); ++i) {
+                paletteData[i] = static_cast<unsigned char>(i);
+            }
+            const auto palette = Palette(paletteData);
+
+            // a 256x256 texture with all of its mip levels
+            const auto pixelCount = size_t(256 * 256 + 128 * 128 + 64 * 64 + 32 * 32);
+
+            // textures contain runs of the same index, so only change the index every few pixels
+            auto rng = std::mt19937(0);
+            auto dist = std::uniform_int_distribution<int>(0, 255);
+            auto indices = std::vector<char>(pixelCount);
+            for (size_t i = 0; i < pixelCount; ++i) {
+                indices[i] = static_cast<char>(i % 4 == 0 ? dist(rng) : indices[i - 1]);
+            }
+
+            auto rgbaImage = TextureBuffer(4 * pixelCount);
+            auto averageColor = Color();
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < 1000; ++i) {
+                    auto reader = IO::Reader::from(indices.data(), indices.data() + indices.size()).buffer();
+                    palette.indexedToRgba(reader, pixelCount, rgbaImage, PaletteTransparency::Index255Transparent, averageColor);
+                }
+            }, "Convert 1000 indexed 256x256 textures with mipmaps to RGBA");
+        }
+    }
+}
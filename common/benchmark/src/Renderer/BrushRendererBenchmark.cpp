@@ -26,6 +26,7 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
 
 #include <kdl/result.h>
 
@@ -131,6 +132,29 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(brushes);
             kdl::vec_clear_and_delete(textures);
         }
+
+        TEST_CASE("BrushRendererBenchmark.benchValidateColdCaches", "[BrushRendererBenchmark]") {
+            auto brushesTextures = makeBrushes();
+            std::vector<Model::BrushNode*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+            // this is what happens after loading a map: no brush has its vertices cached yet
+            for (auto* brush : brushes) {
+                brush->brushRendererBrushCache().invalidateVertexCache();
+            }
+
+            BrushRenderer r;
+            r.addBrushes(brushes);
+
+            timeLambda([&](){
+                if (!r.valid()) {
+                    r.validate();
+                }
+            }, "validate " + std::to_string(brushes.size()) + " brushes with cold vertex caches");
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(textures);
+        }
     }
 }
 
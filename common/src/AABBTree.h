@@ -28,8 +28,11 @@
 #include <vecmath/intersection.h>
 
 #include <cassert>
+#include <functional>
 #include <iosfwd>
+#include <queue>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -273,6 +276,24 @@ namespace TrenchBroom {
                 return m_height;
             }
 
+            /**
+             * Returns the left child of this node.
+             *
+             * @return the left child
+             */
+            const Node* left() const {
+                return m_left;
+            }
+
+            /**
+             * Returns the right child of this node.
+             *
+             * @return the right child
+             */
+            const Node* right() const {
+                return m_right;
+            }
+
             std::pair<Node*, LeafNode*> insert(const Box& bounds, const U& data) override {
                 // Select the subtree which is increased the least by inserting a node with the given bounds.
                 // Then insert the node into that subtree and update our reference to it.
@@ -652,6 +673,61 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Visits every data item in this tree whose bounding box intersects with the given ray in order of increasing
+         * distance from the ray origin to the bounding box. The visitor is passed the data item and the distance at
+         * which the ray enters its bounding box (or 0 if the ray origin is contained in it). Since the distance of any
+         * hit against a data item cannot be less than this distance, callers that are only interested in the closest
+         * hits can stop the traversal as soon as the distance exceeds the closest hit found so far.
+         *
+         * The traversal stops as soon as the visitor returns false.
+         *
+         * @tparam F the visitor type, must be callable as `bool(const U&, T)`
+         * @param ray the ray to test
+         * @param visitor the visitor to call
+         */
+        template <typename F>
+        void findIntersectorsByDistance(const vm::ray<T,S>& ray, F&& visitor) const {
+            if (!empty()) {
+                using Entry = std::pair<T, const Node*>;
+                std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+                const auto enqueue = [&](const Node* node) {
+                    const auto distance = intersectBounds(ray, node->bounds());
+                    if (!vm::is_nan(distance)) {
+                        queue.emplace(distance, node);
+                    }
+                };
+
+                auto currentDistance = T(0);
+                auto proceed = true;
+                LambdaVisitor nodeVisitor(
+                    [&](const InnerNode* innerNode) {
+                        enqueue(innerNode->left());
+                        enqueue(innerNode->right());
+                        // children are visited in order of their distances, so don't recurse here
+                        return false;
+                    },
+                    [&](const LeafNode* leaf) {
+                        proceed = visitor(leaf->data(), currentDistance);
+                    }
+                );
+
+                enqueue(m_root);
+                while (proceed && !queue.empty()) {
+                    const auto [distance, node] = queue.top();
+                    queue.pop();
+
+                    currentDistance = distance;
+                    node->accept(nodeVisitor);
+                }
+            }
+        }
+    private:
+        static T intersectBounds(const vm::ray<T,S>& ray, const Box& bounds) {
+            return bounds.contains(ray.origin) ? T(0) : vm::intersect_ray_bbox(ray, bounds);
+        }
+    public:
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -20,6 +20,7 @@
 #include "EntityModel.h"
 
 #include "AABBTree.h"
+#include "Assets/EntityModelLod.h"
 #include "Assets/TextureCollection.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/PrimType.h"
@@ -30,7 +31,10 @@
 #include <vecmath/bbox.h>
 #include <vecmath/intersection.h>
 
+#include <map>
+#include <optional>
 #include <string>
+#include <tuple>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -213,6 +217,7 @@ namespace TrenchBroom {
         class EntityModelMesh {
         private:
             std::vector<EntityModelVertex> m_vertices;
+            vm::bbox3f m_bounds;
         protected:
             /**
              * Creates a new frame mesh that uses the given vertices.
@@ -220,10 +225,25 @@ namespace TrenchBroom {
              * @param vertices the vertices
              */
             explicit EntityModelMesh(const std::vector<EntityModelVertex>& vertices) :
-            m_vertices(vertices) {}
+            m_vertices(vertices) {
+                vm::bbox3f::builder bounds;
+                for (const auto& vertex : m_vertices) {
+                    bounds.add(Renderer::getVertexComponent<0>(vertex));
+                }
+                if (bounds.initialized()) {
+                    m_bounds = bounds.bounds();
+                }
+            }
         public:
             virtual ~EntityModelMesh() = default;
         public:
+            /**
+             * Returns the bounds of this mesh's vertices.
+             */
+            const vm::bbox3f& bounds() const {
+                return m_bounds;
+            }
+
             /**
              * Returns a renderer that renders this mesh with the given texture.
              *
@@ -234,6 +254,29 @@ namespace TrenchBroom {
                 const auto vertexArray = Renderer::VertexArray::ref(m_vertices);
                 return doBuildRenderer(skin, vertexArray);
             }
+
+            /**
+             * Computes the simplified version of this mesh unless it was computed before.
+             */
+            void simplify() {
+                doSimplify();
+            }
+
+            /**
+             * Returns a renderer that renders a simplified version of this mesh with the given texture. The simplified
+             * mesh is computed when this function is called for the first time unless simplify() was called before.
+             *
+             * @param skin the texture to use when rendering the mesh
+             * @return the renderer or null if the simplified mesh is empty
+             */
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildSimplifiedRenderer(const Texture* skin) {
+                doSimplify();
+                return doBuildSimplifiedRenderer(skin);
+            }
+        protected:
+            const std::vector<EntityModelVertex>& vertices() const {
+                return m_vertices;
+            }
         private:
             /**
              * Creates and returns the actual mesh renderer
@@ -243,6 +286,9 @@ namespace TrenchBroom {
              * @return the renderer
              */
             virtual std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(const Texture* skin, const Renderer::VertexArray& vertices) = 0;
+
+            virtual void doSimplify() = 0;
+            virtual std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildSimplifiedRenderer(const Texture* skin) = 0;
         };
 
         // EntityModel::IndexedMesh
@@ -253,6 +299,7 @@ namespace TrenchBroom {
         class EntityModelIndexedMesh : public EntityModelMesh {
         private:
             EntityModelIndices m_indices;
+            std::optional<std::vector<EntityModelVertex>> m_simplifiedVertices;
         public:
             /**
              * Creates a new frame mesh with the given vertices and indices.
@@ -273,6 +320,26 @@ namespace TrenchBroom {
                 const Renderer::TexturedIndexRangeMap texturedIndices(skin, m_indices);
                 return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, texturedIndices);
             }
+
+            void doSimplify() override {
+                if (!m_simplifiedVertices) {
+                    std::vector<EntityModelVertex> triangles;
+                    m_indices.forEachPrimitive([&](const Renderer::PrimType primType, const size_t index, const size_t count) {
+                        appendTriangles(vertices(), primType, index, count, triangles);
+                    });
+                    m_simplifiedVertices = decimateTriangles(triangles, SimplifiedMeshResolution);
+                }
+            }
+
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildSimplifiedRenderer(const Texture* skin) override {
+                if (m_simplifiedVertices->empty()) {
+                    return nullptr;
+                }
+
+                const auto vertexArray = Renderer::VertexArray::ref(*m_simplifiedVertices);
+                const auto indices = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0u, m_simplifiedVertices->size());
+                return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertexArray, skin, indices);
+            }
         };
 
         // EntityModel::TexturedMesh
@@ -283,6 +350,8 @@ namespace TrenchBroom {
         class EntityModelTexturedMesh : public EntityModelMesh {
         private:
             EntityModelTexturedIndices m_indices;
+            std::optional<std::vector<EntityModelVertex>> m_simplifiedVertices;
+            EntityModelTexturedIndices m_simplifiedIndices;
         public:
             /**
              * Creates a new frame mesh with the given vertices and per texture indices.
@@ -302,14 +371,51 @@ namespace TrenchBroom {
             std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(const Texture* /* skin */, const Renderer::VertexArray& vertices) override {
                 return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, m_indices);
             }
+
+            void doSimplify() override {
+                if (!m_simplifiedVertices) {
+                    // the triangles of each texture are simplified separately
+                    std::map<const Texture*, std::vector<EntityModelVertex>> trianglesByTexture;
+                    m_indices.forEachPrimitive([&](const Texture* texture, const Renderer::PrimType primType, const size_t index, const size_t count) {
+                        appendTriangles(vertices(), primType, index, count, trianglesByTexture[texture]);
+                    });
+
+                    std::vector<EntityModelVertex> simplifiedVertices;
+                    std::vector<std::tuple<const Texture*, size_t, size_t>> ranges;
+                    EntityModelTexturedIndices::Size size;
+
+                    for (const auto& [texture, triangles] : trianglesByTexture) {
+                        auto simplified = decimateTriangles(triangles, SimplifiedMeshResolution);
+                        if (!simplified.empty()) {
+                            size.inc(texture, Renderer::PrimType::Triangles);
+                            ranges.emplace_back(texture, simplifiedVertices.size(), simplified.size());
+                            simplifiedVertices.insert(std::end(simplifiedVertices), std::begin(simplified), std::end(simplified));
+                        }
+                    }
+
+                    m_simplifiedIndices = EntityModelTexturedIndices(size);
+                    for (const auto& [texture, index, count] : ranges) {
+                        m_simplifiedIndices.add(texture, Renderer::PrimType::Triangles, index, count);
+                    }
+                    m_simplifiedVertices = std::move(simplifiedVertices);
+                }
+            }
+
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildSimplifiedRenderer(const Texture* /* skin */) override {
+                if (m_simplifiedVertices->empty()) {
+                    return nullptr;
+                }
+
+                const auto vertexArray = Renderer::VertexArray::ref(*m_simplifiedVertices);
+                return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertexArray, m_simplifiedIndices);
+            }
         };
 
         // EntityModel::Surface
 
         EntityModelSurface::EntityModelSurface(const std::string& name, const size_t frameCount) :
         m_name(name),
-        m_meshes(frameCount),
-        m_skins(std::make_unique<TextureCollection>()) {}
+        m_meshes(frameCount) {}
 
         EntityModelSurface::~EntityModelSurface() = default;
 
@@ -318,11 +424,17 @@ namespace TrenchBroom {
         }
 
         void EntityModelSurface::prepare(const int minFilter, const int magFilter) {
-            m_skins->prepare(minFilter, magFilter);
+            for (auto& skin : m_skins) {
+                if (!skin->prepared()) {
+                    skin->prepare(minFilter, magFilter);
+                }
+            }
         }
 
         void EntityModelSurface::setTextureMode(const int minFilter, const int magFilter) {
-            m_skins->setTextureMode(minFilter, magFilter);
+            for (auto& skin : m_skins) {
+                skin->setTextureMode(minFilter, magFilter);
+            }
         }
 
         void EntityModelSurface::addIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) {
@@ -336,7 +448,17 @@ namespace TrenchBroom {
         }
 
         void EntityModelSurface::setSkins(std::vector<Texture> skins) {
-            m_skins = std::make_unique<TextureCollection>(std::move(skins));
+            m_skins.clear();
+            m_skins.reserve(skins.size());
+            for (auto& skin : skins) {
+                auto textures = std::vector<Texture>{};
+                textures.push_back(std::move(skin));
+                m_skins.push_back(std::make_shared<TextureCollection>(std::move(textures)));
+            }
+        }
+
+        void EntityModelSurface::setSkins(std::vector<std::shared_ptr<TextureCollection>> skins) {
+            m_skins = std::move(skins);
         }
 
         size_t EntityModelSurface::frameCount() const {
@@ -344,23 +466,52 @@ namespace TrenchBroom {
         }
 
         size_t EntityModelSurface::skinCount() const {
-            return m_skins->textureCount();
+            return m_skins.size();
         }
 
         const Texture* EntityModelSurface::skin(const std::string& name) const {
-            return m_skins->textureByName(name);
+            for (const auto& skin : m_skins) {
+                if (const auto* texture = skin->textureByName(name)) {
+                    return texture;
+                }
+            }
+            return nullptr;
         }
 
         const Texture* EntityModelSurface::skin(const size_t index) const {
-            return m_skins->textureByIndex(index);
+            if (index >= m_skins.size()) {
+                return nullptr;
+            }
+            return m_skins[index]->textureByIndex(0u);
         }
 
         std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(size_t skinIndex, size_t frameIndex) {
+            return buildRenderer(skinIndex, frameIndex, EntityModelLod::Full);
+        }
+
+        std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(const size_t skinIndex, const size_t frameIndex, const EntityModelLod lod) {
             if (skinIndex >= skinCount() || frameIndex >= frameCount() || m_meshes[frameIndex] == nullptr) {
                 return nullptr;
-            } else {
-                const auto* skin = this->skin(skinIndex);
-                return m_meshes[frameIndex]->buildRenderer(skin);
+            }
+
+            const auto* skin = this->skin(skinIndex);
+            switch (lod) {
+                case EntityModelLod::Full:
+                    return m_meshes[frameIndex]->buildRenderer(skin);
+                case EntityModelLod::Simplified:
+                    return m_meshes[frameIndex]->buildSimplifiedRenderer(skin);
+                case EntityModelLod::Proxy: {
+                    const auto vertices = buildProxyTriangles(m_meshes[frameIndex]->bounds());
+                    const auto indices = Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0u, vertices.size());
+                    return std::make_unique<Renderer::TexturedIndexRangeRenderer>(Renderer::VertexArray::copy(vertices), skin, indices);
+                }
+                switchDefault();
+            }
+        }
+
+        void EntityModelSurface::simplifyMesh(const size_t frameIndex) {
+            if (frameIndex < frameCount() && m_meshes[frameIndex] != nullptr) {
+                m_meshes[frameIndex]->simplify();
             }
         }
 
@@ -372,9 +523,13 @@ namespace TrenchBroom {
         m_pitchType(pitchType) {}
 
         std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(const size_t skinIndex, const size_t frameIndex) const {
+            return buildRenderer(skinIndex, frameIndex, EntityModelLod::Full);
+        }
+
+        std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(const size_t skinIndex, const size_t frameIndex, const EntityModelLod lod) const {
             std::vector<std::unique_ptr<Renderer::TexturedIndexRangeRenderer>> renderers;
             for (const auto& surface : m_surfaces) {
-                auto renderer = surface->buildRenderer(skinIndex, frameIndex);
+                auto renderer = surface->buildRenderer(skinIndex, frameIndex, lod);
                 if (renderer != nullptr) {
                     renderers.push_back(std::move(renderer));
                 }
@@ -386,6 +541,12 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModel::simplifyFrame(const size_t frameIndex) {
+            for (auto& surface : m_surfaces) {
+                surface->simplifyMesh(frameIndex);
+            }
+        }
+
         vm::bbox3f EntityModel::bounds(const size_t frameIndex) const {
             if (frameIndex >= m_frames.size()) {
                 return vm::bbox3f(8.0f);
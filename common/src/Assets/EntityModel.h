@@ -38,6 +38,7 @@ namespace TrenchBroom {
     }
 
     namespace Assets {
+        enum class EntityModelLod;
         class Texture;
         class TextureCollection;
 
@@ -159,12 +160,14 @@ namespace TrenchBroom {
          *
          * Each surface contains per frame meshes. The number of per frame meshes should match the number of frames
          * in the model.
+         *
+         * Every skin is held in a texture collection of its own, which may be shared with other surfaces.
          */
         class EntityModelSurface {
         private:
             std::string m_name;
             std::vector<std::unique_ptr<EntityModelMesh>> m_meshes;
-            std::unique_ptr<TextureCollection> m_skins;
+            std::vector<std::shared_ptr<TextureCollection>> m_skins;
         public:
             /**
              * Creates a new surface with the given name.
@@ -224,6 +227,14 @@ namespace TrenchBroom {
              */
             void setSkins(std::vector<Texture> skins);
 
+            /**
+             * Sets the given skins to this surface. Each texture collection contains one skin and may be shared with
+             * other surfaces, in which case it is prepared only once.
+             *
+             * @param skins the skins to set
+             */
+            void setSkins(std::vector<std::shared_ptr<TextureCollection>> skins);
+
             /**
              * Returns the number of frame meshes in this surface, should match the model's frame count.
              *
@@ -255,6 +266,24 @@ namespace TrenchBroom {
             const Texture* skin(size_t index) const;
 
             std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(size_t skinIndex, size_t frameIndex);
+
+            /**
+             * Creates a renderer for the given frame mesh at the given level of detail.
+             *
+             * @param skinIndex the index of the skin to use
+             * @param frameIndex the index of the frame to render
+             * @param lod the level of detail
+             * @return the renderer or null if the mesh is missing or empty at the given level of detail
+             */
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(size_t skinIndex, size_t frameIndex, EntityModelLod lod);
+
+            /**
+             * Computes the simplified mesh of the given frame so that building a simplified renderer later is cheap.
+             * Does nothing if the frame is not loaded.
+             *
+             * @param frameIndex the index of the frame
+             */
+            void simplifyMesh(size_t frameIndex);
         };
 
         /**
@@ -286,6 +315,25 @@ namespace TrenchBroom {
              */
             std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(size_t skinIndex, size_t frameIndex) const;
 
+            /**
+             * Creates a renderer to render the given frame of the model at the given level of detail. Simplified meshes
+             * are computed on demand, and proxies are built from the bounds of each surface.
+             *
+             * @param skinIndex the index of the skin to use
+             * @param frameIndex the index of the frame to render
+             * @param lod the level of detail
+             * @return the renderer
+             */
+            std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(size_t skinIndex, size_t frameIndex, EntityModelLod lod) const;
+
+            /**
+             * Computes the simplified meshes of the given frame for all surfaces. Models that are loaded in the
+             * background call this on the loading thread so that the main thread does not have to simplify them.
+             *
+             * @param frameIndex the index of the frame
+             */
+            void simplifyFrame(size_t frameIndex);
+
             /**
              * Returns the bounds of the given frame of this model.
              *
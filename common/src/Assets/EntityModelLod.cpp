@@ -0,0 +1,248 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelLod.h"
+
+#include "Ensure.h"
+#include "Macros.h"
+#include "Renderer/PrimType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/constants.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <ostream>
+#include <set>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        std::ostream& operator<<(std::ostream& str, const EntityModelLod lod) {
+            switch (lod) {
+                case EntityModelLod::Full:
+                    str << "Full";
+                    break;
+                case EntityModelLod::Simplified:
+                    str << "Simplified";
+                    break;
+                case EntityModelLod::Proxy:
+                    str << "Proxy";
+                    break;
+                switchDefault();
+            }
+            return str;
+        }
+
+        EntityModelLod selectEntityModelLod(const float projectedSize) {
+            if (projectedSize >= FullLodMinProjectedSize) {
+                return EntityModelLod::Full;
+            } else if (projectedSize >= SimplifiedLodMinProjectedSize) {
+                return EntityModelLod::Simplified;
+            } else {
+                return EntityModelLod::Proxy;
+            }
+        }
+
+        void appendTriangles(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count, std::vector<EntityModelVertex>& result) {
+            switch (primType) {
+                case Renderer::PrimType::Points:
+                case Renderer::PrimType::Lines:
+                case Renderer::PrimType::LineStrip:
+                case Renderer::PrimType::LineLoop:
+                    break;
+                case Renderer::PrimType::Triangles:
+                    assert(count % 3 == 0);
+                    result.insert(std::end(result),
+                                  std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(index)),
+                                  std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(index + count)));
+                    break;
+                case Renderer::PrimType::Polygon:
+                case Renderer::PrimType::TriangleFan:
+                    assert(count > 2);
+                    for (size_t i = 1; i < count - 1; ++i) {
+                        result.push_back(vertices[index]);
+                        result.push_back(vertices[index + i]);
+                        result.push_back(vertices[index + i + 1]);
+                    }
+                    break;
+                case Renderer::PrimType::TriangleStrip:
+                    assert(count > 2);
+                    for (size_t i = 0; i < count - 2; ++i) {
+                        // every other triangle of a strip has reversed winding
+                        const size_t second = i % 2 == 0 ? i + 1 : i + 2;
+                        const size_t third = i % 2 == 0 ? i + 2 : i + 1;
+                        result.push_back(vertices[index + i]);
+                        result.push_back(vertices[index + second]);
+                        result.push_back(vertices[index + third]);
+                    }
+                    break;
+                case Renderer::PrimType::Quads:
+                    assert(count % 4 == 0);
+                    for (size_t i = 0; i + 3 < count; i += 4) {
+                        result.push_back(vertices[index + i + 0]);
+                        result.push_back(vertices[index + i + 1]);
+                        result.push_back(vertices[index + i + 2]);
+                        result.push_back(vertices[index + i + 0]);
+                        result.push_back(vertices[index + i + 2]);
+                        result.push_back(vertices[index + i + 3]);
+                    }
+                    break;
+                case Renderer::PrimType::QuadStrip:
+                    assert(count > 3);
+                    for (size_t i = 0; i + 3 < count; i += 2) {
+                        result.push_back(vertices[index + i + 0]);
+                        result.push_back(vertices[index + i + 1]);
+                        result.push_back(vertices[index + i + 3]);
+                        result.push_back(vertices[index + i + 0]);
+                        result.push_back(vertices[index + i + 3]);
+                        result.push_back(vertices[index + i + 2]);
+                    }
+                    break;
+                switchDefault();
+            }
+        }
+
+        namespace {
+            struct Cell {
+                vm::vec3f sum;
+                size_t count;
+            };
+        }
+
+        std::vector<EntityModelVertex> decimateTriangles(const std::vector<EntityModelVertex>& triangles, const size_t cellsPerAxis) {
+            ensure(cellsPerAxis > 0u, "cellsPerAxis must be positive");
+            assert(triangles.size() % 3u == 0u);
+
+            if (triangles.empty()) {
+                return {};
+            }
+
+            vm::bbox3f::builder boundsBuilder;
+            for (const auto& vertex : triangles) {
+                boundsBuilder.add(Renderer::getVertexComponent<0>(vertex));
+            }
+            const auto bounds = boundsBuilder.bounds();
+
+            auto cellSize = bounds.size() / static_cast<float>(cellsPerAxis);
+            for (size_t i = 0; i < 3; ++i) {
+                // flat models must not yield a zero cell size
+                cellSize[i] = std::max(cellSize[i], vm::Cf::almost_zero());
+            }
+
+            const auto cellIndex = [&](const vm::vec3f& position) {
+                size_t result = 0u;
+                for (size_t i = 0; i < 3; ++i) {
+                    const auto coord = std::floor((position[i] - bounds.min[i]) / cellSize[i]);
+                    const auto clamped = std::min(static_cast<size_t>(std::max(coord, 0.0f)), cellsPerAxis - 1u);
+                    result = result * cellsPerAxis + clamped;
+                }
+                return result;
+            };
+
+            std::vector<size_t> vertexCells;
+            vertexCells.reserve(triangles.size());
+
+            std::unordered_map<size_t, Cell> cells;
+            for (const auto& vertex : triangles) {
+                const auto& position = Renderer::getVertexComponent<0>(vertex);
+                const auto index = cellIndex(position);
+                vertexCells.push_back(index);
+
+                auto& cell = cells[index];
+                cell.sum = cell.sum + position;
+                ++cell.count;
+            }
+
+            const auto cellPosition = [&](const size_t index) {
+                const auto& cell = cells.at(index);
+                return cell.sum / static_cast<float>(cell.count);
+            };
+
+            std::vector<EntityModelVertex> result;
+            std::set<std::array<size_t, 3>> emittedTriangles;
+
+            for (size_t i = 0; i < triangles.size(); i += 3u) {
+                const auto c1 = vertexCells[i + 0u];
+                const auto c2 = vertexCells[i + 1u];
+                const auto c3 = vertexCells[i + 2u];
+                if (c1 == c2 || c2 == c3 || c3 == c1) {
+                    continue;
+                }
+
+                // rotate the cell indices so that the smallest comes first, this retains the winding order
+                auto key = std::array<size_t, 3>{ c1, c2, c3 };
+                std::rotate(std::begin(key), std::min_element(std::begin(key), std::end(key)), std::end(key));
+                if (!emittedTriangles.insert(key).second) {
+                    continue;
+                }
+
+                for (size_t j = 0; j < 3u; ++j) {
+                    const auto& vertex = triangles[i + j];
+                    result.emplace_back(cellPosition(vertexCells[i + j]), Renderer::getVertexComponent<1>(vertex));
+                }
+            }
+
+            return result;
+        }
+
+        std::vector<EntityModelVertex> buildProxyTriangles(const vm::bbox3f& bounds) {
+            const auto& min = bounds.min;
+            const auto& max = bounds.max;
+
+            // the eight corners of the box, indexed by their x, y and z bits
+            const auto corner = [&](const size_t i) {
+                return vm::vec3f(
+                    (i & 1u) ? max.x() : min.x(),
+                    (i & 2u) ? max.y() : min.y(),
+                    (i & 4u) ? max.z() : min.z());
+            };
+
+            // each side is given by its corners in counter clockwise order when viewed from outside
+            static const size_t sides[6][4] = {
+                { 0u, 2u, 3u, 1u }, // bottom
+                { 4u, 5u, 7u, 6u }, // top
+                { 0u, 1u, 5u, 4u }, // front
+                { 2u, 6u, 7u, 3u }, // back
+                { 0u, 4u, 6u, 2u }, // left
+                { 1u, 3u, 7u, 5u }, // right
+            };
+
+            static const vm::vec2f texCoords[4] = {
+                vm::vec2f(0.0f, 1.0f),
+                vm::vec2f(1.0f, 1.0f),
+                vm::vec2f(1.0f, 0.0f),
+                vm::vec2f(0.0f, 0.0f),
+            };
+
+            std::vector<EntityModelVertex> result;
+            result.reserve(6u * 6u);
+            for (const auto& side : sides) {
+                // entity models are rendered with clockwise front faces, see MapRenderer
+                for (const size_t i : { 0u, 2u, 1u, 0u, 3u, 2u }) {
+                    result.emplace_back(corner(side[i]), texCoords[i]);
+                }
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/EntityModel_Forward.h"
+
+#include <vecmath/forward.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        enum class PrimType;
+    }
+
+    namespace Assets {
+        /**
+         * The level of detail at which an entity model is rendered.
+         */
+        enum class EntityModelLod {
+            /**
+             * The full model mesh.
+             */
+            Full,
+            /**
+             * A simplified mesh that is computed from the full mesh, see decimateTriangles.
+             */
+            Simplified,
+            /**
+             * A textured box that covers the model's bounds.
+             */
+            Proxy
+        };
+
+        std::ostream& operator<<(std::ostream& str, EntityModelLod lod);
+
+        /**
+         * The minimum size in pixels at which a model is rendered with its full mesh.
+         */
+        static const float FullLodMinProjectedSize = 64.0f;
+
+        /**
+         * The minimum size in pixels at which a model is rendered with its simplified mesh. Smaller models are
+         * rendered as proxies.
+         */
+        static const float SimplifiedLodMinProjectedSize = 16.0f;
+
+        /**
+         * The number of grid cells per axis used to simplify model meshes.
+         */
+        static const size_t SimplifiedMeshResolution = 8u;
+
+        /**
+         * Selects the level of detail for a model given its size on screen.
+         *
+         * @param projectedSize the size of the model's bounds on screen in pixels
+         * @return the level of detail
+         */
+        EntityModelLod selectEntityModelLod(float projectedSize);
+
+        /**
+         * Converts the given primitives into a list of triangles and appends the triangles' vertices to the given
+         * vector. Primitives that don't have an area such as points and lines are ignored.
+         *
+         * @param vertices the vertices of the primitive
+         * @param primType the primitive type
+         * @param index the index of the first vertex of the primitive
+         * @param count the number of vertices of the primitive
+         * @param result the vector to append the triangles to
+         */
+        void appendTriangles(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count, std::vector<EntityModelVertex>& result);
+
+        /**
+         * Simplifies the given list of triangles by vertex clustering.
+         *
+         * The bounds of the given triangles are divided into a grid with the given number of cells per axis, and all
+         * vertices in a cell are moved to the average position of that cell's vertices. The texture coordinates of the
+         * vertices are kept. Triangles which collapse because two of their vertices end up in the same cell are
+         * removed, as are triangles that duplicate another triangle.
+         *
+         * @param triangles the vertices of the triangles to simplify, three consecutive vertices form a triangle
+         * @param cellsPerAxis the number of grid cells per axis
+         * @return the vertices of the simplified triangles
+         */
+        std::vector<EntityModelVertex> decimateTriangles(const std::vector<EntityModelVertex>& triangles, size_t cellsPerAxis);
+
+        /**
+         * Builds the triangles of a box that covers the given bounds. Each side of the box maps the entire texture so
+         * that a proxy shows the average color of the texture once it is minified.
+         *
+         * @param bounds the bounds of the box
+         * @return the vertices of the box triangles
+         */
+        std::vector<EntityModelVertex> buildProxyTriangles(const vm::bbox3f& bounds);
+    }
+}
@@ -28,21 +28,56 @@
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include <QString>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+
 namespace TrenchBroom {
     namespace Assets {
+        namespace {
+            /**
+             * Collects the messages logged while a model is loaded in the background.
+             */
+            class DeferredLogger : public Logger {
+            private:
+                std::vector<std::tuple<LogLevel, std::string>> m_messages;
+            public:
+                std::vector<std::tuple<LogLevel, std::string>> takeMessages() {
+                    return std::move(m_messages);
+                }
+            private:
+                void doLog(const LogLevel level, const std::string& message) override {
+                    m_messages.emplace_back(level, message);
+                }
+
+                void doLog(const LogLevel level, const QString& message) override {
+                    m_messages.emplace_back(level, message.toStdString());
+                }
+            };
+        }
+
         EntityModelManager::EntityModelManager(const int magFilter, const int minFilter, Logger& logger) :
         m_logger(logger),
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_loadModelsInBackground(false) {}
 
         EntityModelManager::~EntityModelManager() {
             clear();
         }
 
         void EntityModelManager::clear() {
+            // destroying the futures waits for the loading threads to finish
+            m_pendingModels.clear();
+            m_queuedModels.clear();
+
             m_renderers.clear();
+            m_lodRenderers.clear();
             m_models.clear();
             m_rendererMismatches.clear();
             m_modelMismatches.clear();
@@ -64,8 +99,69 @@ namespace TrenchBroom {
             m_loader = loader;
         }
 
+        void EntityModelManager::setLoadModelsInBackground(const bool loadModelsInBackground, std::function<void()> modelLoadedCallback) {
+            m_loadModelsInBackground = loadModelsInBackground;
+            m_modelLoadedCallback = std::move(modelLoadedCallback);
+
+            if (!m_loadModelsInBackground) {
+                // running loads hold a copy of the previous callback, so wait until they have invoked it
+                for (const auto& entry : m_pendingModels) {
+                    entry.second.task.wait();
+                }
+            }
+        }
+
+        std::vector<IO::Path> EntityModelManager::finishLoadingModels() {
+            auto result = std::vector<IO::Path>{};
+
+            auto it = std::begin(m_pendingModels);
+            while (it != std::end(m_pendingModels)) {
+                if (it->second.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    ++it;
+                    continue;
+                }
+
+                const auto path = it->first;
+                auto pendingModel = std::move(it->second);
+                it = m_pendingModels.erase(it);
+
+                auto loadedModel = pendingModel.result.get();
+                for (const auto& [level, message] : loadedModel.messages) {
+                    m_logger.log(level, message);
+                }
+
+                if (loadedModel.model != nullptr) {
+                    auto* model = loadedModel.model.get();
+                    m_models.emplace(path, std::move(loadedModel.model));
+                    m_unpreparedModels.push_back(model);
+                    m_logger.debug() << "Loaded entity model " << path;
+                } else {
+                    m_modelMismatches.insert(path);
+                }
+
+                result.push_back(path);
+            }
+
+            startLoadingModels();
+            return result;
+        }
+
+        bool EntityModelManager::hasPendingModels() const {
+            return !m_pendingModels.empty() || !m_queuedModels.empty();
+        }
+
+        bool EntityModelManager::isLoadingModel(const IO::Path& path) const {
+            return m_pendingModels.count(path) > 0 || m_queuedModels.count(path) > 0;
+        }
+
+        void EntityModelManager::waitForPendingModels() const {
+            for (const auto& entry : m_pendingModels) {
+                entry.second.result.wait();
+            }
+        }
+
         Renderer::TexturedRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
-            auto* entityModel = safeGetModel(spec.path);
+            auto* entityModel = safeGetModel(spec);
 
             if (entityModel == nullptr) {
                 return nullptr;
@@ -96,8 +192,35 @@ namespace TrenchBroom {
             }
         }
 
+        Renderer::TexturedRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec, const EntityModelLod lod) const {
+            if (lod == EntityModelLod::Full) {
+                return renderer(spec);
+            }
+
+            auto* entityModel = safeGetModel(spec);
+            if (entityModel == nullptr) {
+                return nullptr;
+            }
+
+            const auto key = std::make_tuple(spec, lod);
+            auto it = m_lodRenderers.find(key);
+            if (it != std::end(m_lodRenderers)) {
+                return it->second.get();
+            }
+
+            auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex, lod);
+            auto* result = renderer.get();
+            m_lodRenderers.emplace(key, std::move(renderer));
+
+            if (result != nullptr) {
+                m_unpreparedRenderers.push_back(result);
+                m_logger.debug() << "Constructed entity model renderer for " << spec << " at level of detail " << lod;
+            }
+            return result;
+        }
+
         const EntityModelFrame* EntityModelManager::frame(const Assets::ModelSpecification& spec) const {
-            auto* model = this->safeGetModel(spec.path);
+            auto* model = this->safeGetModel(spec);
             if (model == nullptr) {
                 return nullptr;
             } else if (spec.frameIndex >= model->frameCount()) {
@@ -110,7 +233,8 @@ namespace TrenchBroom {
             }
         }
 
-        EntityModel* EntityModelManager::model(const IO::Path& path) const {
+        EntityModel* EntityModelManager::model(const Assets::ModelSpecification& spec) const {
+            const auto& path = spec.path;
             if (path.isEmpty()) {
                 return nullptr;
             }
@@ -124,6 +248,11 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
+            if (m_loadModelsInBackground) {
+                queueModel(spec);
+                return nullptr;
+            }
+
             try {
                 const auto [pos, success] = m_models.insert({ path, loadModel(path) });
                 assert(success); unused(success);
@@ -141,9 +270,9 @@ namespace TrenchBroom {
             }
         }
 
-        EntityModel* EntityModelManager::safeGetModel(const IO::Path& path) const {
+        EntityModel* EntityModelManager::safeGetModel(const Assets::ModelSpecification& spec) const {
             try {
-                return model(path);
+                return model(spec);
             } catch (const GameException&) {
                 return nullptr;
             }
@@ -164,6 +293,66 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelManager::queueModel(const Assets::ModelSpecification& spec) const {
+            if (m_pendingModels.count(spec.path) == 0) {
+                // the first request determines which frame is loaded along with the model
+                m_queuedModels.emplace(spec.path, spec);
+                startLoadingModels();
+            }
+        }
+
+        EntityModelManager::LoadedModel EntityModelManager::loadModelInBackground(const IO::EntityModelLoader& loader, const Assets::ModelSpecification& spec) {
+            auto logger = DeferredLogger{};
+            auto result = LoadedModel{};
+
+            try {
+                auto model = loader.initializeModel(spec.path, logger);
+                if (spec.frameIndex < model->frameCount()) {
+                    try {
+                        loader.loadFrame(spec.path, spec.frameIndex, *model, logger);
+                        // simplifying a mesh is expensive, so it is done here rather than when the model is rendered
+                        model->simplifyFrame(spec.frameIndex);
+                    } catch (const Exception& e) {
+                        // FIXME: be specific about which exceptions to catch here
+                        logger.error() << "Could not load entity model frame " << spec << ": " << e.what();
+                    }
+                }
+                result.model = std::move(model);
+            } catch (const GameException& e) {
+                logger.error() << e.what();
+            }
+
+            result.messages = logger.takeMessages();
+            return result;
+        }
+
+        void EntityModelManager::startLoadingModels() const {
+            const auto maxPendingModels = std::max(std::thread::hardware_concurrency(), 1u);
+            while (!m_queuedModels.empty() && m_pendingModels.size() < maxPendingModels) {
+                ensure(m_loader != nullptr, "loader is null");
+
+                const auto [path, spec] = *std::begin(m_queuedModels);
+                m_queuedModels.erase(std::begin(m_queuedModels));
+
+                // the callback must only be invoked once the result is available, so the result cannot be the future
+                // returned by std::async
+                auto promise = std::promise<LoadedModel>{};
+                auto result = promise.get_future();
+                auto task = std::async(std::launch::async, [loader = m_loader, spec = spec, promise = std::move(promise), callback = m_modelLoadedCallback]() mutable {
+                    try {
+                        promise.set_value(loadModelInBackground(*loader, spec));
+                    } catch (...) {
+                        promise.set_exception(std::current_exception());
+                    }
+                    if (callback) {
+                        callback();
+                    }
+                });
+
+                m_pendingModels.emplace(path, PendingModel{std::move(result), std::move(task)});
+            }
+        }
+
         void EntityModelManager::prepare(Renderer::VboManager& vboManager) {
             resetTextureMode();
             prepareModels();
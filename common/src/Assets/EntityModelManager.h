@@ -19,16 +19,22 @@
 
 #pragma once
 
+#include "Assets/EntityModelLod.h"
 #include "IO/Path.h"
 
 #include <kdl/vector_set.h>
 
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
+    enum class LogLevel;
 
     namespace IO {
         class EntityModelLoader;
@@ -58,6 +64,26 @@ namespace TrenchBroom {
             using RendererMismatches = kdl::vector_set<ModelSpecification>;
             using RendererList = std::vector<Renderer::TexturedRenderer*>;
 
+            // null renderers are cached, too, since a level of detail may be unavailable for a model
+            using LodRendererCache = std::map<std::tuple<ModelSpecification, EntityModelLod>, std::unique_ptr<Renderer::TexturedRenderer>>;
+
+            /**
+             * The result of loading a model in the background. Messages are logged when the model is taken over on the
+             * main thread because loggers are not thread safe. The model is null if it could not be loaded.
+             */
+            struct LoadedModel {
+                std::unique_ptr<EntityModel> model;
+                std::vector<std::tuple<LogLevel, std::string>> messages;
+            };
+
+            struct PendingModel {
+                std::future<LoadedModel> result;
+                std::future<void> task;
+            };
+
+            using PendingModels = std::map<IO::Path, PendingModel>;
+            using QueuedModels = std::map<IO::Path, ModelSpecification>;
+
             Logger& m_logger;
             const IO::EntityModelLoader* m_loader;
 
@@ -65,13 +91,22 @@ namespace TrenchBroom {
             int m_magFilter;
             bool m_resetTextureMode;
 
+            bool m_loadModelsInBackground;
+            std::function<void()> m_modelLoadedCallback;
+
             mutable ModelCache m_models;
             mutable ModelMismatches m_modelMismatches;
             mutable RendererCache m_renderers;
             mutable RendererMismatches m_rendererMismatches;
+            mutable LodRendererCache m_lodRenderers;
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+
+            // models which are being loaded in the background and models which are waiting to be loaded, the latter
+            // mapped to the specification that determines which frame is loaded along with the model
+            mutable PendingModels m_pendingModels;
+            mutable QueuedModels m_queuedModels;
         public:
             EntityModelManager(int magFilter, int minFilter, Logger& logger);
             ~EntityModelManager();
@@ -80,14 +115,64 @@ namespace TrenchBroom {
 
             void setTextureMode(int minFilter, int magFilter);
             void setLoader(const IO::EntityModelLoader* loader);
+
+            /**
+             * Controls whether models are loaded on background threads. If enabled, a model that is requested for the
+             * first time is loaded in the background and no model, frame or renderer is available for it until
+             * finishLoadingModels has taken it over.
+             *
+             * @param loadModelsInBackground whether to load models in the background
+             * @param modelLoadedCallback called on the loading thread whenever a model has been loaded; it should arrange
+             * for finishLoadingModels to be called on the main thread
+             *
+             * Disabling background loading waits until every running load has invoked its callback, so that the
+             * callback's captures can be destroyed afterwards.
+             */
+            void setLoadModelsInBackground(bool loadModelsInBackground, std::function<void()> modelLoadedCallback = {});
+
+            /**
+             * Takes over the models that have been loaded in the background and starts loading queued models.
+             *
+             * @return the paths of the models that have finished loading, including those that failed to load
+             */
+            std::vector<IO::Path> finishLoadingModels();
+
+            /**
+             * Indicates whether any models are being loaded or waiting to be loaded in the background.
+             */
+            bool hasPendingModels() const;
+
+            /**
+             * Indicates whether the model with the given path is being loaded or waiting to be loaded in the background.
+             */
+            bool isLoadingModel(const IO::Path& path) const;
+
+            /**
+             * Blocks until the models that are currently being loaded in the background have been loaded. Call this
+             * before modifying the file system that the loader reads from.
+             */
+            void waitForPendingModels() const;
+
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
+            /**
+             * Returns a renderer for the given model at the given level of detail.
+             *
+             * @param spec the model specification
+             * @param lod the level of detail
+             * @return the renderer or null if the model or the requested level of detail is not available
+             */
+            Renderer::TexturedRenderer* renderer(const ModelSpecification& spec, EntityModelLod lod) const;
+
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
         private:
-            EntityModel* model(const IO::Path& path) const;
-            EntityModel* safeGetModel(const IO::Path& path) const;
+            EntityModel* model(const ModelSpecification& spec) const;
+            EntityModel* safeGetModel(const ModelSpecification& spec) const;
             std::unique_ptr<EntityModel> loadModel(const IO::Path& path) const;
             void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+            void queueModel(const ModelSpecification& spec) const;
+            void startLoadingModels() const;
+            static LoadedModel loadModelInBackground(const IO::EntityModelLoader& loader, const ModelSpecification& spec);
         public:
             void prepare(Renderer::VboManager& vboManager);
         private:
@@ -29,6 +29,7 @@
 
 #include <kdl/string_format.h>
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 
@@ -137,36 +138,54 @@ namespace TrenchBroom {
             const unsigned char* indexedImage = reinterpret_cast<const unsigned char*>(reader.begin() + reader.position());
             reader.seekForward(pixelCount); // throws ReaderException if there aren't pixelCount bytes available
 
-            // Write rgba pixels
+            // Write rgba pixels and count how often each palette index occurs. The average color and the transparency
+            // are then computed from the 256 palette entries rather than from every pixel. Alternating between four
+            // histograms avoids stalling on consecutive increments of the same counter, which are common in textures.
+            uint32_t histograms[4][256] = {};
             unsigned char* const rgbaData = rgbaImage.data();
-            for (size_t i = 0; i < pixelCount; ++i) {
-                const int index = static_cast<int>(indexedImage[i]);
 
+            size_t i = 0;
+            for (; i + 4 <= pixelCount; i += 4) {
+                const auto index0 = static_cast<size_t>(indexedImage[i + 0]);
+                const auto index1 = static_cast<size_t>(indexedImage[i + 1]);
+                const auto index2 = static_cast<size_t>(indexedImage[i + 2]);
+                const auto index3 = static_cast<size_t>(indexedImage[i + 3]);
+
+                std::memcpy(rgbaData + ((i + 0) * 4), &paletteData[index0 * 4], 4);
+                std::memcpy(rgbaData + ((i + 1) * 4), &paletteData[index1 * 4], 4);
+                std::memcpy(rgbaData + ((i + 2) * 4), &paletteData[index2 * 4], 4);
+                std::memcpy(rgbaData + ((i + 3) * 4), &paletteData[index3 * 4], 4);
+
+                ++histograms[0][index0];
+                ++histograms[1][index1];
+                ++histograms[2][index2];
+                ++histograms[3][index3];
+            }
+            for (; i < pixelCount; ++i) {
+                const auto index = static_cast<size_t>(indexedImage[i]);
                 std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+                ++histograms[0][index];
             }
 
-            // Check average color
-            uint32_t colorSum[3] = {0, 0, 0};
-            for (size_t i = 0; i < pixelCount; ++i) {
-                colorSum[0] += static_cast<uint32_t>(rgbaData[(i * 4) + 0]);
-                colorSum[1] += static_cast<uint32_t>(rgbaData[(i * 4) + 1]);
-                colorSum[2] += static_cast<uint32_t>(rgbaData[(i * 4) + 2]);
+            // Compute average color
+            uint64_t colorSum[3] = {0, 0, 0};
+            uint64_t transparentCount = 0;
+            for (size_t index = 0; index < 256; ++index) {
+                const auto count = static_cast<uint64_t>(histograms[0][index]) + histograms[1][index] + histograms[2][index] + histograms[3][index];
+                colorSum[0] += count * paletteData[(index * 4) + 0];
+                colorSum[1] += count * paletteData[(index * 4) + 1];
+                colorSum[2] += count * paletteData[(index * 4) + 2];
+                if (paletteData[(index * 4) + 3] != 0xff) {
+                    transparentCount += count;
+                }
             }
             averageColor = Color(static_cast<float>(colorSum[0]) / (255.0f * static_cast<float>(pixelCount)),
                                  static_cast<float>(colorSum[1]) / (255.0f * static_cast<float>(pixelCount)),
                                  static_cast<float>(colorSum[2]) / (255.0f * static_cast<float>(pixelCount)),
                                  1.0f);
 
-            // Check for transparency
-            bool hasTransparency = false;
-            if (transparency == PaletteTransparency::Index255Transparent) {
-                // Take the bitwise AND of the alpha channel of all pixels
-                unsigned char andAlpha = 0xff;
-                for (size_t i = 0; i < pixelCount; ++i) {
-                    andAlpha &= rgbaData[(i * 4) + 3];
-                }
-                hasTransparency = (andAlpha != 0xff);
-            }
+            // Check for transparency; only the transparent palette has entries with an alpha value other than 0xff
+            const bool hasTransparency = transparentCount > 0;
 
             return hasTransparency;
         }
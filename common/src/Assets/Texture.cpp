@@ -38,7 +38,12 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {
+        m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_arrayTextureId(0),
+        m_arrayLayer(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * bytesPerPixelForFormat(format));
@@ -57,7 +62,12 @@ namespace TrenchBroom {
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId(0),
-        m_buffers(std::move(buffers)) {
+        m_buffers(std::move(buffers)),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_arrayTextureId(0),
+        m_arrayLayer(0) {
             assert(m_width > 0);
             assert(m_height > 0);
 
@@ -81,7 +91,12 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {}
+        m_textureId(0),
+        m_pendingTextureId(0),
+        m_minFilter(0),
+        m_magFilter(0),
+        m_arrayTextureId(0),
+        m_arrayLayer(0) {}
 
         Texture::~Texture() = default;
 
@@ -149,6 +164,10 @@ namespace TrenchBroom {
             m_culling = culling;
         }
 
+        const TextureBlendFunc& Texture::blendFunc() const {
+            return m_blendFunc;
+        }
+
         void Texture::setBlendFunc(GLenum srcFactor, GLenum destFactor) {
             m_blendFunc.enable = TextureBlendFunc::Enable::UseFactors;
             m_blendFunc.srcFactor = srcFactor;
@@ -164,6 +183,10 @@ namespace TrenchBroom {
         }
 
         void Texture::incUsageCount() {
+            if (m_usageCount == 0u) {
+                // decode the pixels now so that the average color is known when the face is rendered
+                loadPixels();
+            }
             ++m_usageCount;
         }
 
@@ -180,6 +203,14 @@ namespace TrenchBroom {
             m_overridden = overridden;
         }
 
+        void Texture::setPixelLoader(PixelLoader pixelLoader) {
+            m_pixelLoader = std::move(pixelLoader);
+        }
+
+        bool Texture::pixelsPending() const {
+            return m_pixelLoader != nullptr;
+        }
+
         bool Texture::isPrepared() const {
             return m_textureId != 0;
         }
@@ -188,52 +219,22 @@ namespace TrenchBroom {
             assert(textureId > 0);
             assert(m_textureId == 0);
 
-            if (!m_buffers.empty()) {
-                glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-                glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-                glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
-
-                glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
-
-                if (m_type == TextureType::Masked) {
-                    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-                } else if (m_buffers.size() == 1) {
-                    // generate mipmaps if we don't have any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
-                } else {
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
-                }
-
-                // Upload only the first mipmap for masked textures.
-                const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
-
-                for (size_t j = 0; j < mipmapsToUpload; ++j) {
-                    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
-
-                    const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
-                    glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
-                                          static_cast<GLsizei>(mipSize.x()),
-                                          static_cast<GLsizei>(mipSize.y()),
-                                          0, m_format, GL_UNSIGNED_BYTE, data));
-                }
-
-                m_buffers.clear();
-                m_textureId = textureId;
+            if (pixelsPending() || packed()) {
+                // the pixels are uploaded when this texture is first activated. Packed textures are rendered from their
+                // texture array, so only the texture browser and the UV editor activate them.
+                m_pendingTextureId = textureId;
+                m_minFilter = minFilter;
+                m_magFilter = magFilter;
+            } else {
+                upload(textureId, minFilter, magFilter);
             }
         }
 
         void Texture::setMode(const int minFilter, const int magFilter) {
-            if (isPrepared()) {
+            if (m_pendingTextureId != 0) {
+                m_minFilter = minFilter;
+                m_magFilter = magFilter;
+            } else if (isPrepared()) {
                 activate();
                 if (m_type == TextureType::Masked) {
                     // Force GL_NEAREST filtering for masked textures.
@@ -248,6 +249,12 @@ namespace TrenchBroom {
         }
 
         void Texture::activate() const {
+            if (m_pendingTextureId != 0) {
+                loadPixels();
+                upload(m_pendingTextureId, m_minFilter, m_magFilter);
+                m_pendingTextureId = 0;
+            }
+
             if (isPrepared()) {
                 glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
 
@@ -279,6 +286,73 @@ namespace TrenchBroom {
             }
         }
 
+        void Texture::loadPixels() const {
+            if (!pixelsPending()) {
+                return;
+            }
+
+            auto pixelLoader = std::move(m_pixelLoader);
+            m_pixelLoader = nullptr;
+
+            try {
+                auto texture = pixelLoader();
+                if (texture.m_width == m_width && texture.m_height == m_height) {
+                    m_averageColor = texture.m_averageColor;
+                    m_format = texture.m_format;
+                    m_type = texture.m_type;
+                    m_buffers = std::move(texture.m_buffers);
+                }
+                // otherwise, the texture could not be read and remains without pixels
+            } catch (const std::exception&) {
+                // the texture remains without pixels
+            }
+        }
+
+        void Texture::upload(const GLuint textureId, const int minFilter, const int magFilter) const {
+            if (!m_buffers.empty()) {
+                glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+                glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+                glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+                glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+                glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+                glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+                if (m_type == TextureType::Masked) {
+                    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+                } else if (m_buffers.size() == 1) {
+                    // generate mipmaps if we don't have any
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+                } else {
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+                }
+
+                // Upload only the first mipmap for masked textures.
+                const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+
+                for (size_t j = 0; j < mipmapsToUpload; ++j) {
+                    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+
+                    const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+                    glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
+                                          static_cast<GLsizei>(mipSize.x()),
+                                          static_cast<GLsizei>(mipSize.y()),
+                                          0, m_format, GL_UNSIGNED_BYTE, data));
+                }
+
+                m_buffers.clear();
+                m_textureId = textureId;
+            }
+        }
+
         void Texture::deactivate() const {
             if (isPrepared()) {
                 if (m_blendFunc.enable != TextureBlendFunc::Enable::UseDefault) {
@@ -304,6 +378,23 @@ namespace TrenchBroom {
             }
         }
 
+        bool Texture::packed() const {
+            return m_arrayTextureId != 0;
+        }
+
+        GLuint Texture::arrayTextureId() const {
+            return m_arrayTextureId;
+        }
+
+        size_t Texture::arrayLayer() const {
+            return m_arrayLayer;
+        }
+
+        void Texture::setArrayLayer(const GLuint arrayTextureId, const size_t layer) {
+            m_arrayTextureId = arrayTextureId;
+            m_arrayLayer = layer;
+        }
+
         const Texture::BufferList& Texture::buffersIfUnprepared() const {
             return m_buffers;
         }
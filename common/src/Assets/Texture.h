@@ -26,6 +26,7 @@
 
 #include <vecmath/forward.h>
 
+#include <functional>
 #include <set>
 #include <string>
 #include <vector>
@@ -72,6 +73,12 @@ namespace TrenchBroom {
         };
 
         class Texture {
+        public:
+            /**
+             * Reads the pixels of a texture that is loaded on demand. Returns a texture of the same size as the
+             * texture that is loaded on demand.
+             */
+            using PixelLoader = std::function<Texture()>;
         private:
             using Buffer = TextureBuffer;
             using BufferList = std::vector<Buffer>;
@@ -82,13 +89,16 @@ namespace TrenchBroom {
 
             size_t m_width;
             size_t m_height;
-            Color m_averageColor;
+
+            // the following members are mutable because a texture that is loaded on demand reads its pixels when it
+            // is first activated
+            mutable Color m_averageColor;
 
             size_t m_usageCount;
             bool m_overridden;
 
-            GLenum m_format;
-            TextureType m_type;
+            mutable GLenum m_format;
+            mutable TextureType m_type;
 
             // Quake 3 surface parameters; move these to materials when we add proper support for those.
             std::set<std::string> m_surfaceParms;
@@ -101,6 +111,18 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
+
+            // set for a texture that is loaded on demand until its pixels are read
+            mutable PixelLoader m_pixelLoader;
+
+            // the texture id and filters for a texture that was prepared before its pixels were read
+            mutable GLuint m_pendingTextureId;
+            int m_minFilter;
+            int m_magFilter;
+
+            // the texture array which contains a copy of this texture, see TextureCollection::prepare
+            GLuint m_arrayTextureId;
+            size_t m_arrayLayer;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, BufferList&& buffers, GLenum format, TextureType type);
@@ -147,6 +169,7 @@ namespace TrenchBroom {
             TextureCulling culling() const;
             void setCulling(TextureCulling culling);
 
+            const TextureBlendFunc& blendFunc() const;
             void setBlendFunc(GLenum srcFactor, GLenum destFactor);
             void disableBlend();
 
@@ -156,16 +179,43 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(bool overridden);
 
+            /**
+             * Makes this a texture that is loaded on demand. Its pixels are read using the given loader when it is
+             * first used by a face or first activated, whichever comes first. Until then, the texture has no pixels
+             * and its average color is black.
+             */
+            void setPixelLoader(PixelLoader pixelLoader);
+
+            /**
+             * Indicates whether this texture is loaded on demand and its pixels have not been read yet.
+             */
+            bool pixelsPending() const;
+
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
             void activate() const;
             void deactivate() const;
+        private:
+            void loadPixels() const;
+            void upload(GLuint textureId, int minFilter, int magFilter) const;
+        public:
+
+            /**
+             * Indicates whether a copy of this texture is stored in a layer of a texture array.
+             *
+             * A packed texture keeps its pixels in memory and is only uploaded to its own OpenGL texture when it is
+             * first activated. The layer must therefore be set before the texture is prepared.
+             */
+            bool packed() const;
+            GLuint arrayTextureId() const;
+            size_t arrayLayer() const;
+            void setArrayLayer(GLuint arrayTextureId, size_t layer);
         public: // exposed for tests only
             /**
              * Returns the texture data in the format returned by format().
-             * Once prepare() is called, this will be an empty vector.
+             * Once the texture is uploaded, this will be an empty vector.
              */
             const BufferList& buffersIfUnprepared() const;
             /**
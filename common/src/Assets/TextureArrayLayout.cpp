@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureArrayLayout.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <tuple>
+
+namespace TrenchBroom {
+    namespace Assets {
+        bool TextureArrayLayout::Slot::operator==(const Slot& other) const {
+            return array == other.array && layer == other.layer;
+        }
+
+        TextureArrayLayout::TextureArrayLayout() = default;
+
+        TextureArrayLayout::TextureArrayLayout(const std::vector<Entry>& entries, const size_t maxLayers, const size_t minLayers) :
+        m_slots(entries.size()) {
+            assert(maxLayers > 0u);
+            assert(minLayers <= maxLayers);
+
+            // group the textures by their properties, keeping the groups in the order of their first texture
+            using Key = std::tuple<size_t, size_t, GLenum, size_t>;
+            std::map<Key, size_t> groupIndices;
+            std::vector<std::vector<size_t>> groups;
+
+            for (size_t i = 0; i < entries.size(); ++i) {
+                const auto& entry = entries[i];
+                if (!entry.packable) {
+                    continue;
+                }
+
+                const auto key = Key(entry.width, entry.height, entry.format, entry.mipLevels);
+                const auto [it, inserted] = groupIndices.emplace(key, groups.size());
+                if (inserted) {
+                    groups.emplace_back();
+                }
+                groups[it->second].push_back(i);
+            }
+
+            for (const auto& group : groups) {
+                for (size_t first = 0; first < group.size(); first += maxLayers) {
+                    const size_t count = std::min(maxLayers, group.size() - first);
+                    if (count < std::max(minLayers, size_t(1))) {
+                        break;
+                    }
+
+                    const auto& entry = entries[group[first]];
+                    const size_t arrayIndex = m_arrays.size();
+                    m_arrays.push_back(Array{entry.width, entry.height, entry.format, entry.mipLevels, {}});
+
+                    auto& textures = m_arrays.back().textures;
+                    for (size_t layer = 0; layer < count; ++layer) {
+                        const size_t textureIndex = group[first + layer];
+                        textures.push_back(textureIndex);
+                        m_slots[textureIndex] = Slot{arrayIndex, layer};
+                    }
+                }
+            }
+
+            std::stable_sort(std::begin(m_arrays), std::end(m_arrays), [](const Array& lhs, const Array& rhs) {
+                return lhs.textures.front() < rhs.textures.front();
+            });
+
+            // update the slots after sorting
+            for (size_t i = 0; i < m_arrays.size(); ++i) {
+                for (const size_t textureIndex : m_arrays[i].textures) {
+                    m_slots[textureIndex]->array = i;
+                }
+            }
+        }
+
+        const std::vector<TextureArrayLayout::Array>& TextureArrayLayout::arrays() const {
+            return m_arrays;
+        }
+
+        std::optional<TextureArrayLayout::Slot> TextureArrayLayout::slot(const size_t textureIndex) const {
+            if (textureIndex >= m_slots.size()) {
+                return std::nullopt;
+            }
+            return m_slots[textureIndex];
+        }
+
+        size_t TextureArrayLayout::packedTextureCount() const {
+            size_t result = 0;
+            for (const auto& array : m_arrays) {
+                result += array.textures.size();
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include <cstddef> // for size_t
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * Describes how a list of textures is packed into texture arrays. Textures can only share an array if they
+         * have the same size, format and number of mip levels. Does not call any OpenGL functions.
+         */
+        class TextureArrayLayout {
+        public:
+            struct Entry {
+                size_t width;
+                size_t height;
+                GLenum format;
+                size_t mipLevels;
+                /**
+                 * Whether the texture may be packed at all.
+                 */
+                bool packable;
+            };
+
+            struct Array {
+                size_t width;
+                size_t height;
+                GLenum format;
+                size_t mipLevels;
+                /**
+                 * The indices of the textures in this array, one per layer.
+                 */
+                std::vector<size_t> textures;
+            };
+
+            struct Slot {
+                size_t array;
+                size_t layer;
+
+                bool operator==(const Slot& other) const;
+            };
+        private:
+            std::vector<Array> m_arrays;
+            std::vector<std::optional<Slot>> m_slots;
+        public:
+            TextureArrayLayout();
+
+            /**
+             * Packs the given textures into arrays of at most `maxLayers` layers. Arrays with fewer than `minLayers`
+             * layers are not created since they would not save any texture binds; the affected textures remain
+             * unpacked.
+             *
+             * The arrays are ordered by the index of their first texture.
+             */
+            TextureArrayLayout(const std::vector<Entry>& entries, size_t maxLayers, size_t minLayers = 2u);
+
+            const std::vector<Array>& arrays() const;
+
+            /**
+             * Returns the array and layer of the texture with the given index, or nothing if the texture is not packed.
+             */
+            std::optional<Slot> slot(size_t textureIndex) const;
+            size_t packedTextureCount() const;
+        };
+    }
+}
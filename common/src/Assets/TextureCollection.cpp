@@ -20,6 +20,7 @@
 #include "TextureCollection.h"
 
 #include "Ensure.h"
+#include "Assets/TextureBuffer.h"
 
 #include <kdl/vector_utils.h>
 
@@ -50,6 +51,11 @@ namespace TrenchBroom {
                                           static_cast<GLuint*>(&m_textureIds.front())));
                 m_textureIds.clear();
             }
+            if (!m_arrayTextureIds.empty()) {
+                glAssert(glDeleteTextures(static_cast<GLsizei>(m_arrayTextureIds.size()),
+                                          static_cast<GLuint*>(&m_arrayTextureIds.front())));
+                m_arrayTextureIds.clear();
+            }
         }
 
         bool TextureCollection::loaded() const {
@@ -107,9 +113,15 @@ namespace TrenchBroom {
             return !m_textureIds.empty();
         }
 
-        void TextureCollection::prepare(const int minFilter, const int magFilter) {
+        void TextureCollection::prepare(const int minFilter, const int magFilter, const bool packTextures) {
             assert(!prepared());
 
+            // the texture arrays must be filled before the textures are prepared because that discards the buffers of
+            // the textures that are not packed
+            if (packTextures && GLEW_EXT_texture_array) {
+                prepareTextureArrays(minFilter, magFilter);
+            }
+
             m_textureIds.resize(textureCount());
             if (textureCount() != 0u) {
                 glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
@@ -126,6 +138,105 @@ namespace TrenchBroom {
             for (auto& texture : m_textures) {
                 texture.setMode(minFilter, magFilter);
             }
+
+            for (const auto arrayTextureId : m_arrayTextureIds) {
+                glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, arrayTextureId));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_MIN_FILTER, minFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_MAG_FILTER, magFilter));
+            }
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, 0));
+        }
+
+        const TextureArrayLayout& TextureCollection::arrayLayout() const {
+            return m_arrayLayout;
+        }
+
+        /**
+         * Only small textures are packed: large textures are rare and would waste a lot of memory when they are
+         * stored twice.
+         */
+        static const size_t MaxPackedTextureSize = 256;
+
+        static bool packable(const Texture& texture) {
+            return texture.type() == TextureType::Opaque
+                && texture.culling() == TextureCulling::CullDefault
+                && texture.blendFunc().enable == TextureBlendFunc::Enable::UseDefault
+                // texture arrays cannot generate mipmaps in OpenGL 2.1, and textures that are loaded on demand have
+                // no pixels until they are first used
+                && texture.buffersIfUnprepared().size() > 1
+                && texture.width() <= MaxPackedTextureSize
+                && texture.height() <= MaxPackedTextureSize;
+        }
+
+        void TextureCollection::prepareTextureArrays(const int minFilter, const int magFilter) {
+            auto entries = std::vector<TextureArrayLayout::Entry>();
+            entries.reserve(m_textures.size());
+            for (const auto& texture : m_textures) {
+                entries.push_back({
+                    texture.width(),
+                    texture.height(),
+                    texture.format(),
+                    texture.buffersIfUnprepared().size(),
+                    packable(texture)
+                });
+            }
+
+            GLint maxLayers = 0;
+            glAssert(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS_EXT, &maxLayers));
+            if (maxLayers < 2) {
+                return;
+            }
+
+            m_arrayLayout = TextureArrayLayout(entries, static_cast<size_t>(maxLayers));
+
+            const auto& arrays = m_arrayLayout.arrays();
+            if (arrays.empty()) {
+                return;
+            }
+
+            m_arrayTextureIds.resize(arrays.size());
+            glAssert(glGenTextures(static_cast<GLsizei>(m_arrayTextureIds.size()),
+                                   static_cast<GLuint*>(&m_arrayTextureIds.front())));
+
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            for (size_t i = 0; i < arrays.size(); ++i) {
+                const auto& array = arrays[i];
+                const auto arrayTextureId = m_arrayTextureIds[i];
+                const auto layerCount = static_cast<GLsizei>(array.textures.size());
+
+                glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, arrayTextureId));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_MIN_FILTER, minFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_MAG_FILTER, magFilter));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_WRAP_S, GL_REPEAT));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_WRAP_T, GL_REPEAT));
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY_EXT, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(array.mipLevels - 1)));
+
+                for (size_t level = 0; level < array.mipLevels; ++level) {
+                    const auto mipSize = sizeAtMipLevel(array.width, array.height, level);
+                    const auto mipWidth = static_cast<GLsizei>(mipSize.x());
+                    const auto mipHeight = static_cast<GLsizei>(mipSize.y());
+
+                    glAssert(glTexImage3D(GL_TEXTURE_2D_ARRAY_EXT, static_cast<GLint>(level), GL_RGBA,
+                                          mipWidth, mipHeight, layerCount,
+                                          0, array.format, GL_UNSIGNED_BYTE, nullptr));
+
+                    for (size_t layer = 0; layer < array.textures.size(); ++layer) {
+                        const auto& texture = m_textures[array.textures[layer]];
+                        const GLvoid* data = reinterpret_cast<const GLvoid*>(texture.buffersIfUnprepared()[level].data());
+                        glAssert(glTexSubImage3D(GL_TEXTURE_2D_ARRAY_EXT, static_cast<GLint>(level),
+                                                 0, 0, static_cast<GLint>(layer),
+                                                 mipWidth, mipHeight, 1,
+                                                 array.format, GL_UNSIGNED_BYTE, data));
+                    }
+                }
+
+                for (size_t layer = 0; layer < array.textures.size(); ++layer) {
+                    m_textures[array.textures[layer]].setArrayLayer(arrayTextureId, layer);
+                }
+            }
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, 0));
         }
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Assets/Texture.h"
+#include "Assets/TextureArrayLayout.h"
 #include "IO/Path.h"
 #include "Renderer/GL.h"
 
@@ -38,6 +39,9 @@ namespace TrenchBroom {
 
             TextureIdList m_textureIds;
 
+            TextureArrayLayout m_arrayLayout;
+            TextureIdList m_arrayTextureIds;
+
             friend class Texture;
         public:
             TextureCollection();
@@ -68,8 +72,24 @@ namespace TrenchBroom {
             Texture* textureByName(const std::string& name);
 
             bool prepared() const;
-            void prepare(int minFilter, int magFilter);
+
+            /**
+             * Uploads the textures to OpenGL.
+             *
+             * If `packTextures` is true and texture arrays are supported, small opaque textures of the same size are
+             * copied into texture arrays so that they can be rendered without switching textures. The individual
+             * textures of packed textures are only uploaded when they are activated, e.g. by the texture browser,
+             * since not every renderer can sample from texture arrays.
+             *
+             * A texture that is loaded on demand is only packed if its pixels have been read when the collection is
+             * prepared, i.e., if a face used it when the collection was loaded.
+             */
+            void prepare(int minFilter, int magFilter, bool packTextures = false);
             void setTextureMode(int minFilter, int magFilter);
+
+            const TextureArrayLayout& arrayLayout() const;
+        private:
+            void prepareTextureArrays(int minFilter, int magFilter);
         };
     }
 }
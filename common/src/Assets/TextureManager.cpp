@@ -60,7 +60,9 @@ namespace TrenchBroom {
         m_logger(logger),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_packTextures(false),
+        m_loadTexturesOnDemand(false) {}
 
         TextureManager::~TextureManager() = default;
 
@@ -73,7 +75,7 @@ namespace TrenchBroom {
                 if (it == std::end(collections) || !it->loaded()) {
                     try {
                         const auto startTime = std::chrono::high_resolution_clock::now();
-                        auto collection = loader.loadTextureCollection(path);
+                        auto collection = loader.loadTextureCollection(path, m_loadTexturesOnDemand);
                         const auto endTime = std::chrono::high_resolution_clock::now();
 
                         m_logger.info() << "Loaded texture collection '" << path << "' in "
@@ -131,6 +133,22 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
+        void TextureManager::setPackTextures(const bool packTextures) {
+            m_packTextures = packTextures;
+        }
+
+        void TextureManager::setLoadTexturesOnDemand(const bool loadTexturesOnDemand) {
+            m_loadTexturesOnDemand = loadTexturesOnDemand;
+        }
+
+        const std::shared_ptr<const IO::TextureCache>& TextureManager::textureCache() const {
+            return m_textureCache;
+        }
+
+        void TextureManager::setTextureCache(std::shared_ptr<const IO::TextureCache> textureCache) {
+            m_textureCache = std::move(textureCache);
+        }
+
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
@@ -170,7 +188,7 @@ namespace TrenchBroom {
         void TextureManager::prepare() {
             for (const size_t index : m_toPrepare) {
                 auto& collection = m_collections[index];
-                collection.prepare(m_minFilter, m_magFilter);
+                collection.prepare(m_minFilter, m_magFilter, m_packTextures);
             }
             m_toPrepare.clear();
         }
@@ -22,6 +22,7 @@
 #include "Assets/TextureCollection.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,7 @@ namespace TrenchBroom {
 
     namespace IO {
         class Path;
+        class TextureCache;
         class TextureLoader;
     }
 
@@ -54,6 +56,9 @@ namespace TrenchBroom {
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            bool m_packTextures;
+            bool m_loadTexturesOnDemand;
+            std::shared_ptr<const IO::TextureCache> m_textureCache;
         public:
             TextureManager(int magFilter, int minFilter, Logger& logger);
             ~TextureManager();
@@ -66,6 +71,29 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Controls whether small textures are packed into texture arrays when they are prepared. Only affects
+             * texture collections that are prepared after this setting was changed.
+             *
+             * If textures are loaded on demand, only the textures which are in use when their collection is prepared
+             * are packed, see TextureCollection::prepare.
+             */
+            void setPackTextures(bool packTextures);
+
+            /**
+             * Controls whether texture collections only read the headers of their textures when they are loaded. The
+             * pixels of such a texture are decoded when it is first used. Only affects texture collections that are
+             * loaded after this setting was changed.
+             */
+            void setLoadTexturesOnDemand(bool loadTexturesOnDemand);
+
+            /**
+             * The cache in which texture loaders look up textures before decoding them, or null if decoded textures
+             * are not cached.
+             */
+            const std::shared_ptr<const IO::TextureCache>& textureCache() const;
+            void setTextureCache(std::shared_ptr<const IO::TextureCache> textureCache);
             void commitChanges();
 
             const Texture* texture(const std::string& name) const;
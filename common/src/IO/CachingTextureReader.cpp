@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CachingTextureReader.h"
+
+#include "Ensure.h"
+#include "Assets/Texture.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TextureCache.h"
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        CachingTextureReader::CachingTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureReader> textureReader, std::shared_ptr<const TextureCache> textureCache, const std::string& salt) :
+        TextureReader(nameStrategy, fs, logger),
+        m_textureReader(std::move(textureReader)),
+        m_textureCache(std::move(textureCache)),
+        m_salt(salt) {
+            ensure(m_textureReader != nullptr, "textureReader is null");
+            ensure(m_textureCache != nullptr, "textureCache is null");
+        }
+
+        Assets::Texture CachingTextureReader::doReadTexture(std::shared_ptr<File> file) const {
+            const auto& path = file->path();
+
+            // the name depends on the name strategy, e.g. when several shaders share an image
+            const auto key = [&]() {
+                auto reader = file->reader().buffer();
+                return TextureCache::makeKey(reader.begin(), reader.end(), path, m_salt + ":" + textureName(path));
+            }();
+
+            if (auto texture = m_textureCache->read(key)) {
+                return std::move(*texture);
+            }
+
+            auto texture = m_textureReader->readTextureOrThrow(file);
+            m_textureCache->write(key, texture);
+            return texture;
+        }
+
+        std::optional<Assets::Texture> CachingTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+            return m_textureReader->readTextureHeader(file);
+        }
+
+        bool CachingTextureReader::doCanReadConcurrently() const {
+            return m_textureReader->canReadConcurrently();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/TextureReader.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace TrenchBroom {
+    class Logger;
+
+    namespace IO {
+        class File;
+        class FileSystem;
+        class TextureCache;
+
+        /**
+         * Reads textures using another texture reader, but looks them up in a texture cache first. Textures that are
+         * not in the cache are read by the other reader and then written to the cache.
+         */
+        class CachingTextureReader : public TextureReader {
+        private:
+            std::shared_ptr<const TextureReader> m_textureReader;
+            std::shared_ptr<const TextureCache> m_textureCache;
+            std::string m_salt;
+        public:
+            /**
+             * Creates a new caching texture reader.
+             *
+             * @param nameStrategy the name strategy of the given texture reader
+             * @param fs the file system of the given texture reader
+             * @param logger the logger to use
+             * @param textureReader the reader that decodes textures that are not in the cache
+             * @param textureCache the cache
+             * @param salt identifies how the given reader decodes textures, e.g. its format and its palette
+             */
+            CachingTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureReader> textureReader, std::shared_ptr<const TextureCache> textureCache, const std::string& salt);
+        private:
+            Assets::Texture doReadTexture(std::shared_ptr<File> file) const override;
+            std::optional<Assets::Texture> doReadTextureHeader(std::shared_ptr<File> file) const override;
+            bool doCanReadConcurrently() const override;
+        };
+    }
+}
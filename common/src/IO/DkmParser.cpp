@@ -22,10 +22,12 @@
 #include "Exceptions.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "IO/FileSystem.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
 #include "IO/Reader.h"
+#include "IO/SkinCache.h"
 #include "IO/SkinLoader.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/IndexRangeMap.h"
@@ -229,11 +231,12 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
-        DkmParser::DkmParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs) :
+        DkmParser::DkmParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache) :
         m_name(name),
         m_begin(begin),
         m_end(end),
-        m_fs(fs) {}
+        m_fs(fs),
+        m_skinCache(std::move(skinCache)) {}
 
         // http://tfc.duke.free.fr/old/models/md2.htm
         std::unique_ptr<Assets::EntityModel> DkmParser::doInitializeModel(Logger& logger) {
@@ -381,12 +384,14 @@ namespace TrenchBroom {
         }
 
         void DkmParser::loadSkins(Assets::EntityModelSurface& surface, const DkmParser::DkmSkinList& skins, Logger& logger) {
-            std::vector<Assets::Texture> textures;
+            std::vector<std::shared_ptr<Assets::TextureCollection>> textures;
             textures.reserve(skins.size());
             
             for (const auto& skin : skins) {
                 const auto skinPath = findSkin(skin);
-                textures.push_back(loadSkin(skinPath, m_fs, logger));
+                textures.push_back(loadCachedSkin(m_skinCache.get(), skinPath, [&]() {
+                    return loadSkin(skinPath, m_fs, logger);
+                }));
             }
             
             surface.setSkins(std::move(textures));
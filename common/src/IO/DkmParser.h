@@ -25,6 +25,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,7 @@ namespace TrenchBroom {
         class FileSystem;
         class Path;
         class Reader;
+        class SkinCache;
 
         namespace DkmLayout {
             static const int Ident = (('D'<<24) + ('M'<<16) + ('K'<<8) + 'D');
@@ -92,8 +94,9 @@ namespace TrenchBroom {
             const char* m_begin;
             const char* m_end;
             const FileSystem& m_fs;
+            std::shared_ptr<SkinCache> m_skinCache;
         public:
-            DkmParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs);
+            DkmParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache = nullptr);
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
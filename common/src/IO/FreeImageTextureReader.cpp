@@ -23,6 +23,7 @@
 #include "Ensure.h"
 #include "Exceptions.h"
 #include "FreeImage.h"
+#include "Macros.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureBuffer.h"
 #include "IO/File.h"
@@ -141,5 +142,47 @@ namespace TrenchBroom {
 
             return Assets::Texture(textureName(path), imageWidth, imageHeight, averageColor, std::move(buffers), format, textureType);
         }
+
+        std::optional<Assets::Texture> FreeImageTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+#if defined(FIF_LOAD_NOPIXELS)
+            auto reader = file->reader().buffer();
+
+            InitFreeImage::initialize();
+
+            const auto* begin       = reader.begin();
+            const auto* end         = reader.end();
+            const auto  imageSize   = static_cast<size_t>(end - begin);
+                  auto* imageBegin  = reinterpret_cast<BYTE*>(const_cast<char*>(begin));
+                  auto* imageMemory = FreeImage_OpenMemory(imageBegin, static_cast<DWORD>(imageSize));
+            const auto  imageFormat = FreeImage_GetFileTypeFromMemory(imageMemory);
+
+            if (imageFormat == FIF_UNKNOWN || !FreeImage_FIFSupportsNoPixels(imageFormat)) {
+                FreeImage_CloseMemory(imageMemory);
+                return std::nullopt;
+            }
+
+            auto* image = FreeImage_LoadFromMemory(imageFormat, imageMemory, FIF_LOAD_NOPIXELS);
+            if (image == nullptr) {
+                FreeImage_CloseMemory(imageMemory);
+                return std::nullopt;
+            }
+
+            const auto imageWidth  = static_cast<size_t>(FreeImage_GetWidth(image));
+            const auto imageHeight = static_cast<size_t>(FreeImage_GetHeight(image));
+
+            FreeImage_Unload(image);
+            FreeImage_CloseMemory(imageMemory);
+
+            if (imageWidth == 0 || imageHeight == 0 || !checkTextureDimensions(imageWidth, imageHeight)) {
+                return std::nullopt;
+            }
+
+            return Assets::Texture(textureName(file->path()), imageWidth, imageHeight, freeImage32BPPFormatToGLFormat());
+#else
+            // this version of FreeImage cannot read an image's header without decoding its pixels
+            unused(file);
+            return std::nullopt;
+#endif
+        }
     }
 }
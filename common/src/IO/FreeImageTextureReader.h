@@ -36,6 +36,7 @@ namespace TrenchBroom {
             explicit FreeImageTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger);
         private:
             Assets::Texture doReadTexture(std::shared_ptr<File> file) const override;
+            std::optional<Assets::Texture> doReadTextureHeader(std::shared_ptr<File> file) const override;
         };
     }
 }
@@ -23,11 +23,18 @@
 #include "IO/DiskFileSystem.h"
 #include "IO/File.h"
 
+#include <kdl/string_format.h>
+
 #include <cassert>
 #include <memory>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
+        static std::string indexKey(const Path& path) {
+            return kdl::str_to_lower(path.asString("/"));
+        }
+
         ImageFileSystemBase::FileEntry::~FileEntry() = default;
 
        std::shared_ptr<File> ImageFileSystemBase::FileEntry::open() const {
@@ -143,6 +150,16 @@ namespace TrenchBroom {
             return contents;
         }
 
+        void ImageFileSystemBase::Directory::addToIndex(const Path& path, FileIndex& files, DirectoryIndex& directories) const {
+            directories.emplace(indexKey(path), this);
+            for (const auto& entry : m_directories) {
+                entry.second->addToIndex(path + entry.first, files, directories);
+            }
+            for (const auto& entry : m_files) {
+                files.emplace(indexKey(path + entry.first), entry.second.get());
+            }
+        }
+
         ImageFileSystemBase::Directory& ImageFileSystemBase::Directory::findOrCreateDirectory(const Path& path) {
             if (path.isEmpty()) {
                 return *this;
@@ -167,35 +184,70 @@ namespace TrenchBroom {
         void ImageFileSystemBase::initialize() {
             try {
                 doReadDirectory();
+                buildIndex();
             } catch (const std::exception& e) {
                 throw FileSystemException("Could not initialize image file system '" + m_path.asString() + "': " + e.what());
             }
         }
 
         void ImageFileSystemBase::reload() {
+            m_fileIndex.clear();
+            m_directoryIndex.clear();
             m_root = Directory(Path());
             initialize();
         }
 
+        void ImageFileSystemBase::buildIndex() {
+            m_fileIndex.clear();
+            m_directoryIndex.clear();
+            m_root.addToIndex(Path(), m_fileIndex, m_directoryIndex);
+        }
+
+        bool ImageFileSystemBase::indexed() const {
+            // the directory index contains at least the root directory once it has been built
+            return !m_directoryIndex.empty();
+        }
+
         bool ImageFileSystemBase::doDirectoryExists(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.directoryExists(searchPath);
+            const auto searchPath = path.makeCanonical();
+            if (!indexed()) {
+                return m_root.directoryExists(searchPath);
+            }
+            return m_directoryIndex.count(indexKey(searchPath)) > 0;
         }
 
         bool ImageFileSystemBase::doFileExists(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.fileExists(searchPath);
+            const auto searchPath = path.makeCanonical();
+            if (!indexed()) {
+                return m_root.fileExists(searchPath);
+            }
+            return m_fileIndex.count(indexKey(searchPath)) > 0;
         }
 
         std::vector<Path> ImageFileSystemBase::doGetDirectoryContents(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            const auto& directory = m_root.findDirectory(path);
-            return directory.contents();
+            const auto searchPath = path.makeCanonical();
+            if (!indexed()) {
+                return m_root.findDirectory(searchPath).contents();
+            }
+
+            const auto it = m_directoryIndex.find(indexKey(searchPath));
+            if (it == std::end(m_directoryIndex)) {
+                throw FileSystemException("Path does not exist: '" + searchPath.asString() + "'");
+            }
+            return it->second->contents();
         }
 
         std::shared_ptr<File> ImageFileSystemBase::doOpenFile(const Path& path) const {
-            const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.findFile(path).open();
+            const auto searchPath = path.makeCanonical();
+            if (!indexed()) {
+                return m_root.findFile(searchPath).open();
+            }
+
+            const auto it = m_fileIndex.find(indexKey(searchPath));
+            if (it == std::end(m_fileIndex)) {
+                throw FileSystemException("File not found: '" + searchPath.asString() + "'");
+            }
+            return it->second->open();
         }
 
         ImageFileSystem::ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
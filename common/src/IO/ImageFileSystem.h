@@ -26,6 +26,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace IO {
@@ -64,6 +66,12 @@ namespace TrenchBroom {
                 virtual std::unique_ptr<char[]> decompress(std::shared_ptr<File> file, size_t uncompressedSize) const = 0;
             };
 
+            class Directory;
+
+            // maps case folded paths to the entries of the directory tree
+            using FileIndex = std::unordered_map<std::string, const FileEntry*>;
+            using DirectoryIndex = std::unordered_map<std::string, const Directory*>;
+
             class Directory {
             private:
                 using DirMap  = std::map<Path, std::unique_ptr<Directory>, Path::Less<kdl::ci::string_less>>;
@@ -84,12 +92,28 @@ namespace TrenchBroom {
                 const Directory& findDirectory(const Path& path) const;
                 const FileEntry& findFile(const Path& path) const;
                 std::vector<Path> contents() const;
+
+                /**
+                 * Adds this directory and all of its files and sub directories to the given indices.
+                 *
+                 * @param path the path of this directory
+                 * @param files the file index to add to
+                 * @param directories the directory index to add to
+                 */
+                void addToIndex(const Path& path, FileIndex& files, DirectoryIndex& directories) const;
             private:
                 Directory& findOrCreateDirectory(const Path& path);
             };
         protected:
             Path m_path;
             Directory m_root;
+        private:
+            /**
+             * Flat indices of the directory tree so that lookups do not descend the tree one component at a time. They
+             * are built once the directory has been read; until then, lookups use the tree.
+             */
+            FileIndex m_fileIndex;
+            DirectoryIndex m_directoryIndex;
         protected:
             ImageFileSystemBase(std::shared_ptr<FileSystem> next, const Path& path);
         public:
@@ -102,6 +126,9 @@ namespace TrenchBroom {
              */
             void reload();
         private:
+            void buildIndex();
+            bool indexed() const;
+
             bool doDirectoryExists(const Path& path) const override;
             bool doFileExists(const Path& path) const override;
 
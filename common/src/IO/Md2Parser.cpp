@@ -22,10 +22,12 @@
 #include "Exceptions.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/Palette.h"
 #include "IO/Reader.h"
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
+#include "IO/SkinCache.h"
 #include "IO/SkinLoader.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/IndexRangeMap.h"
@@ -223,12 +225,13 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
-        Md2Parser::Md2Parser(const std::string& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
+        Md2Parser::Md2Parser(const std::string& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache) :
         m_name(name),
         m_begin(begin),
         m_end(end),
         m_palette(palette),
-        m_fs(fs) {}
+        m_fs(fs),
+        m_skinCache(std::move(skinCache)) {}
 
         // http://tfc.duke.free.fr/old/models/md2.htm
         std::unique_ptr<Assets::EntityModel> Md2Parser::doInitializeModel(Logger& logger) {
@@ -346,11 +349,14 @@ namespace TrenchBroom {
         }
 
         void Md2Parser::loadSkins(Assets::EntityModelSurface& surface, const Md2SkinList& skins, Logger& logger) {
-            std::vector<Assets::Texture> textures;
+            std::vector<std::shared_ptr<Assets::TextureCollection>> textures;
             textures.reserve(skins.size());
             
             for (const auto& skin : skins) {
-                textures.push_back(loadSkin(Path(skin), m_fs, logger, m_palette));
+                const auto skinPath = Path(skin);
+                textures.push_back(loadCachedSkin(m_skinCache.get(), skinPath, [&]() {
+                    return loadSkin(skinPath, m_fs, logger, m_palette);
+                }));
             }
             
             surface.setSkins(std::move(textures));
@@ -25,6 +25,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@ namespace TrenchBroom {
     namespace IO {
         class FileSystem;
         class Reader;
+        class SkinCache;
 
         namespace Md2Layout {
             static const int Ident = (('2'<<24) + ('P'<<16) + ('D'<<8) + 'I');
@@ -94,8 +96,9 @@ namespace TrenchBroom {
             const char* m_end;
             const Assets::Palette& m_palette;
             const FileSystem& m_fs;
+            std::shared_ptr<SkinCache> m_skinCache;
         public:
-            Md2Parser(const std::string& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs);
+            Md2Parser(const std::string& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache = nullptr);
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
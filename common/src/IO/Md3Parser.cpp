@@ -22,9 +22,11 @@
 #include "Logger.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "IO/FileSystem.h"
 #include "IO/Reader.h"
 #include "IO/ResourceUtils.h"
+#include "IO/SkinCache.h"
 #include "IO/SkinLoader.h"
 #include "Renderer/IndexRangeMapBuilder.h"
 #include "Renderer/PrimType.h"
@@ -50,11 +52,12 @@ namespace TrenchBroom {
             static const float VertexScale = 1.0f / 64.0f;
         }
 
-        Md3Parser::Md3Parser(const std::string& name, const char* begin, const char* end, const FileSystem& fs) :
+        Md3Parser::Md3Parser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache) :
         m_name(name),
         m_begin(begin),
         m_end(end),
-        m_fs(fs) {
+        m_fs(fs),
+        m_skinCache(std::move(skinCache)) {
             assert(m_begin < m_end);
             unused(m_end);
         }
@@ -262,11 +265,13 @@ namespace TrenchBroom {
         }
 
         void Md3Parser::loadSurfaceSkins(Assets::EntityModelSurface& surface, const std::vector<Path>& shaders, Logger& logger) {
-            std::vector<Assets::Texture> textures;
+            std::vector<std::shared_ptr<Assets::TextureCollection>> textures;
             textures.reserve(shaders.size());
             
             for (const auto& shader : shaders) {
-                textures.push_back(loadShader(logger, shader));
+                textures.push_back(loadCachedSkin(m_skinCache.get(), shader.deleteExtension(), [&]() {
+                    return loadShader(logger, shader);
+                }));
             }
             
             surface.setSkins(std::move(textures));
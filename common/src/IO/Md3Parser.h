@@ -37,6 +37,7 @@ namespace TrenchBroom {
         class FileSystem;
         class Path;
         class Reader;
+        class SkinCache;
 
         class Md3Parser : public EntityModelParser {
         private:
@@ -44,12 +45,13 @@ namespace TrenchBroom {
             const char* m_begin;
             const char* m_end;
             const FileSystem& m_fs;
+            std::shared_ptr<SkinCache> m_skinCache;
         private:
             struct Md3Triangle {
                 size_t i1, i2, i3;
             };
         public:
-            Md3Parser(const std::string& name, const char* begin, const char* end, const FileSystem& fs);
+            Md3Parser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache = nullptr);
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
@@ -22,9 +22,11 @@
 #include "Exceptions.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "IO/Reader.h"
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
+#include "IO/SkinCache.h"
 #include "IO/SkinLoader.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/IndexRangeMap.h"
@@ -222,11 +224,12 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
-        MdxParser::MdxParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs) :
+        MdxParser::MdxParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache) :
         m_name(name),
         m_begin(begin),
         m_end(end),
-        m_fs(fs) {}
+        m_fs(fs),
+        m_skinCache(std::move(skinCache)) {}
 
         // http://tfc.duke.free.fr/old/models/md2.htm
         std::unique_ptr<Assets::EntityModel> MdxParser::doInitializeModel(Logger& logger) {
@@ -353,7 +356,7 @@ namespace TrenchBroom {
         }
 
         void MdxParser::loadSkins(Assets::EntityModelSurface& surface, const MdxSkinList& skins, Logger& logger) {
-            std::vector<Assets::Texture> textures;
+            std::vector<std::shared_ptr<Assets::TextureCollection>> textures;
             textures.reserve(skins.size());
         
             for (const auto& skin : skins) {
@@ -361,7 +364,9 @@ namespace TrenchBroom {
                 if (path.isAbsolute()) {
                     path = path.makeRelative();
                 }
-                textures.push_back(loadSkin(path, m_fs, logger));
+                textures.push_back(loadCachedSkin(m_skinCache.get(), path, [&]() {
+                    return loadSkin(path, m_fs, logger);
+                }));
             }
             
             surface.setSkins(std::move(textures));
@@ -25,6 +25,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,7 @@ namespace TrenchBroom {
     namespace IO {
         class FileSystem;
         class Reader;
+        class SkinCache;
 
         namespace MdxLayout {
             static const int Ident = (('X'<<24) + ('P'<<16) + ('D'<<8) + 'I');
@@ -91,8 +93,9 @@ namespace TrenchBroom {
             const char* m_begin;
             const char* m_end;
             const FileSystem& m_fs;
+            std::shared_ptr<SkinCache> m_skinCache;
         public:
-            MdxParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs);
+            MdxParser(const std::string& name, const char* begin, const char* end, const FileSystem& fs, std::shared_ptr<SkinCache> skinCache = nullptr);
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
@@ -118,5 +118,25 @@ namespace TrenchBroom {
                 throw AssetException(e.what());
             }
         }
+
+        std::optional<Assets::Texture> MipTextureReader::doReadTextureHeader(std::shared_ptr<File> file) const {
+            const auto path = file->path();
+            const auto basename = path.lastComponent().deleteExtension().asString();
+            const auto name = textureName(basename, path);
+
+            auto reader = file->reader();
+            reader.seekForward(MipLayout::TextureNameLength);
+
+            const auto width = reader.readSize<int32_t>();
+            const auto height = reader.readSize<int32_t>();
+            if (width == 0 || height == 0 || !checkTextureDimensions(width, height)) {
+                return std::nullopt;
+            }
+
+            const auto type = (!name.empty() && name.at(0) == '{')
+                              ? Assets::TextureType::Masked
+                              : Assets::TextureType::Opaque;
+            return Assets::Texture(name, width, height, GL_RGBA, type);
+        }
     }
 }
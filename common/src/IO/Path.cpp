@@ -25,8 +25,8 @@
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
-#include <kdl/vector_utils.h>
 
+#include <cstdint>
 #include <iterator>
 #include <ostream>
 #include <string>
@@ -37,47 +37,113 @@ namespace TrenchBroom {
             return std::string_view("/\\");
         }
 
-        Path::Path(bool absolute, const std::vector<std::string>& components) :
-        m_components(components),
-        m_absolute(absolute) {}
+        struct Path::Data {
+            // the components stored back to back, without separators
+            std::string buffer;
+            // the offset of each component in the buffer, followed by the size of the buffer
+            std::vector<size_t> offsets;
+            bool absolute;
+            size_t hash;
+        };
+
+        static size_t hashComponents(const bool absolute, const std::vector<std::string_view>& components) {
+            // FNV-1a over the case folded components, terminating each component with a separator
+            constexpr auto prime = std::uint64_t(1099511628211u);
+            auto hash = std::uint64_t(14695981039346656037u);
+            const auto combine = [&](const char c) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= prime;
+            };
+
+            combine(absolute ? '/' : '\0');
+            for (const auto& component : components) {
+                for (const auto c : component) {
+                    combine(kdl::str_to_lower(c));
+                }
+                combine('/');
+            }
+            return static_cast<size_t>(hash);
+        }
+
+        Path::Path(std::shared_ptr<const Data> data) :
+        m_data(std::move(data)) {}
+
+        Path::Path(const bool absolute, const std::vector<std::string_view>& components) {
+            if (!absolute && components.empty()) {
+                // empty paths are created very often, so they all share the same data
+                static const auto empty = std::make_shared<const Data>(Data{"", { 0u }, false, hashComponents(false, {})});
+                m_data = empty;
+                return;
+            }
+
+            auto size = size_t(0);
+            for (const auto& component : components) {
+                size += component.size();
+            }
+
+            auto data = Data{"", {}, absolute, hashComponents(absolute, components)};
+            data.buffer.reserve(size);
+            data.offsets.reserve(components.size() + 1u);
+            for (const auto& component : components) {
+                data.offsets.push_back(data.buffer.size());
+                data.buffer.append(component);
+            }
+            data.offsets.push_back(data.buffer.size());
+
+            m_data = std::make_shared<const Data>(std::move(data));
+        }
 
         Path::Path(const std::string& path) {
             const auto trimmed = kdl::str_trim(path);
-            m_components = kdl::str_split(trimmed, separators());
+            const auto strings = kdl::str_split(trimmed, separators());
+            const auto components = std::vector<std::string_view>(std::begin(strings), std::end(strings));
 #ifdef _WIN32
-            m_absolute = (hasDriveSpec(m_components) ||
-                          (!trimmed.empty() && trimmed[0] == '/') ||
-                          (!trimmed.empty() && trimmed[0] == '\\'));
+            const auto absolute = (hasDriveSpec(components) ||
+                                   (!trimmed.empty() && trimmed[0] == '/') ||
+                                   (!trimmed.empty() && trimmed[0] == '\\'));
 #else
-            m_absolute = !trimmed.empty() && kdl::cs::str_is_prefix(trimmed, separator());
+            const auto absolute = !trimmed.empty() && kdl::cs::str_is_prefix(trimmed, separator());
 #endif
+            *this = Path(absolute, components);
         }
 
         Path Path::operator+(const Path& rhs) const {
             if (rhs.isAbsolute()) {
                 throw PathException("Cannot concatenate absolute path");
             }
-            auto components = m_components;
-            components.insert(std::end(components), std::begin(rhs.m_components), std::end(rhs.m_components));
-            return Path(m_absolute, components);
+            if (rhs.length() == 0u) {
+                return *this;
+            }
+            if (isEmpty()) {
+                return rhs;
+            }
+
+            auto components = componentViews();
+            const auto rhsComponents = rhs.componentViews();
+            components.insert(std::end(components), std::begin(rhsComponents), std::end(rhsComponents));
+            return Path(isAbsolute(), components);
         }
 
         int Path::compare(const Path& rhs, const bool caseSensitive) const {
+            if (m_data == rhs.m_data) {
+                return 0;
+            }
+
             if (!isAbsolute() && rhs.isAbsolute()) {
                 return -1;
             } else if (isAbsolute() && !rhs.isAbsolute()) {
                 return 1;
             }
 
-            const auto& rcomps = rhs.m_components;
+            const auto myLength = length();
+            const auto rhsLength = rhs.length();
 
             size_t i = 0;
-            const auto max = m_components.size() < rcomps.size() ? m_components.size() : rcomps.size();
+            const auto max = myLength < rhsLength ? myLength : rhsLength;
             while (i < max) {
-                const auto& mcomp = m_components[i];
-                const auto& rcomp = rcomps[i];
-                const auto result = caseSensitive ? kdl::cs::str_compare(mcomp, rcomp) : kdl::ci::str_compare(mcomp,
-                    rcomp);
+                const auto mcomp = component(i);
+                const auto rcomp = rhs.component(i);
+                const auto result = caseSensitive ? kdl::cs::str_compare(mcomp, rcomp) : kdl::ci::str_compare(mcomp, rcomp);
                 if (result < 0) {
                     return -1;
                 } else if (result > 0) {
@@ -85,9 +151,9 @@ namespace TrenchBroom {
                 }
                 ++i;
             }
-            if (m_components.size() < rcomps.size()) {
+            if (myLength < rhsLength) {
                 return -1;
-            } else if (m_components.size() > rcomps.size()) {
+            } else if (myLength > rhsLength) {
                 return 1;
             } else {
                 return 0;
@@ -95,7 +161,8 @@ namespace TrenchBroom {
         }
 
         bool Path::operator==(const Path& rhs) const {
-            return compare(rhs) == 0;
+            // equal paths have equal hashes, so most unequal paths are rejected without comparing their components
+            return m_data == rhs.m_data || (m_data->hash == rhs.m_data->hash && compare(rhs) == 0);
         }
 
         bool Path::operator!= (const Path& rhs) const {
@@ -110,19 +177,29 @@ namespace TrenchBroom {
             return compare(rhs) > 0;
         }
 
+        size_t Path::hash() const {
+            return m_data->hash;
+        }
+
         std::string Path::asString(const std::string_view separator) const {
-            if (m_absolute) {
+            auto result = std::string();
+            result.reserve(m_data->buffer.size() + (length() + 1u) * separator.size());
+
+            if (isAbsolute()
 #ifdef _WIN32
-                if (hasDriveSpec(m_components)) {
-                    return kdl::str_join(m_components, separator);
-                } else {
-                    return std::string(separator) + kdl::str_join(m_components, separator);
-                }
-#else
-                return std::string(separator) + kdl::str_join(m_components, separator);
+                && !hasDriveSpec(componentViews())
 #endif
+                ) {
+                result += separator;
+            }
+
+            for (size_t i = 0u; i < length(); ++i) {
+                if (i > 0u) {
+                    result += separator;
+                }
+                result += component(i);
             }
-            return kdl::str_join(m_components, separator);
+            return result;
         }
 
 
@@ -146,11 +223,11 @@ namespace TrenchBroom {
         }
 
         size_t Path::length() const {
-            return m_components.size();
+            return m_data->offsets.size() - 1u;
         }
 
         bool Path::isEmpty() const {
-            return !m_absolute && m_components.empty();
+            return !isAbsolute() && length() == 0u;
         }
 
         Path Path::firstComponent() const {
@@ -158,13 +235,13 @@ namespace TrenchBroom {
                 throw PathException("Cannot return first component of empty path");
             }
 
-            if (!m_absolute) {
-                return Path(m_components.front());
+            if (!isAbsolute()) {
+                return Path(std::string(component(0u)));
             }
 
 #ifdef _WIN32
-            if (hasDriveSpec(m_components)) {
-                return Path(m_components.front());
+            if (hasDriveSpec(componentViews())) {
+                return Path(std::string(component(0u)));
             }
 
             return Path("\\");
@@ -177,30 +254,25 @@ namespace TrenchBroom {
             if (isEmpty()) {
                 throw PathException("Cannot delete first component of empty path");
             }
-            if (!m_absolute) {
-                auto components = std::vector<std::string>();
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
+            const auto components = componentViews();
+            if (!isAbsolute()) {
+                return Path(false, std::vector<std::string_view>(std::next(std::begin(components)), std::end(components)));
             }
 #ifdef _WIN32
-            if (!m_components.empty() && hasDriveSpec(m_components[0])) {
-                std::vector<std::string> components;
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
+            if (!components.empty() && hasDriveSpec(components[0])) {
+                return Path(false, std::vector<std::string_view>(std::next(std::begin(components)), std::end(components)));
             }
-            return Path(false, m_components);
+            return Path(false, components);
 #else
-            return Path(false, m_components);
+            return Path(false, components);
 #endif
         }
 
         Path Path::lastComponent() const {
             if (isEmpty())
                 throw PathException("Cannot return last component of empty path");
-            if (!m_components.empty()) {
-                return Path(m_components.back());
+            if (length() > 0u) {
+                return Path(std::string(component(length() - 1u)));
             } else {
                 return Path("");
             }
@@ -211,13 +283,12 @@ namespace TrenchBroom {
                 throw PathException("Cannot delete last component of empty path");
             }
 
-            if (!m_components.empty()) {
-                auto components = std::vector<std::string>();
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components), std::end(m_components) - 1);
-                return Path(m_absolute, components);
+            if (length() > 0u) {
+                auto components = componentViews();
+                components.pop_back();
+                return Path(isAbsolute(), components);
             } else {
-                return Path(m_absolute, m_components);
+                return *this;
             }
         }
 
@@ -226,11 +297,11 @@ namespace TrenchBroom {
         }
 
         Path Path::suffix(const size_t count) const {
-            return subPath(m_components.size() - count, count);
+            return subPath(length() - count, count);
         }
 
         Path Path::subPath(const size_t index, const size_t count) const {
-            if (index + count > m_components.size()) {
+            if (index + count > length()) {
                 throw PathException("Sub path out of bounds");
             }
 
@@ -238,16 +309,26 @@ namespace TrenchBroom {
                 return Path("");
             }
 
-            auto newComponents = std::vector<std::string>();
+            if (count == length()) {
+                return *this;
+            }
+
+            auto newComponents = std::vector<std::string_view>();
             newComponents.reserve(count);
             for (size_t i = 0u; i < count; ++i) {
-                newComponents.push_back(m_components[index + i]);
+                newComponents.push_back(component(index + i));
             }
-            return Path(m_absolute && index == 0, newComponents);
+            return Path(isAbsolute() && index == 0, newComponents);
+        }
+
+        std::string_view Path::component(const size_t index) const {
+            const auto& offsets = m_data->offsets;
+            return std::string_view(m_data->buffer).substr(offsets[index], offsets[index + 1u] - offsets[index]);
         }
 
-        const std::vector<std::string>& Path::components() const {
-            return m_components;
+        std::vector<std::string> Path::components() const {
+            const auto components = componentViews();
+            return std::vector<std::string>(std::begin(components), std::end(components));
         }
 
         std::string Path::filename() const {
@@ -255,10 +336,10 @@ namespace TrenchBroom {
                 throw PathException("Cannot get filename of empty path");
             }
 
-            if (m_components.empty()) {
+            if (length() == 0u) {
                 return "";
             } else {
-                return m_components.back();
+                return std::string(component(length() - 1u));
             }
         }
 
@@ -358,17 +439,20 @@ namespace TrenchBroom {
                 throw PathException("Cannot add extension to empty path");
             }
 
-            auto components = m_components;
+            auto components = componentViews();
+            auto filename = std::string();
             if (components.empty()
 #ifdef _WIN32
-                || hasDriveSpec(m_components.back())
+                || hasDriveSpec(components.back())
 #endif
                 ) {
-                components.push_back("." + extension);
+                filename = "." + extension;
+                components.push_back(filename);
             } else {
-                components.back() += "." + extension;
+                filename = std::string(components.back()) + "." + extension;
+                components.back() = filename;
             }
-            return Path(m_absolute, components);
+            return Path(isAbsolute(), components);
         }
 
         Path Path::replaceExtension(const std::string& extension) const {
@@ -383,7 +467,7 @@ namespace TrenchBroom {
         }
 
         bool Path::isAbsolute() const {
-            return m_absolute;
+            return m_data->absolute;
         }
 
         bool Path::canMakeRelative(const Path& absolutePath) const {
@@ -391,9 +475,9 @@ namespace TrenchBroom {
                     isAbsolute() && absolutePath.isAbsolute()
 #ifdef _WIN32
                     &&
-                    !m_components.empty() && !absolutePath.m_components.empty()
+                    length() > 0u && absolutePath.length() > 0u
                     &&
-                    m_components[0] == absolutePath.m_components[0]
+                    component(0u) == absolutePath.component(0u)
 #endif
             );
         }
@@ -420,13 +504,13 @@ namespace TrenchBroom {
             }
 
 #ifdef _WIN32
-            if (m_components.empty()) {
+            if (length() == 0u) {
                 throw PathException("Cannot make relative path from an reference path with no drive spec");
             }
 
-            return Path(false, kdl::vec_slice_suffix(m_components, m_components.size() - 1u));
+            return subPath(1u, length() - 1u);
 #else
-            return Path(false, m_components);
+            return Path(false, componentViews());
 #endif
 
 
@@ -450,19 +534,19 @@ namespace TrenchBroom {
             }
 
 #ifdef _WIN32
-            if (m_components.empty()) {
+            if (length() == 0u) {
                 throw PathException("Cannot make relative path from an reference path with no drive spec");
             }
-            if (absolutePath.m_components.empty()) {
+            if (absolutePath.length() == 0u) {
                 throw PathException("Cannot make relative path with sub path with no drive spec");
             }
-            if (m_components[0] != absolutePath.m_components[0]) {
+            if (component(0u) != absolutePath.component(0u)) {
                 throw PathException("Cannot make relative path if reference path has different drive spec");
             }
 #endif
 
-            const auto myResolved = resolvePath(true, m_components);
-            const auto theirResolved = resolvePath(true, absolutePath.m_components);
+            const auto myResolved = resolvePath(true, componentViews());
+            const auto theirResolved = resolvePath(true, absolutePath.componentViews());
 
             // cross off all common prefixes
             size_t p = 0;
@@ -474,7 +558,7 @@ namespace TrenchBroom {
                 ++p;
             }
 
-            auto components = std::vector<std::string>();
+            auto components = std::vector<std::string_view>();
             for (size_t i = p; i < myResolved.size(); ++i) {
                 components.push_back("..");
             }
@@ -486,16 +570,24 @@ namespace TrenchBroom {
         }
 
         Path Path::makeCanonical() const {
-            return Path(m_absolute, resolvePath(m_absolute, m_components));
+            const auto components = componentViews();
+            const auto resolved = resolvePath(isAbsolute(), components);
+
+            // resolving removes every "." and ".." component, so if nothing was removed, the path is already canonical
+            if (resolved.size() == components.size()) {
+                return *this;
+            }
+            return Path(isAbsolute(), resolved);
         }
 
         Path Path::makeLowerCase() const {
-            auto lcComponents = std::vector<std::string>();
-            lcComponents.reserve(m_components.size());
-            for (const auto& component : m_components) {
-                lcComponents.push_back(kdl::str_to_lower(component));
+            auto buffer = kdl::str_to_lower(m_data->buffer);
+            if (buffer == m_data->buffer) {
+                return *this;
             }
-            return Path(m_absolute, lcComponents);
+
+            // the offsets and the case folded hash do not change
+            return Path(std::make_shared<const Data>(Data{std::move(buffer), m_data->offsets, m_data->absolute, m_data->hash}));
         }
 
         std::vector<Path> Path::makeAbsoluteAndCanonical(const std::vector<Path>& paths, const Path& relativePath) {
@@ -507,8 +599,17 @@ namespace TrenchBroom {
             return result;
         }
 
+        std::vector<std::string_view> Path::componentViews() const {
+            auto result = std::vector<std::string_view>();
+            result.reserve(length());
+            for (size_t i = 0u; i < length(); ++i) {
+                result.push_back(component(i));
+            }
+            return result;
+        }
+
 #ifdef _WIN32
-        bool Path::hasDriveSpec(const std::vector<std::string>& components) {
+        bool Path::hasDriveSpec(const std::vector<std::string_view>& components) {
             if (components.empty()) {
                 return false;
             } else {
@@ -516,13 +617,13 @@ namespace TrenchBroom {
             }
         }
 #else
-        bool Path::hasDriveSpec(const std::vector<std::string>& /* components */) {
+        bool Path::hasDriveSpec(const std::vector<std::string_view>& /* components */) {
             return false;
         }
 #endif
 
 #ifdef _WIN32
-        bool Path::hasDriveSpec(const std::string& component) {
+        bool Path::hasDriveSpec(const std::string_view component) {
             if (component.size() <= 1) {
                 return false;
             } else {
@@ -530,13 +631,13 @@ namespace TrenchBroom {
             }
         }
 #else
-        bool Path::hasDriveSpec(const std::string& /* component */) {
+        bool Path::hasDriveSpec(const std::string_view /* component */) {
             return false;
         }
 #endif
 
-        std::vector<std::string> Path::resolvePath(const bool absolute, const std::vector<std::string>& components) const {
-            auto resolved = std::vector<std::string>();
+        std::vector<std::string_view> Path::resolvePath(const bool absolute, const std::vector<std::string_view>& components) {
+            auto resolved = std::vector<std::string_view>();
             for (const auto& comp : components) {
                 if (comp == ".") {
                     continue;
@@ -20,12 +20,18 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 #include <string_view>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * An immutable path. The components of a path are stored in a single buffer that is shared between copies,
+         * so copying a path does not allocate, and a hash of the case folded components is computed once when the
+         * path is created.
+         */
         class Path {
         public:
             static constexpr std::string_view separator() {
@@ -42,18 +48,33 @@ namespace TrenchBroom {
                 StringLess m_less;
             public:
                 bool operator()(const Path& lhs, const Path& rhs) const {
-                    return std::lexicographical_compare(std::begin(lhs.m_components), std::end(lhs.m_components),
-                                                        std::begin(rhs.m_components), std::end(rhs.m_components), m_less);
+                    const auto lhsLength = lhs.length();
+                    const auto rhsLength = rhs.length();
+                    for (size_t i = 0u; i < lhsLength && i < rhsLength; ++i) {
+                        const auto lhsComponent = lhs.component(i);
+                        const auto rhsComponent = rhs.component(i);
+                        if (m_less(lhsComponent, rhsComponent)) {
+                            return true;
+                        } else if (m_less(rhsComponent, lhsComponent)) {
+                            return false;
+                        }
+                    }
+                    return lhsLength < rhsLength;
                 }
             };
         private:
-            std::vector<std::string> m_components;
-            bool m_absolute;
+            struct Data;
+            std::shared_ptr<const Data> m_data;
 
-            Path(bool absolute, const std::vector<std::string>& components);
+            explicit Path(std::shared_ptr<const Data> data);
+            Path(bool absolute, const std::vector<std::string_view>& components);
         public:
             explicit Path(const std::string& path = "");
 
+            // copies share their data; there are no move operations so that moved from paths remain valid
+            Path(const Path& other) = default;
+            Path& operator=(const Path& other) = default;
+
             Path operator+(const Path& rhs) const;
             int compare(const Path& rhs, bool caseSensitive = true) const;
             bool operator==(const Path& rhs) const;
@@ -61,6 +82,12 @@ namespace TrenchBroom {
             bool operator<(const Path& rhs) const;
             bool operator>(const Path& rhs) const;
 
+            /**
+             * Returns a hash of this path that ignores case, so paths that compare equal with or without case
+             * sensitivity have the same hash.
+             */
+            size_t hash() const;
+
             std::string asString(std::string_view sep = separator()) const;
             static std::vector<std::string> asStrings(const std::vector<Path>& paths, std::string_view sep = separator());
             static std::vector<Path> asPaths(const std::vector<std::string>& strs);
@@ -74,7 +101,8 @@ namespace TrenchBroom {
             Path prefix(size_t count) const;
             Path suffix(size_t count) const;
             Path subPath(size_t index, size_t count) const;
-            const std::vector<std::string>& components() const;
+            std::string_view component(size_t index) const;
+            std::vector<std::string> components() const;
 
             std::string filename() const;
             std::string basename() const;
@@ -112,12 +140,21 @@ namespace TrenchBroom {
 
             static std::vector<Path> makeAbsoluteAndCanonical(const std::vector<Path>& paths, const Path& relativePath);
         private:
-            static bool hasDriveSpec(const std::vector<std::string>& components);
-            static bool hasDriveSpec(const std::string& component);
-            std::vector<std::string> resolvePath(bool absolute, const std::vector<std::string>& components) const;
+            std::vector<std::string_view> componentViews() const;
+            static bool hasDriveSpec(const std::vector<std::string_view>& components);
+            static bool hasDriveSpec(std::string_view component);
+            static std::vector<std::string_view> resolvePath(bool absolute, const std::vector<std::string_view>& components);
         };
 
         std::ostream& operator<<(std::ostream& stream, const Path& path);
     }
 }
 
+namespace std {
+    template <>
+    struct hash<TrenchBroom::IO::Path> {
+        size_t operator()(const TrenchBroom::IO::Path& path) const {
+            return path.hash();
+        }
+    };
+}
@@ -23,17 +23,54 @@
 #include "Assets/Quake3Shader.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
+#include "IO/ParserStatus.h"
 #include "IO/Quake3ShaderParser.h"
-#include "IO/SimpleParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
+#include <exception>
+#include <iterator>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        namespace {
+            using LogMessages = std::vector<std::tuple<LogLevel, std::string>>;
+
+            /**
+             * Collects the messages of a parser so that they can be logged once all shader scripts have been parsed.
+             */
+            class DeferredParserStatus : public ParserStatus {
+            private:
+                LogMessages m_messages;
+            public:
+                DeferredParserStatus(Logger& logger, const std::string& prefix) :
+                ParserStatus(logger, prefix) {}
+
+                LogMessages takeMessages() {
+                    return std::move(m_messages);
+                }
+            private:
+                void doProgress(double) override {}
+
+                void doLog(const LogLevel level, const std::string& str) override {
+                    m_messages.emplace_back(level, str);
+                }
+            };
+
+            struct ShaderScript {
+                std::vector<Assets::Quake3Shader> shaders;
+                LogMessages messages;
+                std::exception_ptr error;
+            };
+        }
+
         Quake3ShaderFileSystem::Quake3ShaderFileSystem(std::shared_ptr<FileSystem> fs, Path shaderSearchPath, std::vector<Path> textureSearchPaths, Logger& logger) :
         ImageFileSystemBase(std::move(fs), Path()),
         m_shaderSearchPath(std::move(shaderSearchPath)),
@@ -53,18 +90,52 @@ namespace TrenchBroom {
             auto result = std::vector<Assets::Quake3Shader>();
 
             if (next().directoryExists(m_shaderSearchPath)) {
-                const auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
-                for (const auto& path : paths) {
-                    const auto file = next().openFile(path);
-                    auto bufferedReader = file->reader().buffer();
+                auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
 
+                // The scripts are opened, which may decompress them, and parsed in parallel. Loggers are not thread
+                // safe, so the messages are logged afterwards in the order of the scripts, and errors other than parser
+                // errors are rethrown here.
+                auto scripts = kdl::vec_parallel_transform(std::move(paths), [&](Path&& path) {
+                    auto script = ShaderScript{};
+
+                    auto file = std::shared_ptr<File>();
                     try {
-                        Quake3ShaderParser parser(bufferedReader.stringView());
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        result = kdl::vec_concat(std::move(result), parser.parse(status));
-                    } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        file = next().openFile(path);
+                    } catch (...) {
+                        script.error = std::current_exception();
+                        return script;
+                    }
+
+                    auto status = DeferredParserStatus(m_logger, file->path().asString());
+                    try {
+                        auto bufferedReader = file->reader().buffer();
+                        try {
+                            Quake3ShaderParser parser(bufferedReader.stringView());
+                            script.shaders = parser.parse(status);
+                            script.messages = status.takeMessages();
+                        } catch (const ParserException& e) {
+                            script.messages = status.takeMessages();
+
+                            std::stringstream str;
+                            str << "Skipping malformed shader file " << file->path() << ": " << e.what();
+                            script.messages.emplace_back(LogLevel::Warn, str.str());
+                        }
+                    } catch (...) {
+                        script.messages = status.takeMessages();
+                        script.error = std::current_exception();
+                    }
+
+                    return script;
+                });
+
+                for (auto& script : scripts) {
+                    for (const auto& [level, message] : script.messages) {
+                        m_logger.log(level, message);
+                    }
+                    if (script.error) {
+                        std::rethrow_exception(script.error);
                     }
+                    result = kdl::vec_concat(std::move(result), std::move(script.shaders));
                 }
             }
 
@@ -89,24 +160,31 @@ namespace TrenchBroom {
 
         void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders) {
             m_logger.debug() << "Linking textures...";
+
+            // Index the shaders by path so that a texture's shader can be found without searching all shaders. If
+            // several shaders have the same path, the first one is linked.
+            auto shaderIndices = std::unordered_map<std::string, size_t>();
+            shaderIndices.reserve(shaders.size());
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                shaderIndices.emplace(shaders[i].shaderPath.asString("/"), i);
+            }
+            auto linked = std::vector<bool>(shaders.size(), false);
+
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
                 if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
-
-                    if (shaderIt != std::end(shaders)) {
+                    const auto indexIt = shaderIndices.find(shaderPath.asString("/"));
+                    if (indexIt != std::end(shaderIndices)) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        const auto& shader = shaders[indexIt->second];
 
                         auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
                         m_root.addFile(shaderPath, shaderFile);
 
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
+                        // Mark the shader so that we don't revisit it when linking standalone shaders.
+                        linked[indexIt->second] = true;
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -118,6 +196,18 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            // Remove the linked shaders, keeping the order of the remaining ones.
+            size_t count = 0u;
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                if (!linked[i]) {
+                    if (count != i) {
+                        shaders[count] = std::move(shaders[i]);
+                    }
+                    ++count;
+                }
+            }
+            shaders.erase(std::next(std::begin(shaders), static_cast<std::ptrdiff_t>(count)), std::end(shaders));
         }
 
         void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
@@ -21,6 +21,7 @@
 
 #include "Assets/Quake3Shader.h"
 #include "Assets/Texture.h"
+#include "IO/CachingTextureReader.h"
 #include "IO/File.h"
 #include "IO/FileSystem.h"
 #include "IO/FreeImageTextureReader.h"
@@ -32,8 +33,9 @@
 
 namespace TrenchBroom {
     namespace IO {
-        Quake3ShaderTextureReader::Quake3ShaderTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger) :
-        TextureReader(nameStrategy, fs, logger) {}
+        Quake3ShaderTextureReader::Quake3ShaderTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureCache> textureCache) :
+        TextureReader(nameStrategy, fs, logger),
+        m_textureCache(std::move(textureCache)) {}
 
         Assets::Texture Quake3ShaderTextureReader::doReadTexture(std::shared_ptr<File> file) const {
             const auto* shaderFile = dynamic_cast<ObjectFile<Assets::Quake3Shader>*>(file.get());
@@ -79,14 +81,24 @@ namespace TrenchBroom {
             return texture;
         }
 
+        bool Quake3ShaderTextureReader::doCanReadConcurrently() const {
+            // the shader's image is opened from the file system while reading
+            return false;
+        }
+
         Assets::Texture Quake3ShaderTextureReader::loadTextureImage(const Path& shaderPath, const Path& imagePath) const {
             const auto name = textureName(shaderPath);
             if (!m_fs.fileExists(imagePath)) {
                 throw AssetException("Image file '" + imagePath.asString() + "' does not exist");
             }
 
-            FreeImageTextureReader imageReader(StaticNameStrategy(name), m_fs, m_logger);
-            return imageReader.readTexture(m_fs.openFile(imagePath));
+            const auto nameStrategy = StaticNameStrategy(name);
+            auto imageReader = std::make_shared<FreeImageTextureReader>(nameStrategy, m_fs, m_logger);
+            if (m_textureCache != nullptr) {
+                CachingTextureReader cachingReader(nameStrategy, m_fs, m_logger, std::move(imageReader), m_textureCache, "image");
+                return cachingReader.readTexture(m_fs.openFile(imagePath));
+            }
+            return imageReader->readTexture(m_fs.openFile(imagePath));
         }
 
         Path Quake3ShaderTextureReader::findTexturePath(const Assets::Quake3Shader& shader) const {
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         class File;
         class FileSystem;
         class Path;
+        class TextureCache;
 
         /**
          * Loads a texture that represents a Quake 3 shader from the file system. Uses a given file system
@@ -39,6 +40,8 @@ namespace TrenchBroom {
          * available as a virtual object file in the file system.
          */
         class Quake3ShaderTextureReader : public TextureReader {
+        private:
+            std::shared_ptr<const TextureCache> m_textureCache;
         public:
             /**
              * Creates a texture reader using the given name strategy and file system to locate the texture image.
@@ -46,10 +49,12 @@ namespace TrenchBroom {
              * @param nameStrategy the strategy to determine the texture name
              * @param fs the file system to use when locating the texture image
              * @param logger the logger to use
+             * @param textureCache the cache to look up the texture images in, may be null
              */
-            Quake3ShaderTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger);
+            Quake3ShaderTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger, std::shared_ptr<const TextureCache> textureCache = nullptr);
         private:
             Assets::Texture doReadTexture(std::shared_ptr<File> file) const override;
+            bool doCanReadConcurrently() const override;
             Assets::Texture loadTextureImage(const Path& shaderPath, const Path& imagePath) const;
             Path findTexturePath(const Assets::Quake3Shader& shader) const;
             Path findTexture(const Path& texturePath) const;
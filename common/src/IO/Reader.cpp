@@ -24,6 +24,7 @@
 
 #include <cassert>
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <functional>
 #include <string>
@@ -70,6 +71,37 @@ namespace TrenchBroom {
             return doBuffer();
         }
 
+        namespace {
+            /**
+             * Locks the given file for the lifetime of this object. Files in archives share the archive's file handle,
+             * and models may be read on several threads, so seeking and reading must not be interleaved.
+             */
+            class FileLock {
+            private:
+                std::FILE* m_file;
+            public:
+                explicit FileLock(std::FILE* file) :
+                m_file(file) {
+#ifdef _WIN32
+                    _lock_file(m_file);
+#else
+                    flockfile(m_file);
+#endif
+                }
+
+                ~FileLock() {
+#ifdef _WIN32
+                    _unlock_file(m_file);
+#else
+                    funlockfile(m_file);
+#endif
+                }
+
+                FileLock(const FileLock&) = delete;
+                FileLock& operator=(const FileLock&) = delete;
+            };
+        }
+
         Reader::FileSource::FileSource(std::FILE* file, const size_t offset, const size_t length) :
         m_file(file),
         m_offset(offset),
@@ -93,6 +125,7 @@ namespace TrenchBroom {
             // of this reader and that no other reader will access the file while this reader is in use. This may be a
             // reasonable assumption, since we usually read files one by one.
 
+            const auto lock = FileLock(m_file);
             const auto pos = std::ftell(m_file);
             if (pos < 0) {
                 throwError("ftell failed");
@@ -117,6 +150,7 @@ namespace TrenchBroom {
         }
 
         std::tuple<const char*, const char*, std::unique_ptr<char[]>> Reader::FileSource::doBuffer() const {
+            const auto lock = FileLock(m_file);
             std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET);
 
             auto buffer = std::make_unique<char[]>(m_length);
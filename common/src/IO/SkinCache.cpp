@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SkinCache.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::shared_ptr<Assets::TextureCollection> makeSkin(Assets::Texture texture) {
+            auto textures = std::vector<Assets::Texture>{};
+            textures.push_back(std::move(texture));
+            return std::make_shared<Assets::TextureCollection>(std::move(textures));
+        }
+
+        std::shared_ptr<Assets::TextureCollection> SkinCache::skin(const Path& path, const LoadSkin& loadSkin) {
+            {
+                const auto lock = std::lock_guard<std::mutex>(m_mutex);
+                auto it = m_skins.find(path);
+                if (it != std::end(m_skins)) {
+                    if (auto skin = it->second.lock()) {
+                        return skin;
+                    }
+                }
+            }
+
+            // load without holding the lock so that other threads can load other skins in the meantime
+            auto skin = makeSkin(loadSkin());
+
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            auto& cached = m_skins[path];
+            if (auto other = cached.lock()) {
+                // another thread has loaded the same skin in the meantime
+                return other;
+            }
+            cached = skin;
+            return skin;
+        }
+
+        size_t SkinCache::size() const {
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            size_t result = 0u;
+            for (const auto& entry : m_skins) {
+                if (!entry.second.expired()) {
+                    ++result;
+                }
+            }
+            return result;
+        }
+
+        void SkinCache::clear() {
+            const auto lock = std::lock_guard<std::mutex>(m_mutex);
+            m_skins.clear();
+        }
+
+        std::shared_ptr<Assets::TextureCollection> loadCachedSkin(SkinCache* cache, const Path& path, const SkinCache::LoadSkin& loadSkin) {
+            if (cache != nullptr) {
+                return cache->skin(path, loadSkin);
+            } else {
+                return makeSkin(loadSkin());
+            }
+        }
+    }
+}
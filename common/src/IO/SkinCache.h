@@ -0,0 +1,77 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/Path.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+        class TextureCollection;
+    }
+
+    namespace IO {
+        /**
+         * Shares skins between entity models that refer to the same skin file. Every skin is stored in a texture
+         * collection of its own so that it is uploaded once regardless of how many models use it.
+         *
+         * The cache only holds weak references, so a skin is released together with the last model that uses it.
+         * Models may be loaded on several threads, so the cache can be accessed concurrently.
+         */
+        class SkinCache {
+        public:
+            using LoadSkin = std::function<Assets::Texture()>;
+        private:
+            mutable std::mutex m_mutex;
+            std::map<Path, std::weak_ptr<Assets::TextureCollection>> m_skins;
+        public:
+            /**
+             * Returns the skin cached for the given path. If the skin is not cached, it is loaded using the given
+             * function and added to the cache.
+             *
+             * @param path the resolved path of the skin
+             * @param loadSkin loads the skin if it is not cached
+             * @return a texture collection containing the skin
+             */
+            std::shared_ptr<Assets::TextureCollection> skin(const Path& path, const LoadSkin& loadSkin);
+
+            /**
+             * Returns the number of skins that are cached and still in use.
+             */
+            size_t size() const;
+
+            /**
+             * Removes all skins from this cache. Models that use them keep them.
+             */
+            void clear();
+        };
+
+        /**
+         * Returns the skin for the given path from the given cache, or loads a skin that is not shared if the cache is
+         * null.
+         */
+        std::shared_ptr<Assets::TextureCollection> loadCachedSkin(SkinCache* cache, const Path& path, const SkinCache::LoadSkin& loadSkin);
+    }
+}
@@ -0,0 +1,317 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCache.h"
+
+#include "Color.h"
+#include "Exceptions.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/File.h"
+#include "IO/PathQt.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <vecmath/vec.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace TextureCacheLayout {
+            static const char Magic[4] = { 'T', 'B', 'T', 'X' };
+            // increment this when the layout of cache entries or the output of a texture reader changes
+            static const uint32_t Version = 1;
+            static const std::string EntryExtension = "tbtx";
+            // entries of larger textures are rejected so that a corrupt entry cannot cause a huge allocation
+            static const size_t MaxTextureSize = size_t(1) << 16;
+        }
+
+        const uint64_t TextureCache::DefaultMaxSize = uint64_t(512) * 1024 * 1024;
+
+        TextureCache::TextureCache(const Path& directory, const uint64_t maxSize) :
+        m_directory(directory),
+        m_maxSize(maxSize) {}
+
+        const Path& TextureCache::directory() const {
+            return m_directory;
+        }
+
+        static uint64_t fnv1a(const char* begin, const char* end, uint64_t hash) {
+            for (const char* cur = begin; cur != end; ++cur) {
+                hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*cur));
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        static uint64_t fnv1a(const std::string& str, const uint64_t hash) {
+            return fnv1a(str.data(), str.data() + str.size(), hash);
+        }
+
+        std::string TextureCache::makeKey(const char* begin, const char* end, const Path& path, const std::string& salt) {
+            auto hash = 0xcbf29ce484222325ull;
+            hash = fnv1a(salt, hash);
+            hash = fnv1a(path.asString("/"), hash);
+            hash = fnv1a(begin, end, hash);
+
+            // the file size makes collisions between files of different sizes impossible
+            auto str = std::stringstream();
+            str << std::hex << std::setw(16) << std::setfill('0') << hash << "-" << std::dec << static_cast<size_t>(end - begin);
+            return str.str();
+        }
+
+        template <typename T>
+        static T readLittleEndian(Reader& reader) {
+            unsigned char bytes[sizeof(T)];
+            reader.read(bytes, sizeof(T));
+
+            auto result = T(0);
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                result = static_cast<T>(result | static_cast<T>(static_cast<T>(bytes[i]) << (8u * i)));
+            }
+            return result;
+        }
+
+        static float readFloat(Reader& reader) {
+            const auto bits = readLittleEndian<uint32_t>(reader);
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        static bool isValidFormat(const GLenum format) {
+            switch (format) {
+                case GL_RGB:
+                case GL_BGR:
+                case GL_RGBA:
+                case GL_BGRA:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        static size_t maxMipCount(const size_t width, const size_t height) {
+            const auto size = std::max(width, height);
+            auto result = size_t(1);
+            while ((size >> result) > 0) {
+                ++result;
+            }
+            return result;
+        }
+
+        std::optional<Assets::Texture> TextureCache::read(const std::string& key) const {
+            try {
+                const auto file = CFile(entryPath(key));
+                auto reader = file.reader();
+
+                char magic[4];
+                reader.read(magic, sizeof(magic));
+                if (std::memcmp(magic, TextureCacheLayout::Magic, sizeof(magic)) != 0
+                    || readLittleEndian<uint32_t>(reader) != TextureCacheLayout::Version) {
+                    return std::nullopt;
+                }
+
+                const auto nameLength = size_t(readLittleEndian<uint32_t>(reader));
+                if (!reader.canRead(nameLength)) {
+                    return std::nullopt;
+                }
+
+                const auto name = reader.readString(nameLength);
+                const auto width = size_t(readLittleEndian<uint32_t>(reader));
+                const auto height = size_t(readLittleEndian<uint32_t>(reader));
+                const auto format = static_cast<GLenum>(readLittleEndian<uint32_t>(reader));
+                const auto type = readLittleEndian<uint32_t>(reader);
+                if (width == 0 || height == 0
+                    || width > TextureCacheLayout::MaxTextureSize || height > TextureCacheLayout::MaxTextureSize
+                    || !isValidFormat(format) || type > static_cast<uint32_t>(Assets::TextureType::Masked)) {
+                    return std::nullopt;
+                }
+
+                const auto r = readFloat(reader);
+                const auto g = readFloat(reader);
+                const auto b = readFloat(reader);
+                const auto a = readFloat(reader);
+
+                const auto mipCount = size_t(readLittleEndian<uint32_t>(reader));
+                if (mipCount == 0 || mipCount > maxMipCount(width, height)) {
+                    return std::nullopt;
+                }
+
+                // check that the entry contains all mip levels before allocating their buffers
+                const auto bytesPerPixel = Assets::bytesPerPixelForFormat(format);
+                auto mipSizes = std::vector<size_t>();
+                auto totalSize = size_t(0);
+                for (size_t i = 0; i < mipCount; ++i) {
+                    const auto mipSize = Assets::sizeAtMipLevel(width, height, i);
+                    mipSizes.push_back(bytesPerPixel * mipSize.x() * mipSize.y());
+                    totalSize += sizeof(uint64_t) + mipSizes.back();
+                }
+                if (!reader.canRead(totalSize)) {
+                    return std::nullopt;
+                }
+
+                auto buffers = Assets::TextureBufferList();
+                buffers.reserve(mipCount);
+                for (const auto mipSize : mipSizes) {
+                    if (readLittleEndian<uint64_t>(reader) != mipSize) {
+                        return std::nullopt;
+                    }
+                    auto& buffer = buffers.emplace_back(mipSize);
+                    reader.read(buffer.data(), mipSize);
+                }
+
+                return Assets::Texture(name, width, height, Color(r, g, b, a), std::move(buffers), format, static_cast<Assets::TextureType>(type));
+            } catch (const Exception&) {
+                // the cache does not contain the texture or its entry is truncated
+                return std::nullopt;
+            }
+        }
+
+        template <typename T>
+        static void appendLittleEndian(std::vector<char>& buffer, const T value) {
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                buffer.push_back(static_cast<char>((value >> (8u * i)) & 0xFFu));
+            }
+        }
+
+        static void appendFloat(std::vector<char>& buffer, const float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            appendLittleEndian(buffer, bits);
+        }
+
+        void TextureCache::write(const std::string& key, const Assets::Texture& texture) const {
+            const auto& buffers = texture.buffersIfUnprepared();
+            if (buffers.empty()) {
+                return;
+            }
+
+            auto data = std::vector<char>();
+            data.insert(std::end(data), std::begin(TextureCacheLayout::Magic), std::end(TextureCacheLayout::Magic));
+            appendLittleEndian(data, TextureCacheLayout::Version);
+
+            appendLittleEndian(data, static_cast<uint32_t>(texture.name().size()));
+            data.insert(std::end(data), std::begin(texture.name()), std::end(texture.name()));
+
+            appendLittleEndian(data, static_cast<uint32_t>(texture.width()));
+            appendLittleEndian(data, static_cast<uint32_t>(texture.height()));
+            appendLittleEndian(data, static_cast<uint32_t>(texture.format()));
+            appendLittleEndian(data, static_cast<uint32_t>(texture.type()));
+
+            const auto& averageColor = texture.averageColor();
+            appendFloat(data, averageColor.r());
+            appendFloat(data, averageColor.g());
+            appendFloat(data, averageColor.b());
+            appendFloat(data, averageColor.a());
+
+            appendLittleEndian(data, static_cast<uint32_t>(buffers.size()));
+            for (const auto& buffer : buffers) {
+                appendLittleEndian(data, static_cast<uint64_t>(buffer.size()));
+                data.insert(std::end(data), buffer.data(), buffer.data() + buffer.size());
+            }
+
+            const auto path = entryPath(key);
+            if (!QDir().mkpath(pathAsQString(path.deleteLastComponent()))) {
+                return;
+            }
+
+            // QSaveFile writes to a temporary file and renames it when it is committed, so that readers never see a
+            // partially written entry, even if another thread writes the same entry at the same time
+            auto file = QSaveFile(pathAsQString(path));
+            if (file.open(QIODevice::WriteOnly)) {
+                file.write(data.data(), static_cast<qint64>(data.size()));
+                if (file.commit()) {
+                    entryWritten(static_cast<uint64_t>(data.size()));
+                }
+            }
+        }
+
+        Path TextureCache::entryPath(const std::string& key) const {
+            // spread the entries over subdirectories to keep the directories small
+            return m_directory + Path(key.substr(0, 2)) + Path(key).addExtension(TextureCacheLayout::EntryExtension);
+        }
+
+        void TextureCache::entryWritten(const uint64_t entrySize) const {
+            const auto lock = std::lock_guard<std::mutex>(m_sizeMutex);
+            if (m_size.has_value()) {
+                // replacing an entry counts its size twice, which is corrected by the next eviction
+                *m_size += entrySize;
+            } else {
+                m_size = evictEntries(std::numeric_limits<uint64_t>::max());
+            }
+
+            if (*m_size > m_maxSize) {
+                m_size = evictEntries(m_maxSize / 4u * 3u);
+            }
+        }
+
+        /**
+         * Deletes the least recently written entries until the total size of the remaining entries does not exceed
+         * the given size, and returns the total size of the remaining entries.
+         */
+        uint64_t TextureCache::evictEntries(const uint64_t targetSize) const {
+            auto entries = std::vector<QFileInfo>();
+            auto size = uint64_t(0);
+
+            const auto nameFilter = QString::fromStdString("*." + TextureCacheLayout::EntryExtension);
+            QDirIterator it(pathAsQString(m_directory), QStringList(nameFilter), QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                it.next();
+                entries.push_back(it.fileInfo());
+                size += static_cast<uint64_t>(it.fileInfo().size());
+            }
+
+            if (size <= targetSize) {
+                return size;
+            }
+
+            std::sort(std::begin(entries), std::end(entries), [](const QFileInfo& lhs, const QFileInfo& rhs) {
+                return lhs.lastModified() < rhs.lastModified();
+            });
+
+            for (const auto& entry : entries) {
+                if (size <= targetSize) {
+                    break;
+                }
+                // removing an entry fails if it is being read on platforms that lock open files
+                if (QFile::remove(entry.filePath())) {
+                    size -= static_cast<uint64_t>(entry.size());
+                }
+            }
+
+            return size;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
+    namespace IO {
+        /**
+         * Stores decoded textures in a directory on disk so that they need not be decoded again when they are loaded
+         * in a later session.
+         *
+         * Textures are addressed by keys that are derived from the contents of their source files, see makeKey. The
+         * cache can be used by multiple threads at once.
+         *
+         * Entries are stored in little endian byte order. When the total size of the entries exceeds the maximum size,
+         * the oldest entries are deleted until the cache is reduced to three quarters of its maximum size.
+         */
+        class TextureCache {
+        public:
+            static const uint64_t DefaultMaxSize;
+        private:
+            Path m_directory;
+            uint64_t m_maxSize;
+
+            mutable std::mutex m_sizeMutex;
+            /**
+             * The approximate total size of the entries, computed when the first entry is written.
+             */
+            mutable std::optional<uint64_t> m_size;
+        public:
+            /**
+             * Creates a cache that stores its textures in the given directory. The directory is created when the
+             * first texture is written.
+             */
+            explicit TextureCache(const Path& directory, uint64_t maxSize = DefaultMaxSize);
+
+            const Path& directory() const;
+
+            /**
+             * Computes a key for a texture from the contents of its source file, the path of the source file, and a
+             * salt that identifies how the texture is decoded, e.g. the texture format and palette.
+             */
+            static std::string makeKey(const char* begin, const char* end, const Path& path, const std::string& salt);
+
+            /**
+             * Reads the texture with the given key. Returns an empty optional if the cache does not contain such a
+             * texture or if its cache entry cannot be read or is invalid.
+             */
+            std::optional<Assets::Texture> read(const std::string& key) const;
+
+            /**
+             * Writes the given texture to the cache. Textures without pixels are not written. Errors are ignored
+             * because a failure to write a cache entry only means that the texture is decoded again next time.
+             */
+            void write(const std::string& key, const Assets::Texture& texture) const;
+        private:
+            Path entryPath(const std::string& key) const;
+            void entryWritten(uint64_t entrySize) const;
+            uint64_t evictEntries(uint64_t targetSize) const;
+        };
+    }
+}
@@ -20,6 +20,7 @@
 #include "TextureCollectionLoader.h"
 
 #include "Logger.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
@@ -28,7 +29,15 @@
 #include "IO/TextureReader.h"
 #include "IO/WadFileSystem.h"
 
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -48,18 +57,93 @@ namespace TrenchBroom {
             return false;
         }
 
+        /**
+         * Copies the contents of the given file into memory. Files in archives share the archive's file handle, so they
+         * cannot be read by multiple threads at once. Files that are in memory already are returned as they are.
+         *
+         * Returns null if the file cannot be read.
+         */
+        static std::shared_ptr<File> readIntoMemory(const std::shared_ptr<File>& file) {
+            if (std::dynamic_pointer_cast<OwningBufferFile>(file) != nullptr || std::dynamic_pointer_cast<NonOwningBufferFile>(file) != nullptr) {
+                return file;
+            }
+
+            try {
+                const auto size = file->size();
+                auto buffer = std::make_unique<char[]>(size);
+                file->reader().read(buffer.get(), size);
+                return std::make_shared<OwningBufferFile>(file->path(), std::move(buffer), size);
+            } catch (const std::exception&) {
+                return nullptr;
+            }
+        }
+
+        std::vector<std::optional<Assets::Texture>> TextureCollectionLoader::readTextures(const size_t count, const FileOpener& openFile, const TextureReader& textureReader, const PixelLoaderFactory& makePixelLoader) {
+            auto textures = std::vector<std::optional<Assets::Texture>>(count);
+
+            const auto readTextureHeader = [&](const size_t i, const std::shared_ptr<File>& file) {
+                if (makePixelLoader) {
+                    if (auto texture = textureReader.readTextureHeader(file)) {
+                        texture->setPixelLoader(makePixelLoader(i));
+                        textures[i] = std::move(texture);
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            if (textureReader.canReadConcurrently()) {
+                // Each file is opened, read and decoded by the same worker thread and released afterwards, so only a few
+                // files are open and in memory at the same time. Only reading from the files is serialized.
+                auto fileMutex = std::mutex();
+                kdl::parallel_for(count, [&](const size_t i) {
+                    try {
+                        auto file = openFile(i);
+
+                        auto lock = std::unique_lock<std::mutex>(fileMutex);
+                        if (readTextureHeader(i, file)) {
+                            return;
+                        }
+                        file = readIntoMemory(file);
+                        lock.unlock();
+
+                        if (file != nullptr) {
+                            textures[i] = textureReader.readTextureOrThrow(file);
+                        }
+                    } catch (const std::exception&) {
+                        // the texture is read again below, which reports the error on this thread
+                    }
+                });
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                if (!textures[i]) {
+                    try {
+                        auto file = openFile(i);
+                        if (!readTextureHeader(i, file)) {
+                            textures[i] = textureReader.readTexture(file);
+                        }
+                    } catch (const std::exception& e) {
+                        m_logger.warn() << e.what();
+                    }
+                }
+            }
+
+            return textures;
+        }
+
         FileTextureCollectionLoader::FileTextureCollectionLoader(Logger& logger, const std::vector<IO::Path>& searchPaths, const std::vector<std::string>& exclusions) :
         TextureCollectionLoader(logger, exclusions),
         m_searchPaths(searchPaths) {}
 
-        Assets::TextureCollection FileTextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) {
+        Assets::TextureCollection FileTextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader, const bool loadOnDemand) {
             const auto wadPath = Disk::resolvePath(m_searchPaths, path);
             WadFileSystem wadFS(wadPath, m_logger);
 
             const auto texturePaths = wadFS.findItems(Path(""), FileExtensionMatcher(textureExtensions));
-            auto textures = std::vector<Assets::Texture>();
-            textures.reserve(texturePaths.size());
-            
+            auto files = FileList();
+            files.reserve(texturePaths.size());
+
             for (const auto& texturePath : texturePaths)  {
                 try {
                     auto file = wadFS.openFile(texturePath);
@@ -67,12 +151,29 @@ namespace TrenchBroom {
                     if (shouldExclude(name)) {
                         continue;
                     }
-                    textures.push_back(textureReader.readTexture(file));
+                    files.push_back(std::move(file));
                 } catch (const std::exception& e) {
                     m_logger.warn() << e.what();
                 }
             }
 
+            auto textures = std::vector<Assets::Texture>();
+            textures.reserve(files.size());
+
+            // the files share the WAD file's handle, which stays open for as long as any of them is alive
+            const auto openFile = [&](const size_t i) { return files[i]; };
+            auto readResults = loadOnDemand
+                ? readTextures(files.size(), openFile, *textureReader, [&](const size_t i) {
+                    return [textureReader, file = files[i]]() { return textureReader->readTexture(file); };
+                })
+                : readTextures(files.size(), openFile, *textureReader);
+
+            for (auto& texture : readResults) {
+                if (texture) {
+                    textures.push_back(std::move(*texture));
+                }
+            }
+
             return Assets::TextureCollection(path, std::move(textures));
         }
 
@@ -80,36 +181,40 @@ namespace TrenchBroom {
         TextureCollectionLoader(logger, exclusions),
         m_gameFS(gameFS) {}
 
-        Assets::TextureCollection DirectoryTextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) {
-            const auto texturePaths = m_gameFS.findItems(path, FileExtensionMatcher(textureExtensions));
+        Assets::TextureCollection DirectoryTextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader, const bool loadOnDemand) {
+            auto texturePaths = m_gameFS.findItems(path, FileExtensionMatcher(textureExtensions));
+            texturePaths = kdl::vec_erase_if(std::move(texturePaths), [&](const Path& texturePath) {
+                return shouldExclude(texturePath.lastComponent().deleteExtension().asString());
+            });
+
+            // The files are opened while their textures are read and closed right afterwards. When loading on demand,
+            // only the headers are read, and the files are opened again when their pixels are needed.
+            const auto openFile = [&](const size_t i) { return m_gameFS.openFile(texturePaths[i]); };
+            auto readResults = loadOnDemand
+                ? readTextures(texturePaths.size(), openFile, *textureReader, [&](const size_t i) {
+                    return [textureReader, &gameFS = m_gameFS, path = texturePaths[i]]() { return textureReader->readTexture(gameFS.openFile(path)); };
+                })
+                : readTextures(texturePaths.size(), openFile, *textureReader);
+
             auto textures = std::vector<Assets::Texture>();
             textures.reserve(texturePaths.size());
 
-            for (const auto& texturePath : texturePaths) {
-                try {
-                    auto file = m_gameFS.openFile(texturePath);
-
+            for (size_t i = 0; i < readResults.size(); ++i) {
+                if (auto& texture = readResults[i]) {
                     // Store the absolute path to the original file (may be used by .obj export)
                     IO::Path absolutePath;
                     try {
-                        absolutePath = m_gameFS.makeAbsolute(texturePath);
+                        absolutePath = m_gameFS.makeAbsolute(texturePaths[i]);
                     } catch (const FileSystemException& e) {
                         m_logger.debug() << e.what();
                     }
 
-                    const auto name = file->path().lastComponent().deleteExtension().asString();
-                    if (shouldExclude(name)) {
-                        continue;
-                    }
-                    auto texture = textureReader.readTexture(file);
-                    texture.setAbsolutePath(absolutePath);
-                    texture.setRelativePath(texturePath);
-                    textures.push_back(std::move(texture));
-                } catch (const std::exception& e) {
-                    m_logger.warn() << e.what();
+                    texture->setAbsolutePath(absolutePath);
+                    texture->setRelativePath(texturePaths[i]);
+                    textures.push_back(std::move(*texture));
                 }
             }
-            
+
             return Assets::TextureCollection(path, std::move(textures));
         }
     }
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <string>
@@ -28,6 +30,7 @@ namespace TrenchBroom {
     class Logger;
 
     namespace Assets {
+        class Texture;
         class TextureCollection;
     }
 
@@ -40,6 +43,8 @@ namespace TrenchBroom {
         class TextureCollectionLoader {
         protected:
             using FileList = std::vector<std::shared_ptr<File>>;
+            using FileOpener = std::function<std::shared_ptr<File>(size_t index)>;
+            using PixelLoaderFactory = std::function<std::function<Assets::Texture()>(size_t index)>;
         protected:
             Logger& m_logger;
             const std::vector<std::string> m_textureExclusions;
@@ -48,9 +53,23 @@ namespace TrenchBroom {
         public:
             virtual ~TextureCollectionLoader();
         public:
-            virtual Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) = 0;
+            virtual Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader, bool loadOnDemand) = 0;
         protected:
             bool shouldExclude(const std::string& textureName);
+
+            /**
+             * Reads the textures from the files returned by openFile(0) to openFile(count - 1). If the given reader
+             * supports it, the files are opened and the textures are read by one set of worker threads, but errors are
+             * logged on the calling thread. Each file is released once its texture has been read.
+             *
+             * If makePixelLoader is given, only the headers of the textures are read and decoding their pixels is
+             * deferred until the textures are used. The pixels of the texture at index i are decoded by the function
+             * returned by makePixelLoader(i). Textures whose headers cannot be read are read eagerly.
+             *
+             * @return the textures in the order of the files, or an empty optional for each texture that could not be
+             * read
+             */
+            std::vector<std::optional<Assets::Texture>> readTextures(size_t count, const FileOpener& openFile, const TextureReader& textureReader, const PixelLoaderFactory& makePixelLoader = PixelLoaderFactory());
         };
 
         class FileTextureCollectionLoader : public TextureCollectionLoader {
@@ -59,7 +78,7 @@ namespace TrenchBroom {
         public:
             FileTextureCollectionLoader(Logger& logger, const std::vector<Path>& searchPaths, const std::vector<std::string>& exclusions);
         private:
-            Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader);
+            Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader, bool loadOnDemand);
         };
 
         class DirectoryTextureCollectionLoader : public TextureCollectionLoader {
@@ -68,7 +87,7 @@ namespace TrenchBroom {
         public:
             DirectoryTextureCollectionLoader(Logger& logger, const FileSystem& gameFS, const std::vector<std::string>& exclusions);
         private:
-            Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader);
+            Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, std::shared_ptr<const TextureReader> textureReader, bool loadOnDemand);
         };
     }
 }
@@ -24,12 +24,16 @@
 #include "Assets/Palette.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "IO/CachingTextureReader.h"
+#include "IO/File.h"
 #include "IO/FileSystem.h"
 #include "IO/FreeImageTextureReader.h"
 #include "IO/HlMipTextureReader.h"
 #include "IO/IdMipTextureReader.h"
 #include "IO/M8TextureReader.h"
 #include "IO/Quake3ShaderTextureReader.h"
+#include "IO/Reader.h"
+#include "IO/TextureCache.h"
 #include "IO/TextureCollectionLoader.h"
 #include "IO/WalTextureReader.h"
 #include "IO/Path.h"
@@ -40,9 +44,9 @@
 
 namespace TrenchBroom {
     namespace IO {
-        TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger) :
+        TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache) :
         m_textureExtensions(getTextureExtensions(textureConfig)),
-        m_textureReader(createTextureReader(gameFS, textureConfig, logger)),
+        m_textureReader(createTextureReader(gameFS, textureConfig, logger, std::move(textureCache))),
         m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, logger)) {
             ensure(m_textureReader != nullptr, "textureReader is null");
             ensure(m_textureCollectionLoader != nullptr, "textureCollectionLoader is null");
@@ -54,22 +58,34 @@ namespace TrenchBroom {
             return textureConfig.format.extensions;
         }
 
-        std::unique_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger) {
+        /**
+         * Only textures decoded by FreeImage are cached. The paletted formats only need a palette lookup per pixel, so
+         * caching them would cost disk space without saving any noticeable time.
+         */
+        static std::shared_ptr<TextureReader> withTextureCache(std::shared_ptr<TextureReader> textureReader, const TextureReader::NameStrategy& nameStrategy, const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache) {
+            if (textureCache == nullptr) {
+                return textureReader;
+            }
+            return std::make_shared<CachingTextureReader>(nameStrategy, gameFS, logger, std::move(textureReader), std::move(textureCache), textureConfig.format.format);
+        }
+
+        std::shared_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache) {
             const auto prefixLength = textureConfig.package.rootDirectory.length();
             const TextureReader::PathSuffixNameStrategy nameStrategy(prefixLength);
             
             if (textureConfig.format.format == "idmip") {
-                return std::make_unique<IdMipTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
+                return std::make_shared<IdMipTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
             } else if (textureConfig.format.format == "hlmip") {
-                return std::make_unique<HlMipTextureReader>(nameStrategy, gameFS, logger);
+                return std::make_shared<HlMipTextureReader>(nameStrategy, gameFS, logger);
             } else if (textureConfig.format.format == "wal") {
-                return std::make_unique<WalTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
+                return std::make_shared<WalTextureReader>(nameStrategy, gameFS, logger, loadPalette(gameFS, textureConfig, logger));
             } else if (textureConfig.format.format == "image") {
-                return std::make_unique<FreeImageTextureReader>(nameStrategy, gameFS, logger);
+                return withTextureCache(std::make_shared<FreeImageTextureReader>(nameStrategy, gameFS, logger), nameStrategy, gameFS, textureConfig, logger, std::move(textureCache));
             } else if (textureConfig.format.format == "q3shader") {
-                return std::make_unique<Quake3ShaderTextureReader>(nameStrategy, gameFS, logger);
+                // shaders are not cached because they are parsed already, but their images are
+                return std::make_shared<Quake3ShaderTextureReader>(nameStrategy, gameFS, logger, std::move(textureCache));
             } else if (textureConfig.format.format == "m8") {
-                return std::make_unique<M8TextureReader>(nameStrategy, gameFS, logger);
+                return std::make_shared<M8TextureReader>(nameStrategy, gameFS, logger);
             } else {
                 throw GameException("Unknown texture format '" + textureConfig.format.format + "'");
             }
@@ -103,8 +119,8 @@ namespace TrenchBroom {
             }
         }
 
-        Assets::TextureCollection TextureLoader::loadTextureCollection(const Path& path) {
-            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
+        Assets::TextureCollection TextureLoader::loadTextureCollection(const Path& path, const bool loadOnDemand) {
+            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, m_textureReader, loadOnDemand);
         }
 
         void TextureLoader::loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager) {
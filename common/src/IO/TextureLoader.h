@@ -41,24 +41,29 @@ namespace TrenchBroom {
     namespace IO {
         class FileSystem;
         class Path;
+        class TextureCache;
         class TextureCollectionLoader;
         class TextureReader;
 
         class TextureLoader {
         private:
             std::vector<std::string> m_textureExtensions;
-            std::unique_ptr<TextureReader> m_textureReader;
+            std::shared_ptr<TextureReader> m_textureReader;
             std::unique_ptr<TextureCollectionLoader> m_textureCollectionLoader;
         public:
-            TextureLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger);
+            /**
+             * Creates a new texture loader. If a texture cache is given, image textures are looked up in the cache
+             * before they are decoded.
+             */
+            TextureLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache = nullptr);
             ~TextureLoader();
         private:
             static std::vector<std::string> getTextureExtensions(const Model::TextureConfig& textureConfig);
-            static std::unique_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger);
+            static std::shared_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger, std::shared_ptr<const TextureCache> textureCache);
             static Assets::Palette loadPalette(const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger);
             static std::unique_ptr<TextureCollectionLoader> createTextureCollectionLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger);
         public:
-            Assets::TextureCollection loadTextureCollection(const Path& path);
+            Assets::TextureCollection loadTextureCollection(const Path& path, bool loadOnDemand = false);
             void loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager);
 
             deleteCopyAndMove(TextureLoader)
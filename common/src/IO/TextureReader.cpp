@@ -96,6 +96,30 @@ namespace TrenchBroom {
             }
         }
 
+        Assets::Texture TextureReader::readTextureOrThrow(std::shared_ptr<File> file) const {
+            return doReadTexture(file);
+        }
+
+        std::optional<Assets::Texture> TextureReader::readTextureHeader(std::shared_ptr<File> file) const {
+            try {
+                return doReadTextureHeader(file);
+            } catch (const Exception&) {
+                return std::nullopt;
+            }
+        }
+
+        bool TextureReader::canReadConcurrently() const {
+            return doCanReadConcurrently();
+        }
+
+        std::optional<Assets::Texture> TextureReader::doReadTextureHeader(std::shared_ptr<File> /* file */) const {
+            return std::nullopt;
+        }
+
+        bool TextureReader::doCanReadConcurrently() const {
+            return true;
+        }
+
         std::string TextureReader::textureName(const std::string& textureName, const Path& path) const {
             return m_nameStrategy->textureName(textureName, path);
         }
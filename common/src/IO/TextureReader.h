@@ -22,6 +22,7 @@
 #include "Macros.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace TrenchBroom {
@@ -118,6 +119,35 @@ namespace TrenchBroom {
              * @return an Assets::Texture object
              */
             Assets::Texture readTexture(std::shared_ptr<File> file) const;
+
+            /**
+             * Loads a texture from the given file and returns it. Unlike readTexture, this method neither logs errors
+             * nor falls back to the default texture, so it can be called from worker threads if this reader can read
+             * concurrently.
+             *
+             * @param file the file containing the texture
+             * @return an Assets::Texture object
+             *
+             * @throw AssetException if the texture cannot be read
+             */
+            Assets::Texture readTextureOrThrow(std::shared_ptr<File> file) const;
+
+            /**
+             * Reads the name and the size of the texture in the given file, but not its pixels. Returns an empty
+             * optional if this reader cannot determine the size of a texture without reading all of its pixels, or if
+             * the texture cannot be read.
+             *
+             * @param file the file containing the texture
+             * @return an Assets::Texture object without pixels
+             */
+            std::optional<Assets::Texture> readTextureHeader(std::shared_ptr<File> file) const;
+
+            /**
+             * Indicates whether this reader can read textures from multiple threads at once, provided that the given
+             * files are held in memory. This is not the case for readers that open other files while reading a
+             * texture.
+             */
+            bool canReadConcurrently() const;
         protected:
             std::string textureName(const std::string& textureName, const Path& path) const;
             std::string textureName(const Path& path) const;
@@ -130,6 +160,8 @@ namespace TrenchBroom {
              * @return an Assets::Texture object
              */
             virtual Assets::Texture doReadTexture(std::shared_ptr<File> file) const = 0;
+            virtual std::optional<Assets::Texture> doReadTextureHeader(std::shared_ptr<File> file) const;
+            virtual bool doCanReadConcurrently() const;
         protected:
             static bool checkTextureDimensions(size_t width, size_t height);
         public:
@@ -29,27 +29,49 @@ namespace TrenchBroom {
     namespace IO {
         // ZipFileSystem::ZipCompressedFile
 
-        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(ZipFileSystem* owner, const mz_uint fileIndex) :
+        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(ZipFileSystem* owner, const mz_uint fileIndex, Path path, const mz_zip_archive_file_stat& stat) :
         m_owner(owner),
-        m_fileIndex(fileIndex) {}
+        m_fileIndex(fileIndex),
+        m_path(std::move(path)),
+        m_method(stat.m_method),
+        m_compressedSize(static_cast<size_t>(stat.m_comp_size)),
+        m_uncompressedSize(static_cast<size_t>(stat.m_uncomp_size)),
+        m_crc32(stat.m_crc32) {}
 
         std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::doOpen() const {
-            const auto path = Path(m_owner->filename(m_fileIndex));
+            auto data = std::make_unique<char[]>(m_uncompressedSize);
+
+            if (m_uncompressedSize > 0u) {
+                if (m_method == 0) {
+                    // the entry is stored without compression
+                    readCompressedData(data.get());
+                } else if (m_method == MZ_DEFLATED) {
+                    auto compressedData = std::make_unique<char[]>(m_compressedSize);
+                    readCompressedData(compressedData.get());
+
+                    // inflating does not access the archive, so several entries can be inflated at once
+                    const auto size = tinfl_decompress_mem_to_mem(data.get(), m_uncompressedSize, compressedData.get(), m_compressedSize, 0);
+                    if (size != m_uncompressedSize) {
+                        throw FileSystemException("tinfl_decompress_mem_to_mem failed for " + m_path.asString());
+                    }
+                } else {
+                    throw FileSystemException("Unsupported compression method for " + m_path.asString());
+                }
 
-            mz_zip_archive_file_stat stat;
-            if (!mz_zip_reader_file_stat(&m_owner->m_archive, m_fileIndex, &stat)) {
-                throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+                const auto checksum = mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(data.get()), m_uncompressedSize);
+                if (checksum != m_crc32) {
+                    throw FileSystemException("CRC check failed for " + m_path.asString());
+                }
             }
 
-            const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-            auto data = std::make_unique<char[]>(uncompressedSize);
-            auto* begin = data.get();
+            return std::make_shared<OwningBufferFile>(m_path, std::move(data), m_uncompressedSize);
+        }
 
-            if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, begin, uncompressedSize, 0)) {
-                throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + path.asString());
+        void ZipFileSystem::ZipCompressedFile::readCompressedData(char* buffer) const {
+            const auto lock = std::lock_guard<std::mutex>(m_owner->m_archiveMutex);
+            if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, buffer, m_compressedSize, MZ_ZIP_FLAG_COMPRESSED_DATA)) {
+                throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + m_path.asString());
             }
-
-            return std::make_shared<OwningBufferFile>(path, std::move(data), uncompressedSize);
         }
 
         // ZipFileSystem
@@ -74,10 +96,12 @@ namespace TrenchBroom {
             }
 
             const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
+            mz_zip_archive_file_stat stat;
             for (mz_uint i = 0; i < numFiles; ++i) {
-                if (!mz_zip_reader_is_file_a_directory(&m_archive, i)) {
-                    const auto path = Path(filename(i));
-                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
+                // the stat contains the file name, so it need not be fetched separately
+                if (mz_zip_reader_file_stat(&m_archive, i, &stat) && !stat.m_is_directory) {
+                    auto path = Path(stat.m_filename);
+                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i, path, stat));
                 }
             }
 
@@ -86,24 +110,5 @@ namespace TrenchBroom {
                 throw FileSystemException(std::string("Error while reading compressed file: ") + mz_zip_get_error_string(err));
             }
         }
-
-        /**
-         * Helper to get the filename of a file in the zip archive
-         */
-        std::string ZipFileSystem::filename(const mz_uint fileIndex) {
-            // nameLen includes space for the null-terminator byte
-            const mz_uint nameLen = mz_zip_reader_get_filename(&m_archive, fileIndex, nullptr, 0);
-            if (nameLen == 0) {
-                return "";
-            }
-
-            std::string result;
-            result.resize(static_cast<size_t>(nameLen - 1));
-
-            // NOTE: this will overwrite the std::string's null terminator, which is permitted in C++17 and later
-            mz_zip_reader_get_filename(&m_archive, fileIndex, result.data(), nameLen);
-
-            return result;
-        }
     }
 }
@@ -20,27 +20,40 @@
 #pragma once
 
 #include "IO/ImageFileSystem.h"
+#include "IO/Path.h"
 
 #include <memory>
+#include <mutex>
 
 #include <miniz/miniz.h>
 
 namespace TrenchBroom {
     namespace IO {
-        class Path;
-
         class ZipFileSystem : public ImageFileSystem {
         private:
             mz_zip_archive m_archive;
+            // miniz reads the archive through a single file handle, so reading entries must be serialized
+            std::mutex m_archiveMutex;
         private:
             class ZipCompressedFile : public FileEntry {
             private:
                 ZipFileSystem* m_owner;
                 mz_uint m_fileIndex;
+                Path m_path;
+                mz_uint16 m_method;
+                size_t m_compressedSize;
+                size_t m_uncompressedSize;
+                mz_uint32 m_crc32;
             public:
-                ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
+                ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex, Path path, const mz_zip_archive_file_stat& stat);
             private:
                 std::shared_ptr<File> doOpen() const override;
+
+                /**
+                 * Reads the data of this entry as it is stored in the archive into the given buffer, which must have
+                 * room for the compressed size of this entry.
+                 */
+                void readCompressedData(char* buffer) const;
             };
             friend class ZipCompressedFile;
         public:
@@ -49,8 +62,6 @@ namespace TrenchBroom {
             ~ZipFileSystem() override;
         private:
             void doReadDirectory() override;
-        private:
-            std::string filename(mz_uint fileIndex);
         };
     }
 }
@@ -49,12 +49,14 @@
 #include <vecmath/vec_ext.h>
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
+#include <vecmath/plane.h>
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 #include <vecmath/util.h>
 
 #include <algorithm> // for std::remove
 #include <iterator>
+#include <limits>
 #include <set>
 #include <string>
 #include <vector>
@@ -208,13 +210,50 @@ namespace TrenchBroom {
         }
 
         std::optional<std::tuple<FloatType, size_t>> BrushNode::findFaceHit(const vm::ray3& ray) const {
-            if (!vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds()))) {
-                for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
-                    const auto& face = m_brush.face(i);
-                    const auto distance = face.intersectWithRay(ray);
-                    if (!vm::is_nan(distance)) {
-                        return std::make_tuple(distance, i);
+            if (vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds()))) {
+                return std::nullopt;
+            }
+
+            // A brush is the intersection of the half spaces below its face planes, so the ray misses the brush if it
+            // leaves one of these half spaces before it has entered all of them. This takes only one dot product per
+            // face, and if the ray hits the brush, it usually hits the face whose plane it enters last.
+            const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+            auto enterDistance = std::numeric_limits<FloatType>::lowest();
+            auto exitDistance = std::numeric_limits<FloatType>::max();
+            auto enterFaceIndex = m_brush.faceCount();
+            for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
+                const auto& plane = m_brush.face(i).boundary();
+                const auto cos = vm::dot(plane.normal, ray.direction);
+                const auto distance = plane.point_distance(ray.origin);
+                if (cos < FloatType(0.0)) {
+                    if (-distance / cos > enterDistance) {
+                        enterDistance = -distance / cos;
+                        enterFaceIndex = i;
                     }
+                } else if (cos > FloatType(0.0)) {
+                    exitDistance = vm::min(exitDistance, -distance / cos);
+                } else if (distance > epsilon) {
+                    return std::nullopt;
+                }
+            }
+
+            if (enterDistance > exitDistance + epsilon) {
+                return std::nullopt;
+            }
+
+            if (enterFaceIndex < m_brush.faceCount()) {
+                const auto distance = m_brush.face(enterFaceIndex).intersectWithRay(ray);
+                if (!vm::is_nan(distance)) {
+                    return std::make_tuple(distance, enterFaceIndex);
+                }
+            }
+
+            // the ray may hit an edge or a vertex of the brush, so all faces are tested
+            for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
+                const auto& face = m_brush.face(i);
+                const auto distance = face.intersectWithRay(ray);
+                if (!vm::is_nan(distance)) {
+                    return std::make_tuple(distance, i);
                 }
             }
             return std::nullopt;
@@ -71,6 +71,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyPropertyKeyIssueQuickFix());
         }
 
+        bool EmptyPropertyKeyIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void EmptyPropertyKeyIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             if (node->entity().hasProperty(""))
                 issues.push_back(new EmptyPropertyKeyIssue(node));
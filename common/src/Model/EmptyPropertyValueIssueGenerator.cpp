@@ -82,6 +82,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyPropertyValueIssueQuickFix());
         }
 
+        bool EmptyPropertyValueIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void EmptyPropertyValueIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             for (const EntityProperty& property : node->entity().properties()) {
                 if (property.value().empty())
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             EmptyPropertyValueIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNodeBase* node, IssueList& issues) const override;
         };
     }
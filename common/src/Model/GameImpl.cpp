@@ -26,6 +26,7 @@
 #include "Assets/Palette.h"
 #include "Assets/EntityModel.h"
 #include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/TextureManager.h"
 #include "IO/AseParser.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/Bsp29Parser.h"
@@ -49,6 +50,7 @@
 #include "IO/ObjSerializer.h"
 #include "IO/WorldReader.h"
 #include "IO/SimpleParserStatus.h"
+#include "IO/SkinCache.h"
 #include "IO/SystemPaths.h"
 #include "IO/TextureLoader.h"
 #include "Model/BrushBuilder.h"
@@ -78,12 +80,14 @@ namespace TrenchBroom {
     namespace Model {
         GameImpl::GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger) :
         m_config(config),
-        m_gamePath(gamePath) {
+        m_gamePath(gamePath),
+        m_skinCache(std::make_shared<IO::SkinCache>()) {
             initializeFileSystem(logger);
         }
 
         void GameImpl::initializeFileSystem(Logger& logger) {
             m_fs.initialize(m_config, m_gamePath, m_additionalSearchPaths, logger);
+            m_skinCache->clear();
         }
 
         const std::string& GameImpl::doGameName() const {
@@ -253,7 +257,7 @@ namespace TrenchBroom {
             const auto paths = extractTextureCollections(entity);
 
             const auto fileSearchPaths = textureCollectionSearchPaths(documentPath);
-            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger);
+            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger, textureManager.textureCache());
             textureLoader.loadTextures(paths, textureManager);
         }
 
@@ -326,6 +330,7 @@ namespace TrenchBroom {
 
         void GameImpl::doReloadShaders() {
             m_fs.reloadShaders();
+            m_skinCache->clear();
         }
 
         bool GameImpl::doIsEntityDefinitionFile(const IO::Path& path) const {
@@ -431,15 +436,15 @@ namespace TrenchBroom {
                 } else if (extension == "md2" && kdl::vec_contains(supported, "md2")) {
                     const auto palette = loadTexturePalette();
                     auto reader = file->reader().buffer();
-                    IO::Md2Parser parser(modelName, std::begin(reader), std::end(reader), palette, m_fs);
+                    IO::Md2Parser parser(modelName, std::begin(reader), std::end(reader), palette, m_fs, m_skinCache);
                     return parser.initializeModel(logger);
                 } else if (extension == "md3" && kdl::vec_contains(supported, "md3")) {
                     auto reader = file->reader().buffer();
-                    IO::Md3Parser parser(modelName, std::begin(reader), std::end(reader), m_fs);
+                    IO::Md3Parser parser(modelName, std::begin(reader), std::end(reader), m_fs, m_skinCache);
                     return parser.initializeModel(logger);
                 } else if (extension == "mdx" && kdl::vec_contains(supported, "mdx")) {
                     auto reader = file->reader().buffer();
-                    IO::MdxParser parser(modelName, std::begin(reader), std::end(reader), m_fs);
+                    IO::MdxParser parser(modelName, std::begin(reader), std::end(reader), m_fs, m_skinCache);
                     return parser.initializeModel(logger);
                 } else if (extension == "bsp" && kdl::vec_contains(supported, "bsp")) {
                     const auto palette = loadTexturePalette();
@@ -448,7 +453,7 @@ namespace TrenchBroom {
                     return parser.initializeModel(logger);
                 } else if (extension == "dkm" && kdl::vec_contains(supported, "dkm")) {
                     auto reader = file->reader().buffer();
-                    IO::DkmParser parser(modelName, std::begin(reader), std::end(reader), m_fs);
+                    IO::DkmParser parser(modelName, std::begin(reader), std::end(reader), m_fs, m_skinCache);
                     return parser.initializeModel(logger);
                 } else if (extension == "ase" && kdl::vec_contains(supported, "ase")) {
                     auto reader = file->reader().buffer();
@@ -36,6 +36,10 @@ namespace TrenchBroom {
         class Palette;
     }
 
+    namespace IO {
+        class SkinCache;
+    }
+
     namespace Model {
         class GameImpl : public Game {
         private:
@@ -43,6 +47,8 @@ namespace TrenchBroom {
             GameFileSystem m_fs;
             IO::Path m_gamePath;
             std::vector<IO::Path> m_additionalSearchPaths;
+            // shares the skins of entity models, must be cleared whenever the file system changes
+            std::shared_ptr<IO::SkinCache> m_skinCache;
         public:
             GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger);
         private:
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             InvalidTextureScaleIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(BrushNode* brushNode, IssueList& issues) const override;
         };
     }
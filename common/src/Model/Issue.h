@@ -54,6 +54,14 @@ namespace TrenchBroom {
             explicit Issue(Node* node);
             static size_t nextSeqId();
             static IssueType freeType();
+        private:
+            friend class Node;
+
+            /**
+             * Assigns a new sequence ID to this issue. Used to give issues that were generated in parallel the
+             * sequence IDs they would have received if they were generated sequentially.
+             */
+            void renumber();
         private: // subclassing interface
             virtual size_t doGetLineNumber() const;
             virtual IssueType doGetType() const = 0;
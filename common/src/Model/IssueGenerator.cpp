@@ -47,6 +47,10 @@ namespace TrenchBroom {
             return m_quickFixes;
         }
 
+        bool IssueGenerator::threadSafe() const {
+            return doIsThreadSafe();
+        }
+
         void IssueGenerator::generate(WorldNode* worldNode, IssueList& issues) const {
             doGenerate(worldNode, issues);
         }
@@ -77,6 +81,10 @@ namespace TrenchBroom {
             m_quickFixes.push_back(quickFix);
         }
  
+        bool IssueGenerator::doIsThreadSafe() const {
+            return false;
+        }
+
         void IssueGenerator::doGenerate(WorldNode* worldNode,   IssueList& issues) const { doGenerate(static_cast<EntityNodeBase*>(worldNode), issues); }
         void IssueGenerator::doGenerate(LayerNode*,             IssueList&) const        {}
         void IssueGenerator::doGenerate(GroupNode*,             IssueList&) const        {}
@@ -62,6 +62,10 @@ namespace TrenchBroom {
             addQuickFix(new RemoveEntityPropertiesQuickFix(LongPropertyKeyIssue::Type));
         }
 
+        bool LongPropertyKeyIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LongPropertyKeyIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             for (const EntityProperty& property : node->entity().properties()) {
                 const std::string& propertyKey = property.key();
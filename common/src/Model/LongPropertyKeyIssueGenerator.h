@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             LongPropertyKeyIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNodeBase* node, IssueList& issues) const override;
         };
     }
@@ -89,6 +89,10 @@ namespace TrenchBroom {
             addQuickFix(new TruncateLongPropertyValueIssueQuickFix(m_maxLength));
         }
 
+        bool LongPropertyValueIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LongPropertyValueIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             for (const EntityProperty& property : node->entity().properties()) {
                 const auto& propertyKey = property.key();
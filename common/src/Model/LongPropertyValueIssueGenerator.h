@@ -34,6 +34,7 @@ namespace TrenchBroom {
         public:
             LongPropertyValueIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNodeBase* node, IssueList& issues) const override;
         };
     }
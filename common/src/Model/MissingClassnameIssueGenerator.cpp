@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new MissingClassnameIssueQuickFix());
         }
 
+        bool MissingClassnameIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void MissingClassnameIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             if (!node->entity().hasProperty(PropertyKeys::Classname))
                 issues.push_back(new MissingClassnameIssue(node));
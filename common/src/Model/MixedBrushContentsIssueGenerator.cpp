@@ -52,6 +52,10 @@ namespace TrenchBroom {
         MixedBrushContentsIssueGenerator::MixedBrushContentsIssueGenerator() :
         IssueGenerator(MixedBrushContentsIssue::Type, "Mixed brush content flags") {}
 
+        bool MixedBrushContentsIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void MixedBrushContentsIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
             const Brush& brush = brushNode->brush();
             const auto& faces = brush.faces();
@@ -31,6 +31,7 @@ namespace TrenchBroom {
         public:
             MixedBrushContentsIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(BrushNode* brushNode, IssueList& issues) const override;
         };
     }
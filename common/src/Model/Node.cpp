@@ -26,6 +26,7 @@
 #include "Model/LockState.h"
 #include "Model/VisibilityState.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox.h>
@@ -602,6 +603,10 @@ namespace TrenchBroom {
             return m_issues;
         }
 
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
@@ -623,6 +628,41 @@ namespace TrenchBroom {
             }
         }
 
+        void Node::validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators) {
+            const auto dirtyNodes = kdl::vec_filter(nodes, [](const Node* node) { return !node->m_issuesValid; });
+
+            // issues[i][j] contains the issues generated for dirtyNodes[i] by issueGenerators[j]
+            auto issues = std::vector<std::vector<std::vector<Issue*>>>(dirtyNodes.size(), std::vector<std::vector<Issue*>>(issueGenerators.size()));
+            const auto generateIssues = [&](const size_t i, const bool threadSafe) {
+                for (size_t j = 0u; j < issueGenerators.size(); ++j) {
+                    if (issueGenerators[j]->threadSafe() == threadSafe) {
+                        dirtyNodes[i]->doGenerateIssues(issueGenerators[j], issues[i][j]);
+                    }
+                }
+            };
+
+            kdl::parallel_for_large(dirtyNodes.size(), [&](const size_t i) {
+                generateIssues(i, true);
+            });
+
+            for (size_t i = 0u; i < dirtyNodes.size(); ++i) {
+                generateIssues(i, false);
+            }
+
+            // merge the issues in node and generator order and renumber them so that the result does not depend on how
+            // the work was scheduled
+            for (size_t i = 0u; i < dirtyNodes.size(); ++i) {
+                auto* node = dirtyNodes[i];
+                for (auto& generatorIssues : issues[i]) {
+                    for (auto* issue : generatorIssues) {
+                        issue->renumber();
+                        node->m_issues.push_back(issue);
+                    }
+                }
+                node->m_issuesValid = true;
+            }
+        }
+
         void Node::invalidateIssues() const {
             clearIssues();
             m_issuesValid = false;
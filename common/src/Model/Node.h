@@ -295,6 +295,22 @@ namespace TrenchBroom {
         public: // issue management
             const std::vector<Issue*>& issues(const std::vector<IssueGenerator*>& issueGenerators);
 
+            /**
+             * Indicates whether this node's issues are up to date. If not, the next call to issues() will run the
+             * issue generators on this node.
+             */
+            bool issuesValid() const;
+
+            /**
+             * Validates the issues of all of the given nodes whose issues are not valid. Thread safe generators are run
+             * on several nodes in parallel, the remaining generators are run sequentially afterwards. The resulting
+             * issues are ordered and numbered as if the nodes had been validated one after another in the given order.
+             *
+             * @param nodes the nodes to validate, must not contain duplicates
+             * @param issueGenerators the issue generators to run
+             */
+            static void validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators);
+
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
         public: // should only be called from this and from the world
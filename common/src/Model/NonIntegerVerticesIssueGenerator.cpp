@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new NonIntegerVerticesIssueQuickFix());
         }
 
+        bool NonIntegerVerticesIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void NonIntegerVerticesIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
             const Brush& brush = brushNode->brush();
             for (const BrushVertex* vertex : brush.vertices()) {
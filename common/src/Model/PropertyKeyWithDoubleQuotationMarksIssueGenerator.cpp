@@ -67,6 +67,10 @@ namespace TrenchBroom {
                                                               [] (const std::string& value) { return value; }));
         }
 
+        bool PropertyKeyWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void PropertyKeyWithDoubleQuotationMarksIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             for (const EntityProperty& property : node->entity().properties()) {
                 const std::string& propertyKey = property.key();
@@ -67,6 +67,10 @@ namespace TrenchBroom {
                                                               [] (const std::string& value) { return kdl::str_replace_every(value, "\"", "'"); }));
         }
 
+        bool PropertyValueWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void PropertyValueWithDoubleQuotationMarksIssueGenerator::doGenerate(EntityNodeBase* node, IssueList& issues) const {
             for (const EntityProperty& property : node->entity().properties()) {
                 const std::string& propertyKey = property.key();
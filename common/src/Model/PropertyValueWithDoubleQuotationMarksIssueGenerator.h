@@ -31,6 +31,7 @@ namespace TrenchBroom {
         public:
             PropertyValueWithDoubleQuotationMarksIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNodeBase* node, IssueList& issues) const override;
         };
     }
@@ -26,10 +26,13 @@
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
+#include "Model/Hit.h"
+#include "Model/HitFilter.h"
 #include "Model/IssueGenerator.h"
 #include "Model/IssueGeneratorRegistry.h"
 #include "Model/LayerNode.h"
 #include "Model/ModelFactoryImpl.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 
 #include <kdl/overload.h>
@@ -37,6 +40,8 @@
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox_io.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
 
 #include <sstream>
 #include <string>
@@ -181,6 +186,37 @@ namespace TrenchBroom {
             m_nodeTree->clearAndBuild(nodes, [](const auto* node){ return node->physicalBounds(); });
         }
 
+        void WorldNode::pickNearest(const vm::ray3& ray, const FloatType maxDistance, const HitFilter& filter, PickResult& pickResult) {
+            auto closestDistance = maxDistance;
+            m_nodeTree->findIntersectorsByDistance(ray, [&](Node* node, const FloatType distance) {
+                // allow for hits at the same distance as the closest hit, see HitQuery::first
+                if (distance > closestDistance + vm::C::almost_zero()) {
+                    return false;
+                }
+
+                node->pick(ray, pickResult);
+
+                // the hits are sorted by distance, so the first matching hit is the closest one
+                for (const auto& hit : pickResult.all()) {
+                    if (hit.distance() > closestDistance) {
+                        break;
+                    } else if (filter.matches(hit)) {
+                        closestDistance = hit.distance();
+                        break;
+                    }
+                }
+                return true;
+            });
+        }
+
+        void WorldNode::pickNearest(const std::vector<vm::ray3>& rays, const FloatType maxDistance, const HitFilter& filter, std::vector<PickResult>& pickResults) {
+            ensure(pickResults.size() == rays.size(), "one pick result per ray");
+
+            for (size_t i = 0u; i < rays.size(); ++i) {
+                pickNearest(rays[i], maxDistance, filter, pickResults[i]);
+            }
+        }
+
         void WorldNode::invalidateAllIssues() {
             accept([](auto&& thisLambda, Node* node) {
                 node->invalidateIssues();
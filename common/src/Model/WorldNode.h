@@ -39,6 +39,7 @@ namespace TrenchBroom {
         class EntityNodeIndex;
         enum class BrushError;
         class BrushFace;
+        class HitFilter;
         class IssueGeneratorRegistry;
         class IssueQuickFix;
         class PickResult;
@@ -114,6 +115,37 @@ namespace TrenchBroom {
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+        public: // picking
+            /**
+             * Picks the nodes of this world with the given ray, but stops as soon as no node can yield a hit that is
+             * closer than the closest hit matched by the given filter or the given maximum distance.
+             *
+             * Nodes are visited in order of increasing distance of their bounds along the given ray, so the resulting
+             * pick result contains every hit that is at most as far away as the closest matching hit. Hits that are
+             * further away may or may not be contained.
+             *
+             * @param ray the pick ray
+             * @param maxDistance the maximum distance of interest
+             * @param filter the filter that determines which hits terminate the search
+             * @param pickResult the pick result to add the hits to
+             */
+            void pickNearest(const vm::ray3& ray, FloatType maxDistance, const HitFilter& filter, PickResult& pickResult);
+
+            /**
+             * Picks the nodes of this world with each of the given rays as in pickNearest(const vm::ray3&, FloatType,
+             * const HitFilter&, PickResult&), adding the hits of the ray at index i to the pick result at index i.
+             *
+             * The rays are picked one after another. This is faster than picking with Node::pick because each ray
+             * stops visiting nodes once no closer matching hit is possible, which skips most of the nodes behind the
+             * first wall that the ray hits. The spike guides, which are the only callers, pass too few rays to make
+             * resolving them in parallel worthwhile.
+             *
+             * @param rays the pick rays
+             * @param maxDistance the maximum distance of interest
+             * @param filter the filter that determines which hits terminate the search of each ray
+             * @param pickResults the pick results to add the hits to, must contain one pick result per ray
+             */
+            void pickNearest(const std::vector<vm::ray3>& rays, FloatType maxDistance, const HitFilter& filter, std::vector<PickResult>& pickResults);
         private:
             void invalidateAllIssues();
         private: // implement Node interface
@@ -575,15 +575,12 @@ namespace TrenchBroom {
             return false;
         }
 
-        const std::vector<std::string>& pathComps = path.components();
-        const std::vector<std::string>& globComps = glob.components();
-
         for (size_t i = 0; i < globLen; ++i) {
-            if (globComps[i] == "*") {
-                // Wildcard, so we don't care what pathComps[i] is
+            if (glob.component(i) == "*") {
+                // Wildcard, so we don't care what path.component(i) is
                 continue;
             }
-            if (globComps[i] != pathComps[i]) {
+            if (glob.component(i) != path.component(i)) {
                 return false;
             }
         }
@@ -130,6 +130,10 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<bool> PackTextures(IO::Path("Renderer/Pack textures into arrays"), true);
+        Preference<bool> LoadTexturesOnDemand(IO::Path("Renderer/Load textures on demand"), false);
+        Preference<bool> CacheTextures(IO::Path("Renderer/Cache decoded textures"), false);
+        Preference<bool> EntityModelLevelOfDetail(IO::Path("Renderer/Entity model level of detail"), true);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
@@ -293,6 +297,10 @@ namespace TrenchBroom {
                 &GridColor2D,
                 &TextureMinFilter,
                 &TextureMagFilter,
+                &PackTextures,
+                &LoadTexturesOnDemand,
+                &CacheTextures,
+                &EntityModelLevelOfDetail,
                 &TextureLock,
                 &UVLock,
                 &RendererFontPath(),
@@ -123,6 +123,10 @@ namespace TrenchBroom {
 
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        extern Preference<bool> PackTextures;
+        extern Preference<bool> LoadTexturesOnDemand;
+        extern Preference<bool> CacheTextures;
+        extern Preference<bool> EntityModelLevelOfDetail;
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
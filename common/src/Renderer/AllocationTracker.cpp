@@ -53,6 +53,8 @@ namespace TrenchBroom {
 
         void AllocationTracker::unlinkFromBinList(Block* block) {
             assert(block->free);
+            assert(m_freeBlockCount > 0);
+            --m_freeBlockCount;
 
             if (block->prevOfSameSize == nullptr) {
                 // slow case: when we are the head of the list
@@ -97,6 +99,7 @@ namespace TrenchBroom {
             assert(block->size > 0);
             assert(block->prevOfSameSize == nullptr);
             assert(block->nextOfSameSize == nullptr);
+            ++m_freeBlockCount;
 
             auto it = findFirstLargerOrEqualBin(m_freeBlockSizeBins, block->size);
 
@@ -168,6 +171,8 @@ namespace TrenchBroom {
 
             block->nextOfSameSize = nullptr;
             block->prevOfSameSize = nullptr;
+            --m_freeBlockCount;
+            m_usedSize += needed;
 
             if (block->size == needed) {
                 // lucky case: exact size. we're done
@@ -217,6 +222,9 @@ namespace TrenchBroom {
             assert(block->prevOfSameSize == nullptr);
             assert(block->nextOfSameSize == nullptr);
 
+            assert(m_usedSize >= block->size);
+            m_usedSize -= block->size;
+
             Block* left = block->left;
             Block* right = block->right;
 
@@ -316,7 +324,9 @@ namespace TrenchBroom {
                 : m_capacity(0),
                   m_leftmostBlock(nullptr),
                   m_rightmostBlock(nullptr),
-                  m_recycledBlockList(nullptr) {
+                  m_recycledBlockList(nullptr),
+                  m_usedSize(0),
+                  m_freeBlockCount(0) {
             if (initial_capacity > 0) {
                 expand(initial_capacity);
                 checkInvariants();
@@ -327,7 +337,9 @@ namespace TrenchBroom {
                 : m_capacity(0),
                   m_leftmostBlock(nullptr),
                   m_rightmostBlock(nullptr),
-                  m_recycledBlockList(nullptr) {}
+                  m_recycledBlockList(nullptr),
+                  m_usedSize(0),
+                  m_freeBlockCount(0) {}
 
         AllocationTracker::~AllocationTracker() {
             checkInvariants();
@@ -421,6 +433,134 @@ namespace TrenchBroom {
             return false;
         }
 
+        AllocationTracker::Index AllocationTracker::Stats::holeSize() const {
+            return freeSize - trailingFreeSize;
+        }
+
+        double AllocationTracker::Stats::fragmentation() const {
+            if (freeSize == 0) {
+                return 0.0;
+            }
+            return 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeSize);
+        }
+
+        AllocationTracker::Stats AllocationTracker::stats() const {
+            Stats result;
+            result.capacity = m_capacity;
+            result.usedSize = m_usedSize;
+            result.freeSize = m_capacity - m_usedSize;
+            result.freeBlockCount = m_freeBlockCount;
+            result.largestFreeBlock = largestPossibleAllocation();
+            result.trailingFreeSize = (m_rightmostBlock != nullptr && m_rightmostBlock->free) ? m_rightmostBlock->size : 0;
+            return result;
+        }
+
+        void AllocationTracker::swapWithLeftFreeBlock(Block* freeBlock, Block* usedBlock) {
+            assert(freeBlock->free);
+            assert(!usedBlock->free);
+            assert(freeBlock->right == usedBlock);
+
+            // relink the blocks so that usedBlock comes before freeBlock
+            Block* left = freeBlock->left;
+            Block* right = usedBlock->right;
+
+            usedBlock->left = left;
+            usedBlock->right = freeBlock;
+            freeBlock->left = usedBlock;
+            freeBlock->right = right;
+
+            if (left == nullptr) {
+                assert(m_leftmostBlock == freeBlock);
+                m_leftmostBlock = usedBlock;
+            } else {
+                left->right = usedBlock;
+            }
+
+            if (right == nullptr) {
+                assert(m_rightmostBlock == usedBlock);
+                m_rightmostBlock = freeBlock;
+            } else {
+                right->left = freeBlock;
+            }
+
+            // the size of freeBlock is unchanged, so it can stay in its bin
+            usedBlock->pos = freeBlock->pos;
+            freeBlock->pos = usedBlock->pos + usedBlock->size;
+
+            // merge freeBlock with its new right neighbour
+            if (right != nullptr && right->free) {
+                unlinkFromBinList(freeBlock);
+                unlinkFromBinList(right);
+
+                freeBlock->size += right->size;
+                freeBlock->right = right->right;
+                if (freeBlock->right != nullptr) {
+                    freeBlock->right->left = freeBlock;
+                } else {
+                    assert(m_rightmostBlock == right);
+                    m_rightmostBlock = freeBlock;
+                }
+
+                recycle(right);
+                linkToBinList(freeBlock);
+            }
+        }
+
+        std::vector<AllocationTracker::Relocation> AllocationTracker::compact(const Index maxSize) {
+            checkInvariants();
+
+            std::vector<Relocation> result;
+
+            // find the first free block which is followed by a used block
+            Block* freeBlock = m_leftmostBlock;
+            while (freeBlock != nullptr && !freeBlock->free) {
+                freeBlock = freeBlock->right;
+            }
+
+            Index movedSize = 0;
+            while (movedSize < maxSize && freeBlock != nullptr && freeBlock->right != nullptr) {
+                // adjacent free blocks are always merged, so the block to the right must be used
+                Block* usedBlock = freeBlock->right;
+                assert(!usedBlock->free);
+
+                result.push_back(Relocation{usedBlock, usedBlock->pos});
+                swapWithLeftFreeBlock(freeBlock, usedBlock);
+                movedSize += usedBlock->size;
+            }
+
+            checkInvariants();
+            return result;
+        }
+
+        void AllocationTracker::shrink(const Index newCapacity) {
+            checkInvariants();
+
+            Block* lastBlock = m_rightmostBlock;
+            if (newCapacity >= m_capacity || lastBlock == nullptr || !lastBlock->free || newCapacity < lastBlock->pos) {
+                throw std::invalid_argument("shrink() requires the removed range to be free");
+            }
+
+            unlinkFromBinList(lastBlock);
+
+            if (newCapacity > lastBlock->pos) {
+                lastBlock->size = newCapacity - lastBlock->pos;
+                linkToBinList(lastBlock);
+            } else {
+                // remove the last block entirely
+                m_rightmostBlock = lastBlock->left;
+                if (m_rightmostBlock != nullptr) {
+                    m_rightmostBlock->right = nullptr;
+                } else {
+                    m_leftmostBlock = nullptr;
+                }
+                recycle(lastBlock);
+            }
+
+            m_capacity = newCapacity;
+
+            checkInvariants();
+        }
+
 // Testing / debugging
 
         std::vector<AllocationTracker::Range> AllocationTracker::freeBlocks() const {
@@ -469,9 +609,15 @@ namespace TrenchBroom {
 
             // check the left/right pointers, size, pos
             size_t totalSize = 0;
+            size_t freeSize = 0;
+            size_t freeBlockCount = 0;
             for (Block* block = m_leftmostBlock; block != nullptr; block = block->right) {
                 assert(block->size != 0);
                 totalSize += block->size;
+                if (block->free) {
+                    freeSize += block->size;
+                    ++freeBlockCount;
+                }
 
                 if (block->right != nullptr) {
                     assert(block->right->left == block);
@@ -488,6 +634,8 @@ namespace TrenchBroom {
                 }
             }
             assert(m_capacity == totalSize);
+            assert(m_capacity - m_usedSize == freeSize);
+            assert(m_freeBlockCount == freeBlockCount);
 
             // check the size map
             for (const auto& headBlock : m_freeBlockSizeBins) {
@@ -93,6 +93,16 @@ namespace TrenchBroom {
              */
             std::vector<Block*> m_freeBlockSizeBins;
 
+            /**
+             * Sum of `size` of all used Blocks.
+             */
+            Index m_usedSize;
+
+            /**
+             * Number of Blocks linked into m_freeBlockSizeBins, i.e. the number of free Blocks.
+             */
+            size_t m_freeBlockCount;
+
             /**
              * Unlinks a Block from m_freeBlockSizeBins. Must be called before modifying Block::size.
              */
@@ -102,6 +112,12 @@ namespace TrenchBroom {
             void recycle(Block* block);
             Block* obtainBlock();
 
+            /**
+             * Moves the given used block to the position of the given free block, which must be its left neighbour,
+             * and merges the free block with its new right neighbour if that is free, too.
+             */
+            void swapWithLeftFreeBlock(Block* freeBlock, Block* usedBlock);
+
         public:
             explicit AllocationTracker(Index initial_capacity);
             AllocationTracker();
@@ -125,6 +141,59 @@ namespace TrenchBroom {
              */
             bool hasAllocations() const;
 
+            struct Stats {
+                Index capacity;
+                Index usedSize;
+                Index freeSize;
+                size_t freeBlockCount;
+                Index largestFreeBlock;
+                /**
+                 * The size of the free block at the end of the buffer, or 0 if the buffer ends in a used block.
+                 */
+                Index trailingFreeSize;
+
+                /**
+                 * The size of the free space that is not at the end of the buffer.
+                 */
+                Index holeSize() const;
+                /**
+                 * Returns a value between 0 and 1 indicating how much of the free space is unusable for an allocation
+                 * of the size of the largest free block. 0 means that all free space is contiguous.
+                 */
+                double fragmentation() const;
+            };
+
+            /**
+             * Returns statistics about the memory managed by this AllocationTracker. Constant time.
+             */
+            Stats stats() const;
+
+            struct Relocation {
+                Block* block;
+                Index oldPos;
+            };
+
+            /**
+             * Incrementally compacts the used blocks towards the start of the buffer by moving them into the free
+             * blocks to their left. Stops once the sizes of the moved blocks add up to at least `maxSize`, or when there
+             * are no more free blocks followed by used blocks.
+             *
+             * The Block objects of the relocated blocks remain valid, only their positions change. The caller is
+             * responsible for moving the data of each block from `oldPos` to `block->pos`, and it must do so in the
+             * order in which the relocations are returned because the old and new ranges of a block may overlap with
+             * those of previously relocated blocks.
+             *
+             * @param maxSize the amount of data to move
+             * @return the relocated blocks
+             */
+            std::vector<Relocation> compact(Index maxSize);
+
+            /**
+             * Reduces the capacity by removing free space from the end of the buffer. The buffer must end in a free
+             * block that covers the range from `newCapacity` to the current capacity.
+             */
+            void shrink(Index newCapacity);
+
             // Testing / debugging
 
             class Range {
@@ -21,6 +21,7 @@
 
 #include "Preferences.h"
 #include "PreferenceManager.h"
+#include "Assets/Texture.h"
 #include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
@@ -29,10 +30,13 @@
 #include "Model/TagAttribute.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderStatistics.h"
+
+#include <kdl/parallel.h>
 
 #include <cassert>
-#include <cstring>
 #include <vector>
 
 namespace TrenchBroom {
@@ -174,6 +178,8 @@ namespace TrenchBroom {
             assert(m_brushInfo.empty());
             assert(m_transparentFaces->empty());
             assert(m_opaqueFaces->empty());
+            assert(m_transparentPackedFaces->empty());
+            assert(m_opaquePackedFaces->empty());
         }
 
         void BrushRenderer::invalidateBrushes(const std::vector<Model::BrushNode*>& brushes) {
@@ -197,6 +203,7 @@ namespace TrenchBroom {
 
         void BrushRenderer::clear() {
             m_brushInfo.clear();
+            m_vertexBlockToBrush.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
 
@@ -204,9 +211,11 @@ namespace TrenchBroom {
             m_edgeIndices = std::make_shared<BrushIndexArray>();
             m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
             m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
+            m_transparentPackedFaces = std::make_shared<TextureArrayToBrushIndicesMap>();
+            m_opaquePackedFaces = std::make_shared<TextureArrayToBrushIndicesMap>();
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
+            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_opaquePackedFaces, m_faceColor);
+            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_transparentPackedFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
         }
 
@@ -271,7 +280,10 @@ namespace TrenchBroom {
         void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_allBrushes.empty()) {
                 if (!valid()) {
+                    TimeRenderSection timer(renderBatch.statistics(), RenderSection::ValidateBrushes);
                     validate();
+                } else {
+                    defragment();
                 }
                 if (renderContext.showFaces()) {
                     renderOpaqueFaces(renderBatch);
@@ -285,6 +297,7 @@ namespace TrenchBroom {
         void BrushRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_allBrushes.empty()) {
                 if (!valid()) {
+                    TimeRenderSection timer(renderBatch.statistics(), RenderSection::ValidateBrushes);
                     validate();
                 }
                 if (renderContext.showFaces()) {
@@ -338,17 +351,51 @@ namespace TrenchBroom {
             }
         };
 
+        struct BrushRenderer::StagedBrush {
+            struct FaceRange {
+                const Assets::Texture* texture;
+                bool transparent;
+                size_t offset;
+                size_t count;
+            };
+
+            const Model::BrushNode* brush;
+            Filter::EdgeRenderPolicy edgePolicy;
+
+            /**
+             * The edge indices come first, followed by the face indices, which are grouped by texture and pass.
+             */
+            std::vector<GLuint> indices;
+            size_t edgeIndexCount;
+            std::vector<FaceRange> faceRanges;
+        };
+
         void BrushRenderer::validate() {
             assert(!valid());
 
+            // evaluating the filter may query the preferences and the editor context, so it is done sequentially
+            std::vector<StagedBrush> stagedBrushes;
+            stagedBrushes.reserve(m_invalidBrushes.size());
             for (auto brush : m_invalidBrushes) {
-                validateBrush(brush);
+                stagedBrushes.emplace_back();
+                if (!markBrush(brush, stagedBrushes.back())) {
+                    stagedBrushes.pop_back();
+                }
             }
             m_invalidBrushes.clear();
             assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
+            // building the vertex caches and triangulating the faces only touches each brush itself
+            kdl::parallel_for_large(stagedBrushes.size(), [&](const size_t i) {
+                stageBrush(stagedBrushes[i]);
+            });
+
+            for (const auto& stagedBrush : stagedBrushes) {
+                commitBrush(stagedBrush);
+            }
+
+            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_opaquePackedFaces, m_faceColor);
+            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_transparentPackedFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
         }
 
@@ -419,6 +466,51 @@ namespace TrenchBroom {
             }
         }
 
+        template <typename Key>
+        static void defragmentFaceIndices(std::unordered_map<Key, std::shared_ptr<BrushIndexArray>>& faces, const size_t maxElements, size_t& movedIndices) {
+            for (auto& entry : faces) {
+                if (movedIndices >= maxElements) {
+                    return;
+                }
+                movedIndices += entry.second->defragment(maxElements - movedIndices);
+            }
+        }
+
+        void BrushRenderer::defragment() {
+            assert(valid());
+
+            // limits the number of elements that are moved in each array per frame
+            static const auto MaxDefragmentationElements = size_t(16384);
+
+            for (const auto& relocation : m_vertexArray->defragment(MaxDefragmentationElements)) {
+                const auto* brush = m_vertexBlockToBrush.at(relocation.block);
+                const BrushInfo& info = m_brushInfo.at(brush);
+                const auto offset = static_cast<GLint>(relocation.block->pos) - static_cast<GLint>(relocation.oldPos);
+
+                if (info.edgeIndicesKey != nullptr) {
+                    m_edgeIndices->offsetElementsWithKey(info.edgeIndicesKey, offset);
+                }
+                for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
+                    m_opaqueFaces->at(texture)->offsetElementsWithKey(opaqueKey, offset);
+                }
+                for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
+                    m_transparentFaces->at(texture)->offsetElementsWithKey(transparentKey, offset);
+                }
+                for (const auto& [arrayTextureId, opaqueKey] : info.opaquePackedFaceIndicesKeys) {
+                    m_opaquePackedFaces->at(arrayTextureId)->offsetElementsWithKey(opaqueKey, offset);
+                }
+                for (const auto& [arrayTextureId, transparentKey] : info.transparentPackedFaceIndicesKeys) {
+                    m_transparentPackedFaces->at(arrayTextureId)->offsetElementsWithKey(transparentKey, offset);
+                }
+            }
+
+            size_t movedIndices = m_edgeIndices->defragment(MaxDefragmentationElements);
+            defragmentFaceIndices(*m_opaqueFaces, MaxDefragmentationElements, movedIndices);
+            defragmentFaceIndices(*m_transparentFaces, MaxDefragmentationElements, movedIndices);
+            defragmentFaceIndices(*m_opaquePackedFaces, MaxDefragmentationElements, movedIndices);
+            defragmentFaceIndices(*m_transparentPackedFaces, MaxDefragmentationElements, movedIndices);
+        }
+
         bool BrushRenderer::shouldDrawFaceInTransparentPass(const Model::BrushNode* brush, const Model::BrushFace& face) const {
             if (m_transparencyAlpha >= 1.0f) {
                 // In this case, draw everything in the opaque pass
@@ -438,7 +530,7 @@ namespace TrenchBroom {
             return false;
         }
 
-        void BrushRenderer::validateBrush(const Model::BrushNode* brush) {
+        bool BrushRenderer::markBrush(const Model::BrushNode* brush, StagedBrush& stagedBrush) const {
             assert(m_allBrushes.find(brush) != std::end(m_allBrushes));
             assert(m_invalidBrushes.find(brush) != std::end(m_invalidBrushes));
             assert(m_brushInfo.find(brush) == std::end(m_brushInfo));
@@ -452,119 +544,169 @@ namespace TrenchBroom {
             if (facePolicy == Filter::FaceRenderPolicy::RenderNone &&
                 edgePolicy == Filter::EdgeRenderPolicy::RenderNone) {
                 // NOTE: this skips inserting the brush into m_brushInfo
-                return;
+                return false;
             }
 
-            BrushInfo& info = m_brushInfo[brush];
+            stagedBrush.brush = brush;
+            stagedBrush.edgePolicy = edgePolicy;
+            return true;
+        }
+
+        void BrushRenderer::stageBrush(StagedBrush& stagedBrush) const {
+            const auto* brush = stagedBrush.brush;
 
             // collect vertices
             auto& brushCache = brush->brushRendererBrushCache();
             brushCache.validateVertexCache(brush);
-            const auto& cachedVertices = brushCache.cachedVertices();
-            ensure(!cachedVertices.empty(), "Brush must have cached vertices");
-
-            assert(m_vertexArray != nullptr);
-            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-            std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-            info.vertexHolderKey = vertBlock;
+            ensure(!brushCache.cachedVertices().empty(), "Brush must have cached vertices");
 
-            const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+            // count indices so that we only allocate once
+            const auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
+            const size_t edgeIndexCount = countMarkedEdgeIndices(brush, stagedBrush.edgePolicy);
 
-            // insert edge indices into VBO
-            {
-                const size_t edgeIndexCount = countMarkedEdgeIndices(brush, edgePolicy);
-                if (edgeIndexCount > 0) {
-                    auto [key, insertDest] = m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
-                    info.edgeIndicesKey = key;
-                    getMarkedEdgeIndices(brush, edgePolicy, brushVerticesStartIndex, insertDest);
-                } else {
-                    // it's possible to have no edges to render
-                    // e.g. select all faces of a brush, and the unselected brush renderer
-                    // will hit this branch.
-                    ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
+            size_t faceIndexCount = 0;
+            for (const auto& cache : facesSortedByTex) {
+                if (cache.face->isMarked()) {
+                    faceIndexCount += triIndicesCountForPolygon(cache.vertexCount);
                 }
             }
 
-            // insert face indices
+            stagedBrush.indices.resize(edgeIndexCount + faceIndexCount);
+            stagedBrush.edgeIndexCount = edgeIndexCount;
+
+            // edge indices
+            getMarkedEdgeIndices(brush, stagedBrush.edgePolicy, 0, stagedBrush.indices.data());
 
-            auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
+            // face indices
             const size_t facesSortedByTexSize = facesSortedByTex.size();
+            size_t offset = edgeIndexCount;
 
             size_t nextI;
             for (size_t i = 0; i < facesSortedByTexSize; i = nextI) {
                 const Assets::Texture* texture = facesSortedByTex[i].texture;
 
-                size_t opaqueIndexCount = 0;
-                size_t transparentIndexCount = 0;
-
                 // find the i value for the next texture
                 for (nextI = i + 1; nextI < facesSortedByTexSize && facesSortedByTex[nextI].texture == texture; ++nextI) {}
 
-                // process all faces with this texture (they'll be consecutive)
-                for (size_t j = i; j < nextI; ++j) {
-                    const BrushRendererBrushCache::CachedFace& cache = facesSortedByTex[j];
-                    if (cache.face->isMarked()) {
-                        assert(cache.texture == texture);
-                        if (shouldDrawFaceInTransparentPass(brush, *cache.face)) {
-                            transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount);
-                        } else {
-                            opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount);
+                // process all faces with this texture (they'll be consecutive), once for each pass
+                for (const bool transparent : { true, false }) {
+                    const size_t rangeOffset = offset;
+                    for (size_t j = i; j < nextI; ++j) {
+                        const BrushRendererBrushCache::CachedFace& cache = facesSortedByTex[j];
+                        if (cache.face->isMarked() && shouldDrawFaceInTransparentPass(brush, *cache.face) == transparent) {
+                            assert(cache.texture == texture);
+                            addTriIndicesForPolygon(stagedBrush.indices.data() + offset,
+                                                    static_cast<GLuint>(cache.indexOfFirstVertexRelativeToBrush),
+                                                    cache.vertexCount);
+                            offset += triIndicesCountForPolygon(cache.vertexCount);
                         }
                     }
-                }
 
-                if (transparentIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_transparentFaces;
-                    auto& holderPtr = faceVboMap[texture];
-                    if (holderPtr == nullptr) {
-                        // inserts into map!
-                        holderPtr = std::make_shared<BrushIndexArray>();
+                    if (offset > rangeOffset) {
+                        stagedBrush.faceRanges.push_back({texture, transparent, rangeOffset, offset - rangeOffset});
                     }
+                }
+            }
+            assert(offset == stagedBrush.indices.size());
+        }
 
-                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
-                    info.transparentFaceIndicesKeys.push_back({texture, key});
+        static vm::vec<GLubyte, 4> toVertexColor(const Color& color) {
+            return vm::vec<GLubyte, 4>(static_cast<GLubyte>(color.r() * 255.0f),
+                                       static_cast<GLubyte>(color.g() * 255.0f),
+                                       static_cast<GLubyte>(color.b() * 255.0f),
+                                       static_cast<GLubyte>(color.a() * 255.0f));
+        }
 
-                    // process all faces with this texture (they'll be consecutive)
-                    GLuint *currentDest = insertDest;
-                    for (size_t j = i; j < nextI; ++j) {
-                        const BrushRendererBrushCache::CachedFace& cache = facesSortedByTex[j];
-                        if (cache.face->isMarked() && shouldDrawFaceInTransparentPass(brush, *cache.face)) {
-                            addTriIndicesForPolygon(currentDest,
-                                                    static_cast<GLuint>(brushVerticesStartIndex +
-                                                                        cache.indexOfFirstVertexRelativeToBrush),
-                                                    cache.vertexCount);
+        /**
+         * Copies the cached vertices of a brush. If a face's texture is packed into a texture array, its vertices also
+         * receive the layer and the average color of the texture, see FaceRenderer.
+         */
+        static void copyVertices(const BrushRendererBrushCache& brushCache, BrushVertexArray::Vertex* dest) {
+            const auto& cachedVertices = brushCache.cachedVertices();
 
-                            currentDest += triIndicesCountForPolygon(cache.vertexCount);
-                        }
-                    }
-                    assert(currentDest == (insertDest + transparentIndexCount));
+            for (const auto& cache : brushCache.cachedFacesSortedByTexture()) {
+                const Assets::Texture* texture = cache.texture;
+                const bool packed = texture != nullptr && texture->packed();
+                const auto layer = packed ? static_cast<float>(texture->arrayLayer()) : 0.0f;
+                const auto color = packed ? toVertexColor(texture->averageColor()) : vm::vec<GLubyte, 4>::zero();
+
+                const size_t first = cache.indexOfFirstVertexRelativeToBrush;
+                for (size_t i = first; i < first + cache.vertexCount; ++i) {
+                    const auto& vertex = cachedVertices[i];
+                    const auto& texCoords = getVertexComponent<2>(vertex);
+                    dest[i] = BrushVertexArray::Vertex(getVertexComponent<0>(vertex),
+                                                       getVertexComponent<1>(vertex),
+                                                       vm::vec3f(texCoords.x(), texCoords.y(), layer),
+                                                       color);
                 }
+            }
+        }
 
-                if (opaqueIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_opaqueFaces;
-                    auto& holderPtr = faceVboMap[texture];
-                    if (holderPtr == nullptr) {
-                        // inserts into map!
-                        holderPtr = std::make_shared<BrushIndexArray>();
-                    }
+        static void copyIndices(const GLuint* source, const size_t count, const GLuint baseIndex, GLuint* dest) {
+            for (size_t i = 0; i < count; ++i) {
+                dest[i] = source[i] + baseIndex;
+            }
+        }
 
-                    auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
-                    info.opaqueFaceIndicesKeys.push_back({texture, key});
+        template <typename Key>
+        static std::pair<AllocationTracker::Block*, GLuint*> getPointerToInsertFaceIndicesAt(std::unordered_map<Key, std::shared_ptr<BrushIndexArray>>& faces, const Key& key, const size_t count) {
+            auto& holderPtr = faces[key];
+            if (holderPtr == nullptr) {
+                // inserts into map!
+                holderPtr = std::make_shared<BrushIndexArray>();
+            }
+            return holderPtr->getPointerToInsertElementsAt(count);
+        }
 
-                    // process all faces with this texture (they'll be consecutive)
-                    GLuint *currentDest = insertDest;
-                    for (size_t j = i; j < nextI; ++j) {
-                        const BrushRendererBrushCache::CachedFace& cache = facesSortedByTex[j];
-                        if (cache.face->isMarked() && !shouldDrawFaceInTransparentPass(brush, *cache.face)) {
-                            addTriIndicesForPolygon(currentDest,
-                                                    static_cast<GLuint>(brushVerticesStartIndex +
-                                                                        cache.indexOfFirstVertexRelativeToBrush),
-                                                    cache.vertexCount);
+        void BrushRenderer::commitBrush(const StagedBrush& stagedBrush) {
+            const auto* brush = stagedBrush.brush;
+            assert(m_brushInfo.find(brush) == std::end(m_brushInfo));
 
-                            currentDest += triIndicesCountForPolygon(cache.vertexCount);
-                        }
-                    }
-                    assert(currentDest == (insertDest + opaqueIndexCount));
+            BrushInfo& info = m_brushInfo[brush];
+
+            // insert vertices into VBO
+            const auto& brushCache = brush->brushRendererBrushCache();
+
+            assert(m_vertexArray != nullptr);
+            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(brushCache.cachedVertices().size());
+            copyVertices(brushCache, dest);
+            info.vertexHolderKey = vertBlock;
+            m_vertexBlockToBrush[vertBlock] = brush;
+
+            const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+
+            // insert edge indices into VBO
+            if (stagedBrush.edgeIndexCount > 0) {
+                auto [key, insertDest] = m_edgeIndices->getPointerToInsertElementsAt(stagedBrush.edgeIndexCount);
+                info.edgeIndicesKey = key;
+                copyIndices(stagedBrush.indices.data(), stagedBrush.edgeIndexCount, brushVerticesStartIndex, insertDest);
+            } else {
+                // it's possible to have no edges to render
+                // e.g. select all faces of a brush, and the unselected brush renderer
+                // will hit this branch.
+                ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
+            }
+
+            // insert face indices into VBO, faces with packed textures go into the index array of their texture array
+            for (const auto& range : stagedBrush.faceRanges) {
+                const Assets::Texture* texture = range.texture;
+                if (texture != nullptr && texture->packed()) {
+                    const GLuint arrayTextureId = texture->arrayTextureId();
+                    TextureArrayToBrushIndicesMap& faceVboMap = range.transparent ? *m_transparentPackedFaces : *m_opaquePackedFaces;
+
+                    auto [key, insertDest] = getPointerToInsertFaceIndicesAt(faceVboMap, arrayTextureId, range.count);
+                    copyIndices(stagedBrush.indices.data() + range.offset, range.count, brushVerticesStartIndex, insertDest);
+
+                    auto& keys = range.transparent ? info.transparentPackedFaceIndicesKeys : info.opaquePackedFaceIndicesKeys;
+                    keys.push_back({arrayTextureId, key});
+                } else {
+                    TextureToBrushIndicesMap& faceVboMap = range.transparent ? *m_transparentFaces : *m_opaqueFaces;
+
+                    auto [key, insertDest] = getPointerToInsertFaceIndicesAt(faceVboMap, texture, range.count);
+                    copyIndices(stagedBrush.indices.data() + range.offset, range.count, brushVerticesStartIndex, insertDest);
+
+                    auto& keys = range.transparent ? info.transparentFaceIndicesKeys : info.opaqueFaceIndicesKeys;
+                    keys.push_back({texture, key});
                 }
             }
         }
@@ -591,11 +733,22 @@ namespace TrenchBroom {
             removeBrushFromVbo(brush);
         }
 
+        template <typename Key>
+        static void zeroFaceIndices(std::unordered_map<Key, std::shared_ptr<BrushIndexArray>>& faces, const Key& key, AllocationTracker::Block* block) {
+            std::shared_ptr<BrushIndexArray> faceIndexHolder = faces.at(key);
+            faceIndexHolder->zeroElementsWithKey(block);
+
+            if (!faceIndexHolder->hasValidIndices()) {
+                // There are no indices left to render for this texture or texture array, so delete its entry from the map
+                faces.erase(key);
+            }
+        }
+
         void BrushRenderer::removeBrushFromVbo(const Model::BrushNode* brush) {
             auto it = m_brushInfo.find(brush);
 
             if (it == std::end(m_brushInfo)) {
-                // This means BrushRenderer::validateBrush skipped rendering the brush, so it was never
+                // This means BrushRenderer::markBrush skipped rendering the brush, so it was never
                 // uploaded to the VBO's
                 return;
             }
@@ -603,28 +756,23 @@ namespace TrenchBroom {
             const BrushInfo& info = it->second;
 
             // update Vbo's
+            m_vertexBlockToBrush.erase(info.vertexHolderKey);
             m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
                 m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
             }
 
             for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
-                faceIndexHolder->zeroElementsWithKey(opaqueKey);
-
-                if (!faceIndexHolder->hasValidIndices()) {
-                    // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_opaqueFaces->erase(texture);
-                }
+                zeroFaceIndices(*m_opaqueFaces, texture, opaqueKey);
             }
             for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
-                faceIndexHolder->zeroElementsWithKey(transparentKey);
-
-                if (!faceIndexHolder->hasValidIndices()) {
-                    // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_transparentFaces->erase(texture);
-                }
+                zeroFaceIndices(*m_transparentFaces, texture, transparentKey);
+            }
+            for (const auto& [arrayTextureId, opaqueKey] : info.opaquePackedFaceIndicesKeys) {
+                zeroFaceIndices(*m_opaquePackedFaces, arrayTextureId, opaqueKey);
+            }
+            for (const auto& [arrayTextureId, transparentKey] : info.transparentPackedFaceIndicesKeys) {
+                zeroFaceIndices(*m_transparentPackedFaces, arrayTextureId, transparentKey);
             }
 
             m_brushInfo.erase(it);
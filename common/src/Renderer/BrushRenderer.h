@@ -122,12 +122,19 @@ namespace TrenchBroom {
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> transparentFaceIndicesKeys;
+                std::vector<std::pair<GLuint, AllocationTracker::Block*>> opaquePackedFaceIndicesKeys;
+                std::vector<std::pair<GLuint, AllocationTracker::Block*>> transparentPackedFaceIndicesKeys;
             };
             /**
              * Tracks all brushes that are stored in the VBO, with the information necessary to remove them
              * from the VBO later.
              */
             std::unordered_map<const Model::BrushNode*, BrushInfo> m_brushInfo;
+            /**
+             * Maps the vertex allocations in m_vertexArray back to their brushes. Needed to update the indices of a
+             * brush when its vertices are relocated.
+             */
+            std::unordered_map<const AllocationTracker::Block*, const Model::BrushNode*> m_vertexBlockToBrush;
 
             /**
              * If a brush is in the VBO, it's always valid.
@@ -145,6 +152,13 @@ namespace TrenchBroom {
             std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
             std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
 
+            /**
+             * The faces whose textures are packed into texture arrays, with one index array per texture array.
+             */
+            using TextureArrayToBrushIndicesMap = std::unordered_map<GLuint, std::shared_ptr<BrushIndexArray>>;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> m_transparentPackedFaces;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> m_opaquePackedFaces;
+
             FaceRenderer m_opaqueFaceRenderer;
             FaceRenderer m_transparentFaceRenderer;
             IndexedEdgeRenderer m_edgeRenderer;
@@ -194,8 +208,9 @@ namespace TrenchBroom {
              *
              * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the Brush object for modification.
              *
-             * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces, and m_opaqueFaces
-             * maps will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
+             * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces, m_opaqueFaces,
+             * m_transparentPackedFaces, and m_opaquePackedFaces maps will be empty, so the BrushRenderer will not have
+             * any lingering Texture* pointers or texture array ids.
              */
             void invalidate();
             void invalidateBrushes(const std::vector<Model::BrushNode*>& brushes);
@@ -279,9 +294,37 @@ namespace TrenchBroom {
              * Only exposed for benchmarking.
              */
             void validate();
+
+            /**
+             * Moves the brushes in the VBOs closer together, doing a bounded amount of work per call. Called instead
+             * of validate() when there are no invalid brushes.
+             */
+            void defragment();
         private:
             bool shouldDrawFaceInTransparentPass(const Model::BrushNode* brush, const Model::BrushFace& face) const;
-            void validateBrush(const Model::BrushNode* brush);
+
+            /**
+             * The vertex and index data of a brush that is about to be inserted into the VBOs. Indices are relative to
+             * the brush's first vertex because the brush's position in the vertex array is not yet known.
+             */
+            struct StagedBrush;
+
+            /**
+             * Evaluates the filter for the given brush and returns whether the brush should be inserted into the VBOs.
+             * Must be called on the main thread.
+             */
+            bool markBrush(const Model::BrushNode* brush, StagedBrush& stagedBrush) const;
+
+            /**
+             * Computes the vertex and index data of a marked brush. Only touches the given brush, so this can be called
+             * for different brushes on different threads.
+             */
+            void stageBrush(StagedBrush& stagedBrush) const;
+
+            /**
+             * Allocates space for the given staged brush in the VBOs and copies its data there.
+             */
+            void commitBrush(const StagedBrush& stagedBrush);
             void addBrush(const Model::BrushNode* brush);
             void removeBrush(const Model::BrushNode* brush);
 
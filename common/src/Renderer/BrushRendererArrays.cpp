@@ -31,11 +31,15 @@ namespace TrenchBroom {
 
         // DirtyRangeTracker
 
-        DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(initial_capacity) {}
+        bool DirtyRangeTracker::Range::operator==(const Range& other) const {
+            return pos == other.pos && size == other.size;
+        }
+
+        DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity, const size_t coalesceDistance)
+                : m_normalized(true), m_capacity(initial_capacity), m_coalesceDistance(coalesceDistance) {}
 
         DirtyRangeTracker::DirtyRangeTracker()
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(0) {}
+                : m_normalized(true), m_capacity(0), m_coalesceDistance(0) {}
 
         void DirtyRangeTracker::expand(const size_t newcap) {
             if (newcap <= m_capacity) {
@@ -57,15 +61,89 @@ namespace TrenchBroom {
                 throw std::invalid_argument("markDirty provided range out of bounds");
             }
 
-            const size_t newPos = std::min(pos, m_dirtyPos);
-            const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+            if (size == 0) {
+                return;
+            }
+
+            // consecutive writes are common, so merge with the last range right away if possible and defer sorting
+            // everything else until the ranges are requested
+            if (!m_ranges.empty()) {
+                Range& last = m_ranges.back();
+                if (pos <= last.pos + last.size + m_coalesceDistance && last.pos <= pos + size + m_coalesceDistance) {
+                    const size_t newPos = std::min(pos, last.pos);
+                    const size_t newEnd = std::max(pos + size, last.pos + last.size);
+                    last = Range{newPos, newEnd - newPos};
+                    m_normalized = m_ranges.size() == 1u;
+                    return;
+                }
+            }
 
-            m_dirtyPos = newPos;
-            m_dirtySize = newEnd - newPos;
+            m_ranges.push_back(Range{pos, size});
+            m_normalized = m_ranges.size() == 1u;
         }
 
         bool DirtyRangeTracker::clean() const {
-            return m_dirtySize == 0;
+            return m_ranges.empty();
+        }
+
+        const std::vector<DirtyRangeTracker::Range>& DirtyRangeTracker::dirtyRanges() {
+            normalize();
+            return m_ranges;
+        }
+
+        size_t DirtyRangeTracker::dirtySize() {
+            normalize();
+
+            size_t result = 0;
+            for (const auto& range : m_ranges) {
+                result += range.size;
+            }
+            return result;
+        }
+
+        void DirtyRangeTracker::reset() {
+            m_ranges.clear();
+            m_normalized = true;
+        }
+
+        void DirtyRangeTracker::normalize() {
+            if (m_normalized) {
+                return;
+            }
+
+            std::sort(std::begin(m_ranges), std::end(m_ranges), [](const Range& lhs, const Range& rhs) { return lhs.pos < rhs.pos; });
+
+            // merge overlapping and close ranges in place
+            size_t last = 0;
+            for (size_t i = 1; i < m_ranges.size(); ++i) {
+                Range& current = m_ranges[last];
+                const Range& next = m_ranges[i];
+                if (next.pos <= current.pos + current.size + m_coalesceDistance) {
+                    const size_t newEnd = std::max(current.pos + current.size, next.pos + next.size);
+                    current.size = newEnd - current.pos;
+                } else {
+                    m_ranges[++last] = next;
+                }
+            }
+            m_ranges.resize(last + 1);
+            m_normalized = true;
+        }
+
+        // defragmentation
+
+        /**
+         * Arrays are only defragmented once they are more than twice as large as their contents. The array size is
+         * doubled when it runs out of space, so this does not trigger for arrays that have just grown.
+         */
+        static bool needsDefragmentation(const AllocationTracker::Stats& stats) {
+            return stats.usedSize > 0 && stats.freeSize > stats.usedSize;
+        }
+
+        /**
+         * After compaction, leave some room for new allocations to avoid growing the array again immediately.
+         */
+        static AllocationTracker::Index shrunkCapacity(const AllocationTracker::Stats& stats) {
+            return stats.usedSize + stats.usedSize / 2;
         }
 
         // IndexHolder
@@ -82,9 +160,30 @@ namespace TrenchBroom {
 
         void IndexHolder::render(const PrimType primType, const size_t offset, size_t count) const {
             const GLsizei renderCount = static_cast<GLsizei>(count);
-            const GLvoid *renderOffset = reinterpret_cast<GLvoid *>(m_vbo->offset() + sizeof(Index) * offset);
+            const GLvoid* renderOffset = offsetPointer(offset);
 
             glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
+            m_vboManager->renderStatistics().countDrawCall(count);
+        }
+
+        void IndexHolder::render(const PrimType primType, const GLCounts& counts, const std::vector<const GLvoid*>& offsets) const {
+            assert(counts.size() == offsets.size());
+            if (counts.empty()) {
+                return;
+            }
+
+            const GLsizei drawCount = static_cast<GLsizei>(counts.size());
+            glAssert(glMultiDrawElements(toGL(primType), counts.data(), glType<Index>(), offsets.data(), drawCount));
+
+            size_t count = 0;
+            for (const auto c : counts) {
+                count += static_cast<size_t>(c);
+            }
+            m_vboManager->renderStatistics().countDrawCall(count);
+        }
+
+        const GLvoid* IndexHolder::offsetPointer(const size_t offset) const {
+            return reinterpret_cast<const GLvoid*>(m_vbo->offset() + sizeof(Index) * offset);
         }
 
         std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
@@ -95,16 +194,24 @@ namespace TrenchBroom {
 
         // BrushIndexArray
 
+        // the gaps between allocations are zeroed, so they can be rendered as degenerate primitives
+        static const auto MaxDrawCommandGap = size_t(256);
+
         BrushIndexArray::BrushIndexArray() : m_indexHolder(),
-                                             m_allocationTracker(0) {}
+                                             m_allocationTracker(0),
+                                             m_drawCommands(MaxDrawCommandGap),
+                                             m_drawCommandsValid(false) {}
 
         bool BrushIndexArray::hasValidIndices() const {
             return m_allocationTracker.hasAllocations();
         }
 
         std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::getPointerToInsertElementsAt(const size_t elementCount) {
+            m_drawCommandsValid = false;
+
             auto block = m_allocationTracker.allocate(elementCount);
             if (block != nullptr) {
+                m_drawCommands.add(block->pos, block->size);
                 GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
                 return {block, dest};
             }
@@ -118,6 +225,7 @@ namespace TrenchBroom {
             // insert again
             block = m_allocationTracker.allocate(elementCount);
             assert(block != nullptr);
+            m_drawCommands.add(block->pos, block->size);
 
             GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(block->pos, elementCount);
             return {block, dest};
@@ -127,13 +235,59 @@ namespace TrenchBroom {
             const auto pos = key->pos;
             const auto size = key->size;
             m_allocationTracker.free(key);
+            m_drawCommands.remove(pos, size);
+            m_drawCommandsValid = false;
 
             m_indexHolder.zeroRange(pos, size);
         }
 
+        void BrushIndexArray::offsetElementsWithKey(const AllocationTracker::Block* key, const GLint offset) {
+            GLuint* dest = m_indexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+            for (size_t i = 0; i < key->size; ++i) {
+                dest[i] = static_cast<GLuint>(static_cast<GLint>(dest[i]) + offset);
+            }
+        }
+
+        AllocationTracker::Stats BrushIndexArray::stats() const {
+            return m_allocationTracker.stats();
+        }
+
+        size_t BrushIndexArray::defragment(const size_t maxElements) {
+            if (!needsDefragmentation(m_allocationTracker.stats())) {
+                return 0;
+            }
+
+            m_drawCommandsValid = false;
+
+            size_t movedElements = 0;
+            for (const auto& relocation : m_allocationTracker.compact(maxElements)) {
+                const auto* block = relocation.block;
+                assert(block->pos < relocation.oldPos);
+                m_indexHolder.moveElements(relocation.oldPos, block->pos, block->size);
+
+                // the whole array is rendered, so the vacated range must become degenerate primitives
+                const size_t vacatedPos = std::max(relocation.oldPos, block->pos + block->size);
+                m_indexHolder.zeroRange(vacatedPos, relocation.oldPos + block->size - vacatedPos);
+                m_drawCommands.remove(relocation.oldPos, block->size);
+                m_drawCommands.add(block->pos, block->size);
+                movedElements += block->size;
+            }
+
+            const auto stats = m_allocationTracker.stats();
+            if (stats.holeSize() == 0 && needsDefragmentation(stats)) {
+                const auto newCapacity = shrunkCapacity(stats);
+                m_allocationTracker.shrink(newCapacity);
+                m_indexHolder.shrink(newCapacity);
+                m_drawCommands.truncate(newCapacity);
+            }
+
+            return movedElements;
+        }
+
         void BrushIndexArray::render(const PrimType primType) const {
             assert(m_indexHolder.prepared());
-            m_indexHolder.render(primType, 0, m_indexHolder.size());
+            assert(m_drawCommandsValid);
+            m_indexHolder.render(primType, m_drawCounts, m_drawOffsets);
         }
 
         bool BrushIndexArray::prepared() const {
@@ -143,6 +297,10 @@ namespace TrenchBroom {
         void BrushIndexArray::prepare(VboManager& vboManager) {
             m_indexHolder.prepare(vboManager);
             assert(m_indexHolder.prepared());
+
+            if (!m_drawCommandsValid) {
+                updateDrawCommands();
+            }
         }
 
         void BrushIndexArray::setupIndices() {
@@ -153,6 +311,20 @@ namespace TrenchBroom {
             m_indexHolder.unbindBlock();
         }
 
+        void BrushIndexArray::updateDrawCommands() {
+            m_drawCounts.clear();
+            m_drawOffsets.clear();
+
+            if (!m_indexHolder.empty()) {
+                for (const auto& command : m_drawCommands.commands()) {
+                    m_drawCounts.push_back(static_cast<GLsizei>(command.count));
+                    m_drawOffsets.push_back(m_indexHolder.offsetPointer(command.offset));
+                }
+            }
+
+            m_drawCommandsValid = true;
+        }
+
         // BrushVertexArray
 
         BrushVertexArray::BrushVertexArray() : m_vertexHolder(),
@@ -188,6 +360,32 @@ namespace TrenchBroom {
             // us to re-use the space later
         }
 
+        AllocationTracker::Stats BrushVertexArray::stats() const {
+            return m_allocationTracker.stats();
+        }
+
+        std::vector<AllocationTracker::Relocation> BrushVertexArray::defragment(const size_t maxElements) {
+            if (!needsDefragmentation(m_allocationTracker.stats())) {
+                return {};
+            }
+
+            auto relocations = m_allocationTracker.compact(maxElements);
+            for (const auto& relocation : relocations) {
+                const auto* block = relocation.block;
+                assert(block->pos < relocation.oldPos);
+                m_vertexHolder.moveElements(relocation.oldPos, block->pos, block->size);
+            }
+
+            const auto stats = m_allocationTracker.stats();
+            if (stats.holeSize() == 0 && needsDefragmentation(stats)) {
+                const auto newCapacity = shrunkCapacity(stats);
+                m_allocationTracker.shrink(newCapacity);
+                m_vertexHolder.shrink(newCapacity);
+            }
+
+            return relocations;
+        }
+
         bool BrushVertexArray::setupVertices() {
             return m_vertexHolder.setupVertices();
         }
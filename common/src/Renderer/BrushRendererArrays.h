@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Renderer/AllocationTracker.h"
+#include "Renderer/DrawCommands.h"
 #include "Renderer/GL.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
@@ -30,22 +31,37 @@
 
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
+        /**
+         * Tracks the ranges of a buffer that were modified since the last upload. Ranges that are closer to each other
+         * than the coalesce distance are merged, since uploading the gap between them is cheaper than issuing another
+         * upload.
+         */
         struct DirtyRangeTracker {
-            size_t m_dirtyPos;
-            size_t m_dirtySize;
+            struct Range {
+                size_t pos;
+                size_t size;
+
+                bool operator==(const Range& other) const;
+            };
+
+            std::vector<Range> m_ranges;
+            bool m_normalized;
             size_t m_capacity;
+            size_t m_coalesceDistance;
 
             /**
              * New trackers are initially clean.
              */
-            explicit DirtyRangeTracker(size_t initial_capacity);
+            explicit DirtyRangeTracker(size_t initial_capacity, size_t coalesceDistance = 0);
             DirtyRangeTracker();
 
             /**
@@ -55,6 +71,24 @@ namespace TrenchBroom {
             size_t capacity() const;
             void markDirty(size_t pos, size_t size);
             bool clean() const;
+
+            /**
+             * Returns the dirty ranges sorted by position. No two ranges overlap or are closer to each other than the
+             * coalesce distance.
+             */
+            const std::vector<Range>& dirtyRanges();
+
+            /**
+             * Returns the total number of dirty elements.
+             */
+            size_t dirtySize();
+
+            /**
+             * Marks the entire buffer as clean.
+             */
+            void reset();
+        private:
+            void normalize();
         };
 
         /**
@@ -63,11 +97,16 @@ namespace TrenchBroom {
          * Non-copyable; meant to be held in a std::shared_ptr.
          * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
          *
-         * Currently uses a single range to track the modified region which might upload much more than necessary;
-         * it might be worth mapping the VBO and editing it directly.
+         * Tracks the modified regions with a DirtyRangeTracker and uploads each of them separately, so that scattered
+         * edits do not upload everything in between.
          */
         template<typename T>
         class VboHolder {
+        public:
+            /**
+             * Dirty ranges which are closer than this many bytes are uploaded together.
+             */
+            static const size_t CoalesceBytes = 4096;
         protected:
             VboType m_type;
             std::vector<T> m_snapshot;
@@ -93,18 +132,22 @@ namespace TrenchBroom {
                 m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), VboUsage::DynamicDraw);
                 assert(m_vbo != nullptr);
 
-                m_vbo->writeElements(0, m_snapshot);
+                const size_t bytes = m_vbo->writeElements(0, m_snapshot);
+                m_vboManager->addUploadedBytes(bytes);
 
-                m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+                m_dirtyRange = DirtyRangeTracker(m_snapshot.size(), coalesceDistance());
                 assert(m_dirtyRange.clean());
                 assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRange.capacity());
             }
 
+            static size_t coalesceDistance() {
+                return std::max(CoalesceBytes / sizeof(T), size_t(1));
+            }
         public:
             explicit VboHolder(const VboType type) :
             m_type(type),
             m_snapshot(),
-            m_dirtyRange(0),
+            m_dirtyRange(0, coalesceDistance()),
             m_vboManager(nullptr),
             m_vbo(nullptr) {}
 
@@ -114,7 +157,7 @@ namespace TrenchBroom {
             VboHolder(const VboType type, std::vector<T>& elements) :
             m_type(type),
             m_snapshot(),
-            m_dirtyRange(elements.size()),
+            m_dirtyRange(elements.size(), coalesceDistance()),
             m_vboManager(nullptr),
             m_vbo(nullptr) {
 
@@ -142,6 +185,29 @@ namespace TrenchBroom {
                 m_dirtyRange.expand(newSize);
             }
 
+            /**
+             * Reduces the number of elements. This requires a new VBO, so the next call to prepare() uploads
+             * everything.
+             */
+            void shrink(const size_t newSize) {
+                assert(newSize < m_snapshot.size());
+                m_snapshot.resize(newSize);
+                m_snapshot.shrink_to_fit();
+                m_dirtyRange = DirtyRangeTracker(newSize, coalesceDistance());
+                m_dirtyRange.markDirty(0, newSize);
+            }
+
+            /**
+             * Moves the given number of elements from one position to another. The ranges may overlap.
+             */
+            void moveElements(const size_t fromOffset, const size_t toOffset, const size_t elementCount) {
+                assert(fromOffset + elementCount <= m_snapshot.size());
+                assert(toOffset + elementCount <= m_snapshot.size());
+
+                m_dirtyRange.markDirty(toOffset, elementCount);
+                std::memmove(m_snapshot.data() + toOffset, m_snapshot.data() + fromOffset, elementCount * sizeof(T));
+            }
+
             T* getPointerToWriteElementsTo(const size_t offsetWithinBlock, const size_t elementCount) {
                 assert(offsetWithinBlock + elementCount <= m_snapshot.size());
 
@@ -183,16 +249,11 @@ namespace TrenchBroom {
                 // otherwise, it's an incremental update of the dirty ranges.
 
                 if (!m_dirtyRange.clean()) {
-                    const size_t pos = m_dirtyRange.m_dirtyPos;
-                    const size_t size = m_dirtyRange.m_dirtySize;
-
-                    const size_t bytesFromStart = pos * sizeof(T);
-                    m_vbo->writeArray(bytesFromStart,
-                                      m_snapshot.data() + pos,
-                                      size);
+                    const size_t bytes = m_vbo->writeArrayRanges(m_snapshot.data(), m_dirtyRange.dirtyRanges());
+                    m_vboManager->addUploadedBytes(bytes);
                 }
 
-                m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+                m_dirtyRange.reset();
                 assert(prepared());
             }
 
@@ -225,6 +286,21 @@ namespace TrenchBroom {
             void zeroRange(size_t offsetWithinBlock, size_t count);
             void render(PrimType primType, size_t offset, size_t count) const;
 
+            /**
+             * Renders multiple ranges of indices with a single draw call.
+             *
+             * @param primType the primitive type to render
+             * @param counts the number of indices in each range
+             * @param offsets the offsets of the ranges as returned by offsetPointer
+             */
+            void render(PrimType primType, const GLCounts& counts, const std::vector<const GLvoid*>& offsets) const;
+
+            /**
+             * Converts the given element offset into the form expected by the OpenGL draw functions. Only valid while
+             * the VBO is not reallocated.
+             */
+            const GLvoid* offsetPointer(size_t offset) const;
+
             static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
         };
 
@@ -236,6 +312,16 @@ namespace TrenchBroom {
         private:
             IndexHolder m_indexHolder;
             AllocationTracker m_allocationTracker;
+
+            /**
+             * The allocations merged into ranges to render with a single call to glMultiDrawElements. The commands are
+             * updated whenever an allocation changes, and the counts and offsets passed to OpenGL are converted from
+             * them in prepare().
+             */
+            DrawCommandList m_drawCommands;
+            GLCounts m_drawCounts;
+            std::vector<const GLvoid*> m_drawOffsets;
+            bool m_drawCommandsValid;
         public:
             BrushIndexArray();
 
@@ -259,12 +345,31 @@ namespace TrenchBroom {
              */
             void zeroElementsWithKey(AllocationTracker::Block* key);
 
+            /**
+             * Adds the given offset to the indices of the allocation with the given key. Used to update the indices
+             * after the vertices they refer to were relocated.
+             */
+            void offsetElementsWithKey(const AllocationTracker::Block* key, GLint offset);
+
+            AllocationTracker::Stats stats() const;
+
+            /**
+             * Incrementally closes the gaps between the allocations, moving at most approximately `maxElements` indices,
+             * and shrinks the array once all free space is at its end. Does nothing unless the array is at least twice
+             * as large as its contents.
+             *
+             * @return the number of moved indices
+             */
+            size_t defragment(size_t maxElements);
+
             void render(const PrimType primType) const;
             bool prepared() const;
             void prepare(VboManager& vboManager);
 
             void setupIndices();
             void cleanupIndices();
+        private:
+            void updateDrawCommands();
         };
 
         class VertexArrayInterface {
@@ -313,9 +418,13 @@ namespace TrenchBroom {
          * the deleted memory in the VBO, while BrushIndexArray's does.
          */
         class BrushVertexArray {
+        public:
+            /**
+             * The third texture coordinate is the texture array layer and the color is the average color of the face's
+             * texture. Both are only set for faces whose texture is packed into a texture array, see FaceRenderer.
+             */
+            using Vertex = Renderer::GLVertexTypes::P3NT3C4UB::Vertex;
         private:
-            using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
-
             VertexHolder<Vertex> m_vertexHolder;
             AllocationTracker m_allocationTracker;
         public:
@@ -333,6 +442,19 @@ namespace TrenchBroom {
 
             void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+            AllocationTracker::Stats stats() const;
+
+            /**
+             * Incrementally closes the gaps between the allocations, moving at most approximately `maxElements`
+             * vertices, and shrinks the array once all free space is at its end. Does nothing unless the array is at
+             * least twice as large as its contents.
+             *
+             * The caller must update the indices referring to the relocated vertices.
+             *
+             * @return the relocated allocations
+             */
+            std::vector<AllocationTracker::Relocation> defragment(size_t maxElements);
+
             // setting up GL attributes
             bool setupVertices();
             void cleanupVertices();
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DrawCommands.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        bool DrawCommand::operator==(const DrawCommand& other) const {
+            return offset == other.offset && count == other.count;
+        }
+
+        DrawCommandList::DrawCommandList(const size_t maxGap) :
+        m_maxGap(maxGap) {}
+
+        void DrawCommandList::add(const size_t offset, const size_t count) {
+            const auto end = offset + count;
+
+            // the first command that starts after the given offset
+            auto it = std::upper_bound(std::begin(m_commands), std::end(m_commands), offset, [](const size_t o, const DrawCommand& command) {
+                return o < command.offset;
+            });
+
+            if (it != std::begin(m_commands) && std::prev(it)->offset + std::prev(it)->count + m_maxGap >= offset) {
+                it = std::prev(it);
+                it->count = std::max(it->offset + it->count, end) - it->offset;
+            } else {
+                it = m_commands.insert(it, DrawCommand{offset, count});
+            }
+
+            // merge the following commands that are now close enough
+            auto next = std::next(it);
+            auto last = next;
+            while (last != std::end(m_commands) && it->offset + it->count + m_maxGap >= last->offset) {
+                it->count = std::max(it->offset + it->count, last->offset + last->count) - it->offset;
+                ++last;
+            }
+            m_commands.erase(next, last);
+        }
+
+        void DrawCommandList::remove(const size_t offset, const size_t count) {
+            // the command containing the given range
+            auto it = std::upper_bound(std::begin(m_commands), std::end(m_commands), offset, [](const size_t o, const DrawCommand& command) {
+                return o < command.offset;
+            });
+            assert(it != std::begin(m_commands));
+            it = std::prev(it);
+            assert(offset + count <= it->offset + it->count);
+
+            if (it->offset == offset && it->count == count) {
+                m_commands.erase(it);
+            } else if (it->offset == offset) {
+                it->offset += count;
+                it->count -= count;
+            } else if (it->offset + it->count == offset + count) {
+                it->count -= count;
+            }
+        }
+
+        void DrawCommandList::truncate(const size_t end) {
+            while (!m_commands.empty() && m_commands.back().offset >= end) {
+                m_commands.pop_back();
+            }
+            if (!m_commands.empty()) {
+                auto& last = m_commands.back();
+                last.count = std::min(last.offset + last.count, end) - last.offset;
+            }
+        }
+
+        const std::vector<DrawCommand>& DrawCommandList::commands() const {
+            return m_commands;
+        }
+    }
+}
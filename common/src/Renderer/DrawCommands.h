@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * A range of indices in an index buffer to render.
+         */
+        struct DrawCommand {
+            size_t offset;
+            size_t count;
+
+            bool operator==(const DrawCommand& other) const;
+        };
+
+        /**
+         * The draw commands for an index buffer which contains valid indices only in the ranges added to this list.
+         * All other indices must be zero so that they form degenerate primitives.
+         *
+         * Ranges that are at most `maxGap` indices apart are merged into one command because rendering a few degenerate
+         * primitives is cheaper than submitting another command. The commands are updated incrementally as ranges are
+         * added and removed, so the cost of a change depends on the number of commands and not on the number of ranges.
+         */
+        class DrawCommandList {
+        private:
+            size_t m_maxGap;
+            std::vector<DrawCommand> m_commands;
+        public:
+            /**
+             * Creates an empty list.
+             *
+             * @param maxGap the maximum number of degenerate indices to render between two ranges
+             */
+            explicit DrawCommandList(size_t maxGap);
+
+            /**
+             * Adds a range of valid indices. The range must not overlap any range that was added before and not removed
+             * since, but it may lie within a command, e.g. if it reuses the space of a removed range.
+             */
+            void add(size_t offset, size_t count);
+
+            /**
+             * Removes a range of valid indices that was added before. The indices of the range must be zeroed by the
+             * caller. The commands are trimmed if the range is at the start or the end of its command, and the command
+             * is removed if it consists only of the range. A range in the middle of a command remains part of it and
+             * is rendered as degenerate primitives.
+             */
+            void remove(size_t offset, size_t count);
+
+            /**
+             * Shortens the commands so that none of them extends past the given end. Must be called when the index
+             * buffer shrinks because trimming a command in remove() can leave degenerate indices at its end.
+             */
+            void truncate(size_t end);
+
+            /**
+             * Returns the draw commands, sorted by offset and not overlapping.
+             */
+            const std::vector<DrawCommand>& commands() const;
+        };
+    }
+}
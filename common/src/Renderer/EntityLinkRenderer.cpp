@@ -42,6 +42,8 @@
 #include <kdl/overload.h>
 
 #include <vecmath/vec.h>
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
 
 #include <cassert>
 #include <unordered_set>
@@ -53,6 +55,7 @@ namespace TrenchBroom {
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
+        m_linkGroupsValid(false),
         m_valid(false) {}
 
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
@@ -74,9 +77,43 @@ namespace TrenchBroom {
         }
 
         void EntityLinkRenderer::invalidate() {
+            m_linkGroups.clear();
+            m_sourcesByTarget.clear();
+            m_invalidSources.clear();
+            m_linkGroupsValid = false;
             m_valid = false;
         }
 
+        void EntityLinkRenderer::invalidateNodes(const std::vector<Model::Node*>& nodes) {
+            if (!m_linkGroupsValid) {
+                invalidate();
+                return;
+            }
+
+            auto invalidateAll = false;
+            Model::Node::visitAll(nodes, kdl::overload(
+                [&](Model::WorldNode*) { invalidateAll = true; },
+                [] (Model::LayerNode*) {},
+                [&](Model::GroupNode*) { invalidateAll = true; },
+                [&](Model::EntityNode* entity) { invalidateSource(entity); },
+                [&](Model::BrushNode* brush) {
+                    brush->parent()->accept(kdl::overload(
+                        [] (Model::WorldNode*) {},
+                        [] (Model::LayerNode*) {},
+                        [] (Model::GroupNode*) {},
+                        [&](Model::EntityNode* entity) { invalidateSource(entity); },
+                        [] (Model::BrushNode*) {}
+                    ));
+                }
+            ));
+
+            if (invalidateAll) {
+                invalidate();
+            } else {
+                m_valid = false;
+            }
+        }
+
         void EntityLinkRenderer::doPrepareVertices(VboManager& vboManager) {
             if (!m_valid) {
                 validate();
@@ -89,55 +126,182 @@ namespace TrenchBroom {
 
         void EntityLinkRenderer::doRender(RenderContext& renderContext) {
             assert(m_valid);
-            renderLines(renderContext);
-            renderArrows(renderContext);
+
+            GLIndices linkIndices, arrowIndices;
+            GLCounts linkCounts, arrowCounts;
+            collectVisibleGroups(renderContext.camera(), linkIndices, linkCounts, arrowIndices, arrowCounts);
+
+            if (!linkIndices.empty()) {
+                renderLines(renderContext, linkIndices, linkCounts);
+                renderArrows(renderContext, arrowIndices, arrowCounts);
+            }
+        }
+
+        static bool outsideOfFrustum(const vm::bbox3f& bounds, const vm::plane3f (&frustumPlanes)[4]) {
+            for (const auto& plane : frustumPlanes) {
+                // the corner of the bounds that is furthest behind the plane
+                const auto corner = vm::vec3f(
+                    plane.normal.x() >= 0.0f ? bounds.min.x() : bounds.max.x(),
+                    plane.normal.y() >= 0.0f ? bounds.min.y() : bounds.max.y(),
+                    plane.normal.z() >= 0.0f ? bounds.min.z() : bounds.max.z());
+                if (plane.point_distance(corner) > 0.0f) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void EntityLinkRenderer::collectVisibleGroups(const Camera& camera, GLIndices& linkIndices, GLCounts& linkCounts, GLIndices& arrowIndices, GLCounts& arrowCounts) const {
+            vm::plane3f frustumPlanes[4];
+            camera.frustumPlanes(frustumPlanes[0], frustumPlanes[1], frustumPlanes[2], frustumPlanes[3]);
+
+            for (size_t i = 0; i < m_groupBounds.size(); ++i) {
+                if (!outsideOfFrustum(m_groupBounds[i], frustumPlanes)) {
+                    linkIndices.push_back(m_linkIndices[i]);
+                    linkCounts.push_back(m_linkCounts[i]);
+                    arrowIndices.push_back(m_arrowIndices[i]);
+                    arrowCounts.push_back(m_arrowCounts[i]);
+                }
+            }
         }
 
-        void EntityLinkRenderer::renderLines(RenderContext& renderContext) {
+        void EntityLinkRenderer::renderLines(RenderContext& renderContext, const GLIndices& indices, const GLCounts& counts) {
             ActiveShader shader(renderContext.shaderManager(), Shaders::EntityLinkShader);
             shader.set("CameraPosition", renderContext.camera().position());
             shader.set("IsOrtho", renderContext.camera().orthographicProjection());
             shader.set("MaxDistance", 6000.0f);
 
+            const auto primCount = static_cast<GLint>(indices.size());
+
             glAssert(glDisable(GL_DEPTH_TEST));
             shader.set("Alpha", 0.4f);
-            m_entityLinks.render(PrimType::Lines);
+            m_entityLinks.render(PrimType::Lines, indices, counts, primCount);
 
             glAssert(glEnable(GL_DEPTH_TEST));
             shader.set("Alpha", 1.0f);
-            m_entityLinks.render(PrimType::Lines);
+            m_entityLinks.render(PrimType::Lines, indices, counts, primCount);
         }
 
-        void EntityLinkRenderer::renderArrows(RenderContext& renderContext) {
+        void EntityLinkRenderer::renderArrows(RenderContext& renderContext, const GLIndices& indices, const GLCounts& counts) {
             ActiveShader shader(renderContext.shaderManager(), Shaders::EntityLinkArrowShader);
             shader.set("CameraPosition", renderContext.camera().position());
             shader.set("IsOrtho", renderContext.camera().orthographicProjection());
             shader.set("MaxDistance", 6000.0f);
             shader.set("Zoom", renderContext.camera().zoom());
 
+            const auto primCount = static_cast<GLint>(indices.size());
+
             glAssert(glDisable(GL_DEPTH_TEST));
             shader.set("Alpha", 0.4f);
-            m_entityLinkArrows.render(PrimType::Lines);
+            m_entityLinkArrows.render(PrimType::Lines, indices, counts, primCount);
 
             glAssert(glEnable(GL_DEPTH_TEST));
             shader.set("Alpha", 1.0f);
-            m_entityLinkArrows.render(PrimType::Lines);
+            m_entityLinkArrows.render(PrimType::Lines, indices, counts, primCount);
         }
 
         void EntityLinkRenderer::validate() {
+            LinkGroupMap groups;
+            getLinks(groups);
+            addLinkGroups(groups);
+
+            size_t linkCount = 0u, arrowCount = 0u;
+            for (const auto& [source, group] : m_linkGroups) {
+                linkCount += group.links.size();
+                arrowCount += group.arrows.size();
+            }
+
             std::vector<Vertex> links;
-            getLinks(links);
+            links.reserve(linkCount);
 
-            // build the arrows before destroying `links`
             std::vector<ArrowVertex> arrows;
-            getArrows(arrows, links);
+            arrows.reserve(arrowCount);
+
+            m_groupBounds.clear();
+            m_linkIndices.clear();
+            m_linkCounts.clear();
+            m_arrowIndices.clear();
+            m_arrowCounts.clear();
+
+            for (const auto& [source, group] : m_linkGroups) {
+                m_groupBounds.push_back(group.bounds.bounds());
+
+                m_linkIndices.push_back(static_cast<GLint>(links.size()));
+                m_linkCounts.push_back(static_cast<GLsizei>(group.links.size()));
+                links.insert(std::end(links), std::begin(group.links), std::end(group.links));
+
+                m_arrowIndices.push_back(static_cast<GLint>(arrows.size()));
+                m_arrowCounts.push_back(static_cast<GLsizei>(group.arrows.size()));
+                arrows.insert(std::end(arrows), std::begin(group.arrows), std::end(group.arrows));
+            }
 
             m_entityLinks = VertexArray::move(std::move(links));
             m_entityLinkArrows = VertexArray::move(std::move(arrows));
 
+            if (!m_linkGroupsValid) {
+                // the link groups are only kept in the "all" link mode
+                m_linkGroups.clear();
+                m_sourcesByTarget.clear();
+            }
+
             m_valid = true;
         }
 
+        void EntityLinkRenderer::invalidateSource(Model::EntityNodeBase* source) {
+            // the links of the given entity
+            removeLinkGroup(source);
+            m_invalidSources.insert(source);
+
+            // the links that currently point at the given entity, since its anchor may have moved
+            for (auto* linkSource : source->linkSources()) {
+                removeLinkGroup(linkSource);
+                m_invalidSources.insert(linkSource);
+            }
+            for (auto* killSource : source->killSources()) {
+                removeLinkGroup(killSource);
+                m_invalidSources.insert(killSource);
+            }
+
+            // the links that pointed at the given entity before it was changed
+            const auto it = m_sourcesByTarget.find(source);
+            if (it != std::end(m_sourcesByTarget)) {
+                const auto previousSources = it->second;
+                for (auto* previousSource : previousSources) {
+                    removeLinkGroup(previousSource);
+                    m_invalidSources.insert(previousSource);
+                }
+            }
+        }
+
+        void EntityLinkRenderer::removeLinkGroup(Model::EntityNodeBase* source) {
+            const auto groupIt = m_linkGroups.find(source);
+            if (groupIt == std::end(m_linkGroups)) {
+                return;
+            }
+
+            for (const auto* target : groupIt->second.targets) {
+                const auto sourcesIt = m_sourcesByTarget.find(target);
+                if (sourcesIt != std::end(m_sourcesByTarget)) {
+                    sourcesIt->second.erase(source);
+                    if (sourcesIt->second.empty()) {
+                        m_sourcesByTarget.erase(sourcesIt);
+                    }
+                }
+            }
+
+            m_linkGroups.erase(groupIt);
+        }
+
+        void EntityLinkRenderer::addLinkGroups(LinkGroupMap& groups) {
+            for (auto& [source, group] : groups) {
+                getArrows(group.arrows, group.links);
+                for (const auto* target : group.targets) {
+                    m_sourcesByTarget[target].insert(source);
+                }
+                m_linkGroups[source] = std::move(group);
+            }
+        }
+
         void EntityLinkRenderer::getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links) {
             assert((links.size() % 2) == 0);
             for (size_t i = 0; i < links.size(); i += 2) {
@@ -184,31 +348,38 @@ namespace TrenchBroom {
                 const Model::EditorContext& m_editorContext;
                 const Color m_defaultColor;
                 const Color m_selectedColor;
-                std::vector<EntityLinkRenderer::Vertex>& m_links;
+                EntityLinkRenderer::LinkGroupMap& m_groups;
             protected:
-                CollectLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<EntityLinkRenderer::Vertex>& links) :
+                CollectLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, EntityLinkRenderer::LinkGroupMap& groups) :
                 m_editorContext(editorContext),
                 m_defaultColor(defaultColor),
                 m_selectedColor(selectedColor),
-                m_links(links) {}
+                m_groups(groups) {}
             public:
                 virtual ~CollectLinksVisitor() = default;
                 virtual void visit(Model::EntityNodeBase* node) = 0;
             protected:
-                void addLink(const Model::EntityNodeBase* source, const Model::EntityNodeBase* target) {
+                void addLink(Model::EntityNodeBase* source, const Model::EntityNodeBase* target) {
                     const auto anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
                     const auto& sourceColor = anySelected ? m_selectedColor : m_defaultColor;
                     const auto targetColor = anySelected ? m_selectedColor : m_defaultColor;
 
-                    m_links.emplace_back(vm::vec3f(source->linkSourceAnchor()), sourceColor);
-                    m_links.emplace_back(vm::vec3f(target->linkTargetAnchor()), targetColor);
+                    const auto sourceAnchor = vm::vec3f(source->linkSourceAnchor());
+                    const auto targetAnchor = vm::vec3f(target->linkTargetAnchor());
+
+                    auto& group = m_groups[source];
+                    group.links.emplace_back(sourceAnchor, sourceColor);
+                    group.links.emplace_back(targetAnchor, targetColor);
+                    group.targets.push_back(target);
+                    group.bounds.add(sourceAnchor);
+                    group.bounds.add(targetAnchor);
                 }
             };
 
             class CollectAllLinksVisitor : public CollectLinksVisitor {
             public:
-                CollectAllLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<EntityLinkRenderer::Vertex>& links) :
-                CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+                CollectAllLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, EntityLinkRenderer::LinkGroupMap& groups) :
+                CollectLinksVisitor(editorContext, defaultColor, selectedColor, groups) {}
 
                 void visit(Model::EntityNodeBase* node) override {
                     if (m_editorContext.visible(node)) {
@@ -229,8 +400,8 @@ namespace TrenchBroom {
             private:
                 std::unordered_set<Model::Node*> m_visited;
             public:
-                CollectTransitiveSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<EntityLinkRenderer::Vertex>& links) :
-                CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+                CollectTransitiveSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, EntityLinkRenderer::LinkGroupMap& groups) :
+                CollectLinksVisitor(editorContext, defaultColor, selectedColor, groups) {}
 
                 void visit(Model::EntityNodeBase* node) override {
                     if (m_editorContext.visible(node)) {
@@ -265,8 +436,8 @@ namespace TrenchBroom {
 
             struct CollectDirectSelectedLinksVisitor : public CollectLinksVisitor {
             public:
-                CollectDirectSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<EntityLinkRenderer::Vertex>& links) :
-                CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+                CollectDirectSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, EntityLinkRenderer::LinkGroupMap& groups) :
+                CollectLinksVisitor(editorContext, defaultColor, selectedColor, groups) {}
                 
                 void visit(Model::EntityNodeBase* node) override {
                     if (node->selected() || node->descendantSelected()) {
@@ -278,7 +449,7 @@ namespace TrenchBroom {
                 }
             private:
                 void addSources(const std::vector<Model::EntityNodeBase*>& sources, Model::EntityNodeBase* target) {
-                    for (const Model::EntityNodeBase* source : sources) {
+                    for (Model::EntityNodeBase* source : sources) {
                         if (!source->selected() && !source->descendantSelected() && m_editorContext.visible(source))
                             addLink(source, target);
                     }
@@ -293,23 +464,32 @@ namespace TrenchBroom {
             };
         }
 
-        void EntityLinkRenderer::getLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getLinks(LinkGroupMap& groups) {
             const QString entityLinkMode = pref(Preferences::EntityLinkMode);
 
             if (entityLinkMode == Preferences::entityLinkModeAll()) {
-                getAllLinks(links);
-            } else if (entityLinkMode == Preferences::entityLinkModeTransitive()) {
-                getTransitiveSelectedLinks(links);
-            } else if (entityLinkMode == Preferences::entityLinkModeDirect()) {
-                getDirectSelectedLinks(links);
+                if (m_linkGroupsValid) {
+                    getInvalidLinks(groups);
+                } else {
+                    getAllLinks(groups);
+                    m_linkGroupsValid = true;
+                }
+            } else {
+                m_linkGroupsValid = false;
+                if (entityLinkMode == Preferences::entityLinkModeTransitive()) {
+                    getTransitiveSelectedLinks(groups);
+                } else if (entityLinkMode == Preferences::entityLinkModeDirect()) {
+                    getDirectSelectedLinks(groups);
+                }
             }
+            m_invalidSources.clear();
         }
 
-        void EntityLinkRenderer::getAllLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getAllLinks(LinkGroupMap& groups) {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
 
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, groups);
 
             if (document->world() != nullptr) {
                 document->world()->accept(kdl::overload(
@@ -330,6 +510,26 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityLinkRenderer::getInvalidLinks(LinkGroupMap& groups) {
+            auto document = kdl::mem_lock(m_document);
+            const Model::EditorContext& editorContext = document->editorContext();
+
+            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, groups);
+
+            // only entities are link sources, see getAllLinks
+            for (auto* source : m_invalidSources) {
+                source->accept(kdl::overload(
+                    [] (Model::WorldNode*) {},
+                    [] (Model::LayerNode*) {},
+                    [] (Model::GroupNode*) {},
+                    [&](Model::EntityNode* entity) {
+                        collectLinks.visit(entity);
+                    },
+                    [] (Model::BrushNode*) {}
+                ));
+            }
+        }
+
         static void collectSelectedLinks(const Model::NodeCollection& selectedNodes, CollectLinksVisitor& collectLinks) {
             for (auto* node : selectedNodes) {
                 node->accept(kdl::overload(
@@ -346,19 +546,19 @@ namespace TrenchBroom {
             }
         }
 
-        void EntityLinkRenderer::getTransitiveSelectedLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getTransitiveSelectedLinks(LinkGroupMap& groups) const {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
 
-            CollectTransitiveSelectedLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectTransitiveSelectedLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, groups);
             collectSelectedLinks(document->selectedNodes(), collectLinks);
         }
 
-        void EntityLinkRenderer::getDirectSelectedLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getDirectSelectedLinks(LinkGroupMap& groups) const {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
 
-            CollectDirectSelectedLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectDirectSelectedLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, groups);
             collectSelectedLinks(document->selectedNodes(), collectLinks);
         }
     }
@@ -20,22 +20,32 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/GL.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/bbox.h>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Model {
+        class EntityNodeBase;
+        class Node;
+    }
+
     namespace View {
         class MapDocument; // FIXME: Renderer should not depend on View
     }
 
     namespace Renderer {
+        class Camera;
         class RenderBatch;
         class RenderContext;
 
@@ -55,15 +65,43 @@ namespace TrenchBroom {
                     GLVertexAttributeTypes::C4,  // arrow color (exposed in shader as gl_Color)
                     GLVertexAttributeUser<ArrowPositionName, GL_FLOAT, 3, false>,          // arrow position
                     GLVertexAttributeUser<LineDirName,       GL_FLOAT, 3, false>>::Vertex; // direction the arrow is pointing
+        public:
+            /**
+             * The links that originate at one source entity, together with their arrows and their bounds.
+             */
+            struct LinkGroup {
+                std::vector<Vertex> links;
+                std::vector<ArrowVertex> arrows;
+                std::vector<const Model::EntityNodeBase*> targets;
+                vm::bbox3f::builder bounds;
+            };
 
+            using LinkGroupMap = std::unordered_map<Model::EntityNodeBase*, LinkGroup>;
+        private:
             std::weak_ptr<View::MapDocument> m_document;
 
             Color m_defaultColor;
             Color m_selectedColor;
 
+            /*
+             * In the "all" link mode, the link groups are kept between validations, and only the groups of changed
+             * entities are rebuilt. In the other modes, the groups are rebuilt from the selection on every validation.
+             */
+            LinkGroupMap m_linkGroups;
+            std::unordered_map<const Model::EntityNodeBase*, std::unordered_set<Model::EntityNodeBase*>> m_sourcesByTarget;
+            std::unordered_set<Model::EntityNodeBase*> m_invalidSources;
+            bool m_linkGroupsValid;
+
             VertexArray m_entityLinks;
             VertexArray m_entityLinkArrows;
 
+            // the vertex ranges and bounds of the uploaded link groups, used for culling
+            std::vector<vm::bbox3f> m_groupBounds;
+            GLIndices m_linkIndices;
+            GLCounts m_linkCounts;
+            GLIndices m_arrowIndices;
+            GLCounts m_arrowCounts;
+
             bool m_valid;
         public:
             EntityLinkRenderer(std::weak_ptr<View::MapDocument> document);
@@ -73,21 +111,42 @@ namespace TrenchBroom {
 
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+
+            /**
+             * Invalidates only the links that are affected by changes to the given nodes. These are the links of the
+             * changed entities and the links that point at them.
+             */
+            void invalidateNodes(const std::vector<Model::Node*>& nodes);
+
+            /**
+             * Rebuilds the invalid link groups and the vertices of all links. The vertices are uploaded when this
+             * renderer is prepared for rendering.
+             */
+            void validate();
+
+            /**
+             * Collects the vertex ranges of the link groups whose bounds intersect the view frustum of the given
+             * camera. Each link group contributes one range of link vertices and one range of arrow vertices.
+             */
+            void collectVisibleGroups(const Camera& camera, GLIndices& linkIndices, GLCounts& linkCounts, GLIndices& arrowIndices, GLCounts& arrowCounts) const;
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
-            void renderLines(RenderContext& renderContext);
-            void renderArrows(RenderContext& renderContext);
+            void renderLines(RenderContext& renderContext, const GLIndices& indices, const GLCounts& counts);
+            void renderArrows(RenderContext& renderContext, const GLIndices& indices, const GLCounts& counts);
         private:
-            void validate();
+            void invalidateSource(Model::EntityNodeBase* source);
+            void removeLinkGroup(Model::EntityNodeBase* source);
+            void addLinkGroups(LinkGroupMap& groups);
 
             static void getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links);
             static void addArrow(std::vector<ArrowVertex>& arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir);
 
-            void getLinks(std::vector<Vertex>& links) const;
-            void getAllLinks(std::vector<Vertex>& links) const;
-            void getTransitiveSelectedLinks(std::vector<Vertex>& links) const;
-            void getDirectSelectedLinks(std::vector<Vertex>& links) const;
+            void getLinks(LinkGroupMap& groups);
+            void getAllLinks(LinkGroupMap& groups);
+            void getInvalidLinks(LinkGroupMap& groups);
+            void getTransitiveSelectedLinks(LinkGroupMap& groups) const;
+            void getDirectSelectedLinks(LinkGroupMap& groups) const;
 
             EntityLinkRenderer(const EntityLinkRenderer& other);
             EntityLinkRenderer& operator=(const EntityLinkRenderer& other);
@@ -24,6 +24,7 @@
 #include "Preferences.h"
 #include "Assets/AssetUtils.h"
 #include "Assets/EntityModel.h"
+#include "Assets/EntityModelLod.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/ModelDefinition.h"
 #include "EL/ELExceptions.h"
@@ -31,26 +32,120 @@
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Renderer/ActiveShader.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderUtils.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 #include "Renderer/Transformation.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboManager.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
 
 namespace TrenchBroom {
     namespace Renderer {
+        struct EntityModelRenderer::InstanceFunc : public InstanceRenderFunc {
+            ActiveShader& shader;
+            Transformation& transformation;
+            const Instance* instances;
+            size_t count;
+
+            InstanceFunc(ActiveShader& i_shader, Transformation& i_transformation, const Instance* i_instances, const size_t i_count) :
+            shader(i_shader),
+            transformation(i_transformation),
+            instances(i_instances),
+            count(i_count) {}
+
+            size_t instanceCount() const override {
+                return count;
+            }
+
+            void before(const size_t instance) override {
+                const auto& modelMatrix = instances[instance].modelMatrix;
+                transformation.pushModelMatrix(modelMatrix);
+                shader.set("ModelMatrix", modelMatrix);
+            }
+
+            void after(const size_t /* instance */) override {
+                transformation.popModelMatrix();
+            }
+        };
+
+        // the names of the attributes that receive the columns of the model matrix, see EntityModelInstanced.vertsh
+        static const std::string InstanceMatrixAttributes[] = {
+            "InstanceMatrix0", "InstanceMatrix1", "InstanceMatrix2", "InstanceMatrix3"
+        };
+
+        /**
+         * Feeds the model matrices of the instances to the instanced entity model shader from the instance VBO, so that
+         * all instances are drawn with a single draw call per index range.
+         */
+        struct EntityModelRenderer::InstancedFunc : public InstanceFunc {
+            ShaderProgram& program;
+            Vbo& instanceVbo;
+            size_t firstInstance;
+
+            InstancedFunc(ActiveShader& i_shader, Transformation& i_transformation, const Instance* i_instances, const size_t i_count, ShaderProgram& i_program, Vbo& i_instanceVbo, const size_t i_firstInstance) :
+            InstanceFunc(i_shader, i_transformation, i_instances, i_count),
+            program(i_program),
+            instanceVbo(i_instanceVbo),
+            firstInstance(i_firstInstance) {}
+
+            bool setupInstances() override {
+                const auto stride = 16 * sizeof(float);
+                instanceVbo.bind();
+                for (size_t i = 0; i < 4; ++i) {
+                    const auto location = static_cast<GLuint>(program.findAttributeLocation(InstanceMatrixAttributes[i]));
+                    const auto offset = firstInstance * stride + i * 4 * sizeof(float);
+                    glAssert(glEnableVertexAttribArray(location));
+                    glAssert(glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride), reinterpret_cast<GLvoid*>(offset)));
+                    glAssert(glVertexAttribDivisorARB(location, 1));
+                }
+                instanceVbo.unbind();
+                return true;
+            }
+
+            void cleanupInstances() override {
+                for (size_t i = 0; i < 4; ++i) {
+                    const auto location = static_cast<GLuint>(program.findAttributeLocation(InstanceMatrixAttributes[i]));
+                    glAssert(glVertexAttribDivisorARB(location, 0));
+                    glAssert(glDisableVertexAttribArray(location));
+                }
+            }
+        };
+
+        /**
+         * Instanced rendering requires per instance vertex attributes and instanced draw calls.
+         */
+        static bool instancedRenderingSupported() {
+            return GLEW_ARB_draw_instanced && GLEW_ARB_instanced_arrays;
+        }
+
         EntityModelRenderer::EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
         m_logger(logger),
         m_entityModelManager(entityModelManager),
         m_editorContext(editorContext),
         m_applyTinting(false),
-        m_showHiddenEntities(false) {}
+        m_showHiddenEntities(false),
+        m_vboManager(nullptr),
+        m_instanceVbo(nullptr) {}
 
         EntityModelRenderer::~EntityModelRenderer() {
             clear();
+            if (m_instanceVbo != nullptr) {
+                m_vboManager->destroyVbo(m_instanceVbo);
+                m_instanceVbo = nullptr;
+            }
         }
 
         void EntityModelRenderer::addEntity(Model::EntityNode* entityNode) {
@@ -60,7 +155,7 @@ namespace TrenchBroom {
 
             auto* renderer = m_entityModelManager.renderer(modelSpec);
             if (renderer != nullptr) {
-                m_entities.insert(std::make_pair(entityNode, renderer));
+                m_entities.insert(std::make_pair(entityNode, LodRenderers{ modelSpec, renderer, std::nullopt, std::nullopt }));
             }
         }
 
@@ -77,12 +172,12 @@ namespace TrenchBroom {
             }
 
             if (it == std::end(m_entities)) {
-                m_entities.insert(std::make_pair(entityNode, renderer));
+                m_entities.insert(std::make_pair(entityNode, LodRenderers{ modelSpec, renderer, std::nullopt, std::nullopt }));
             } else {
                 if (renderer == nullptr) {
                     m_entities.erase(it);
-                } else if (it->second != renderer) {
-                    it->second = renderer;
+                } else if (it->second.full != renderer) {
+                    it->second = LodRenderers{ modelSpec, renderer, std::nullopt, std::nullopt };
                 }
             }
         }
@@ -115,18 +210,105 @@ namespace TrenchBroom {
             m_showHiddenEntities = showHiddenEntities;
         }
 
-        void EntityModelRenderer::render(RenderBatch& renderBatch) {
+        void EntityModelRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
+            // the instances are collected before the batch prepares its renderables so that any renderer that is
+            // requested for a level of detail for the first time is prepared before it is rendered
+            collectInstances(renderContext);
             renderBatch.add(this);
         }
 
+        TexturedRenderer* EntityModelRenderer::lodRenderer(LodRenderers& renderers, const Assets::EntityModelLod lod) const {
+            // fall back to the next more detailed level if a level is unavailable
+            switch (lod) {
+                case Assets::EntityModelLod::Proxy:
+                    if (!renderers.proxy) {
+                        renderers.proxy = m_entityModelManager.renderer(renderers.modelSpec, Assets::EntityModelLod::Proxy);
+                    }
+                    if (*renderers.proxy != nullptr) {
+                        return *renderers.proxy;
+                    }
+                    switchFallthrough();
+                case Assets::EntityModelLod::Simplified:
+                    if (!renderers.simplified) {
+                        renderers.simplified = m_entityModelManager.renderer(renderers.modelSpec, Assets::EntityModelLod::Simplified);
+                    }
+                    if (*renderers.simplified != nullptr) {
+                        return *renderers.simplified;
+                    }
+                    switchFallthrough();
+                case Assets::EntityModelLod::Full:
+                    return renderers.full;
+                switchDefault();
+            }
+        }
+
+        void EntityModelRenderer::collectInstances(RenderContext& renderContext) {
+            const auto useLod = PreferenceManager::instance().get(Preferences::EntityModelLevelOfDetail);
+            const auto& camera = renderContext.camera();
+
+            m_instances.clear();
+            for (auto& entry : m_entities) {
+                auto* entityNode = entry.first;
+                if (!m_showHiddenEntities && !m_editorContext.visible(entityNode)) {
+                    continue;
+                }
+
+                auto* renderer = entry.second.full;
+                if (useLod) {
+                    const auto bounds = vm::bbox3f(entityNode->modelBounds());
+                    const auto scalingFactor = camera.perspectiveScalingFactor(bounds.center());
+                    if (scalingFactor > 0.0f) {
+                        const auto projectedSize = vm::length(bounds.size()) / scalingFactor;
+                        renderer = lodRenderer(entry.second, Assets::selectEntityModelLod(projectedSize));
+                    }
+                }
+
+                m_instances.push_back({ renderer, vm::mat4x4f(entityNode->entity().modelTransformation()) });
+            }
+
+            // group the instances by renderer so that every model's vertices and skins are set up only once
+            m_instanceRanges = groupInstances(m_instances, [](const Instance& instance) { return instance.renderer; });
+        }
+
+        void EntityModelRenderer::uploadInstanceMatrices(VboManager& vboManager) {
+            m_instanceMatrices.clear();
+            for (const auto& instance : m_instances) {
+                for (size_t column = 0; column < 4; ++column) {
+                    for (size_t row = 0; row < 4; ++row) {
+                        m_instanceMatrices.push_back(instance.modelMatrix[column][row]);
+                    }
+                }
+            }
+
+            const auto size = m_instanceMatrices.size() * sizeof(float);
+            if (m_instanceVbo == nullptr || m_instanceVbo->capacity() < size) {
+                // grow the buffer geometrically so that it is not reallocated whenever another instance becomes visible
+                const auto capacity = std::max(size, m_instanceVbo != nullptr ? 2 * m_instanceVbo->capacity() : size_t(0));
+                if (m_instanceVbo != nullptr) {
+                    m_vboManager->destroyVbo(m_instanceVbo);
+                }
+                m_vboManager = &vboManager;
+                m_instanceVbo = vboManager.allocateVbo(VboType::ArrayBuffer, capacity, VboUsage::DynamicDraw);
+            }
+
+            const auto bytes = m_instanceVbo->writeBuffer(0, m_instanceMatrices);
+            vboManager.addUploadedBytes(bytes);
+        }
+
         void EntityModelRenderer::doPrepareVertices(VboManager& vboManager) {
             m_entityModelManager.prepare(vboManager);
+            if (!m_instances.empty() && instancedRenderingSupported()) {
+                uploadInstanceMatrices(vboManager);
+            }
         }
 
         void EntityModelRenderer::doRender(RenderContext& renderContext) {
             auto& prefs = PreferenceManager::instance();
 
-            ActiveShader shader(renderContext.shaderManager(), Shaders::EntityModelShader);
+            // the instance VBO is only uploaded if instanced rendering is supported
+            const auto instanced = m_instanceVbo != nullptr && instancedRenderingSupported();
+
+            ActiveShader shader(renderContext.shaderManager(), instanced ? Shaders::EntityModelInstancedShader : Shaders::EntityModelShader);
             shader.set("Brightness", prefs.get(Preferences::Brightness));
             shader.set("ApplyTinting", m_applyTinting);
             shader.set("TintColor", m_tintColor);
@@ -143,20 +325,19 @@ namespace TrenchBroom {
             glAssert(glEnable(GL_TEXTURE_2D));
             glAssert(glActiveTexture(GL_TEXTURE0));
 
-            for (const auto& entry : m_entities) {
-                auto* entityNode = entry.first;
-                if (!m_showHiddenEntities && !m_editorContext.visible(entityNode)) {
-                    continue;
+            DefaultTextureRenderFunc textureFunc;
+            for (const auto& range : m_instanceRanges) {
+                auto* renderer = m_instances[range.offset].renderer;
+                const auto* instances = m_instances.data() + range.offset;
+
+                if (instanced) {
+                    auto& program = *renderContext.shaderManager().currentProgram();
+                    InstancedFunc instanceFunc(shader, renderContext.transformation(), instances, range.count, program, *m_instanceVbo, range.offset);
+                    renderer->renderInstances(textureFunc, instanceFunc);
+                } else {
+                    InstanceFunc instanceFunc(shader, renderContext.transformation(), instances, range.count);
+                    renderer->renderInstances(textureFunc, instanceFunc);
                 }
-
-                auto* renderer = entry.second;
-
-                const auto transformation = entityNode->entity().modelTransformation();
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), vm::mat4x4f(transformation));
-
-                shader.set("ModelMatrix", vm::mat4x4f(transformation));
-
-                renderer->render();
             }
         }
     }
@@ -20,14 +20,22 @@
 #pragma once
 
 #include "Color.h"
+#include "Assets/ModelDefinition.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderUtils.h"
+
+#include <vecmath/forward.h>
+#include <vecmath/mat.h>
 
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
 
     namespace Assets {
+        enum class EntityModelLod;
         class EntityModelManager;
     }
 
@@ -38,11 +46,37 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class RenderBatch;
+        class RenderContext;
         class TexturedRenderer;
+        class Vbo;
 
         class EntityModelRenderer : public DirectRenderable {
         private:
-            using EntityMap = std::map<Model::EntityNode*, TexturedRenderer*>;
+            /**
+             * The renderers of an entity's model at each level of detail. Only the full renderer is guaranteed to be
+             * present. The other renderers are requested from the model manager when they are first needed, an empty
+             * optional means that this has not happened yet.
+             */
+            struct LodRenderers {
+                Assets::ModelSpecification modelSpec;
+                TexturedRenderer* full;
+                std::optional<TexturedRenderer*> simplified;
+                std::optional<TexturedRenderer*> proxy;
+            };
+
+            using EntityMap = std::map<Model::EntityNode*, LodRenderers>;
+
+            /**
+             * A visible model instance. Instances that share a renderer, i.e., the same model, frame, skin and level of
+             * detail, are rendered together.
+             */
+            struct Instance {
+                TexturedRenderer* renderer;
+                vm::mat4x4f modelMatrix;
+            };
+
+            struct InstanceFunc;
+            struct InstancedFunc;
 
             Logger& m_logger;
 
@@ -55,6 +89,15 @@ namespace TrenchBroom {
             Color m_tintColor;
 
             bool m_showHiddenEntities;
+
+            // the per instance transformations and the ranges of instances sharing a renderer, rebuilt every frame
+            std::vector<Instance> m_instances;
+            std::vector<InstanceRange> m_instanceRanges;
+
+            // the model matrices of all instances for instanced rendering, uploaded every frame
+            std::vector<float> m_instanceMatrices;
+            VboManager* m_vboManager;
+            Vbo* m_instanceVbo;
         public:
             EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
             ~EntityModelRenderer() override;
@@ -93,8 +136,12 @@ namespace TrenchBroom {
             bool showHiddenEntities() const;
             void setShowHiddenEntities(bool showHiddenEntities);
 
-            void render(RenderBatch& renderBatch);
+            void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
+            TexturedRenderer* lodRenderer(LodRenderers& renderers, Assets::EntityModelLod lod) const;
+            void collectInstances(RenderContext& renderContext);
+            void uploadInstanceMatrices(VboManager& vboManager);
+
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
         };
@@ -42,6 +42,7 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/scalar.h>
 
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -101,6 +102,18 @@ namespace TrenchBroom {
             m_modelRenderer.updateEntities(std::begin(m_entities), std::end(m_entities));
         }
 
+        void EntityRenderer::reloadModels(const std::vector<Model::EntityNode*>& entities) {
+            // the bounds of point entities may depend on their models
+            invalidateBounds();
+
+            const auto entitySet = std::unordered_set<Model::EntityNode*>(std::begin(entities), std::end(entities));
+            for (auto* entityNode : m_entities) {
+                if (entitySet.count(entityNode) > 0) {
+                    m_modelRenderer.updateEntity(entityNode);
+                }
+            }
+        }
+
         void EntityRenderer::setShowOverlays(const bool showOverlays) {
             m_showOverlays = showOverlays;
         }
@@ -203,7 +216,7 @@ namespace TrenchBroom {
                 m_modelRenderer.setApplyTinting(m_tint);
                 m_modelRenderer.setTintColor(m_tintColor);
                 m_modelRenderer.setShowHiddenEntities(m_showHiddenEntities);
-                m_modelRenderer.render(renderBatch);
+                m_modelRenderer.render(renderContext, renderBatch);
             }
         }
 
@@ -80,6 +80,12 @@ namespace TrenchBroom {
             void clear();
             void reloadModels();
 
+            /**
+             * Updates the models and bounds of the given entities. Entities that are not rendered by this renderer are
+             * ignored.
+             */
+            void reloadModels(const std::vector<Model::EntityNode*>& entities);
+
             void setShowOverlays(bool showOverlays);
             void setOverlayTextColor(const Color& overlayTextColor);
             void setOverlayBackgroundColor(const Color& overlayBackgroundColor);
@@ -32,6 +32,8 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 
+#include <utility>
+
 namespace TrenchBroom {
     namespace Renderer {
         struct FaceRenderer::RenderFunc : public TextureRenderFunc {
@@ -67,9 +69,10 @@ namespace TrenchBroom {
         m_tint(false),
         m_alpha(1.0f) {}
 
-        FaceRenderer::FaceRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap, const Color& faceColor) :
+        FaceRenderer::FaceRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap, std::shared_ptr<TextureArrayToBrushIndicesMap> arrayIndexArrayMap, const Color& faceColor) :
         m_vertexArray(std::move(vertexArray)),
         m_indexArrayMap(std::move(indexArrayMap)),
+        m_arrayIndexArrayMap(std::move(arrayIndexArrayMap)),
         m_faceColor(faceColor),
         m_grayscale(false),
         m_tint(false),
@@ -79,6 +82,7 @@ namespace TrenchBroom {
         IndexedRenderable(other),
         m_vertexArray(other.m_vertexArray),
         m_indexArrayMap(other.m_indexArrayMap),
+        m_arrayIndexArrayMap(other.m_arrayIndexArrayMap),
         m_faceColor(other.m_faceColor),
         m_grayscale(other.m_grayscale),
         m_tint(other.m_tint),
@@ -95,6 +99,7 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArrayMap, right.m_indexArrayMap);
+            swap(left.m_arrayIndexArrayMap, right.m_arrayIndexArrayMap);
             swap(left.m_faceColor, right.m_faceColor);
             swap(left.m_grayscale, right.m_grayscale);
             swap(left.m_tint, right.m_tint);
@@ -129,6 +134,10 @@ namespace TrenchBroom {
                 const auto& brushIndexHolderPtr = pair.second;
                 brushIndexHolderPtr->prepare(vboManager);
             }
+            for (const auto& pair : *m_arrayIndexArrayMap) {
+                const auto& brushIndexHolderPtr = pair.second;
+                brushIndexHolderPtr->prepare(vboManager);
+            }
         }
 
         vm::vec3f FaceRenderer::gridColorForTexture(const Assets::Texture* texture) {
@@ -146,70 +155,106 @@ namespace TrenchBroom {
             }
         }
 
+        void FaceRenderer::setupShader(ActiveShader& shader, RenderContext& context, const bool applyTexture) const {
+            PreferenceManager& prefs = PreferenceManager::instance();
+
+            shader.set("Brightness", prefs.get(Preferences::Brightness));
+            shader.set("RenderGrid", context.showGrid());
+            shader.set("GridSize", static_cast<float>(context.gridSize()));
+            shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
+            shader.set("ApplyTexture", applyTexture);
+            shader.set("Texture", 0);
+            shader.set("ApplyTinting", m_tint);
+            if (m_tint)
+                shader.set("TintColor", m_tintColor);
+            shader.set("GrayScale", m_grayscale);
+            shader.set("CameraPosition", context.camera().position());
+            shader.set("ShadeFaces", context.shadeFaces());
+            shader.set("ShowFog", context.showFog());
+            shader.set("Alpha", m_alpha);
+            shader.set("EnableMasked", false);
+            shader.set("ShowSoftMapBounds", !context.softMapBounds().is_empty());
+            shader.set("SoftMapBoundsMin", context.softMapBounds().min);
+            shader.set("SoftMapBoundsMax", context.softMapBounds().max);
+            shader.set("SoftMapBoundsColor", vm::vec4f(prefs.get(Preferences::SoftMapBoundsColor).r(),
+                                                       prefs.get(Preferences::SoftMapBoundsColor).g(),
+                                                       prefs.get(Preferences::SoftMapBoundsColor).b(),
+                                                       0.1f));
+        }
+
         void FaceRenderer::doRender(RenderContext& context) {
-            if (m_indexArrayMap->empty())
+            if (m_indexArrayMap->empty() && m_arrayIndexArrayMap->empty())
                 return;
 
             if (m_vertexArray->setupVertices()) {
-                ShaderManager& shaderManager = context.shaderManager();
-                ActiveShader shader(shaderManager, Shaders::FaceShader);
-                PreferenceManager& prefs = PreferenceManager::instance();
-
                 const bool applyTexture = context.showTextures();
-                const bool shadeFaces = context.shadeFaces();
-                const bool showFog = context.showFog();
 
                 glAssert(glEnable(GL_TEXTURE_2D));
                 glAssert(glActiveTexture(GL_TEXTURE0));
-                shader.set("Brightness", prefs.get(Preferences::Brightness));
-                shader.set("RenderGrid", context.showGrid());
-                shader.set("GridSize", static_cast<float>(context.gridSize()));
-                shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-                shader.set("ApplyTexture", applyTexture);
-                shader.set("Texture", 0);
-                shader.set("ApplyTinting", m_tint);
-                if (m_tint)
-                    shader.set("TintColor", m_tintColor);
-                shader.set("GrayScale", m_grayscale);
-                shader.set("CameraPosition", context.camera().position());
-                shader.set("ShadeFaces", shadeFaces);
-                shader.set("ShowFog", showFog);
-                shader.set("Alpha", m_alpha);
-                shader.set("EnableMasked", false);
-                shader.set("ShowSoftMapBounds", !context.softMapBounds().is_empty());
-                shader.set("SoftMapBoundsMin", context.softMapBounds().min);
-                shader.set("SoftMapBoundsMax", context.softMapBounds().max);
-                shader.set("SoftMapBoundsColor", vm::vec4f(prefs.get(Preferences::SoftMapBoundsColor).r(),
-                                                           prefs.get(Preferences::SoftMapBoundsColor).g(),
-                                                           prefs.get(Preferences::SoftMapBoundsColor).b(),
-                                                           0.1f));
-
-                RenderFunc func(shader, applyTexture, m_faceColor);
+
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_FALSE));
                 }
-                for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
-                    if (!brushIndexHolderPtr->hasValidIndices()) {
-                        continue;
-                    }
-
-                    const bool enableMasked = texture != nullptr && texture->masked();
-                    
-                    // set any per-texture uniforms
-                    shader.set("GridColor", gridColorForTexture(texture));
-                    shader.set("EnableMasked", enableMasked);
-
-                    func.before(texture);
-                    brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
-                    brushIndexHolderPtr->cleanupIndices();
-                    func.after(texture);
+
+                if (!m_indexArrayMap->empty()) {
+                    renderTextures(context, applyTexture);
+                }
+                if (!m_arrayIndexArrayMap->empty()) {
+                    renderTextureArrays(context, applyTexture);
                 }
+
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_TRUE));
                 }
                 m_vertexArray->cleanupVertices();
             }
         }
+
+        void FaceRenderer::renderTextures(RenderContext& context, const bool applyTexture) {
+            ActiveShader shader(context.shaderManager(), Shaders::FaceShader);
+            setupShader(shader, context, applyTexture);
+            shader.set("UseUniformColor", true);
+
+            RenderFunc func(shader, applyTexture, m_faceColor);
+            for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
+                if (!brushIndexHolderPtr->hasValidIndices()) {
+                    continue;
+                }
+
+                const bool enableMasked = texture != nullptr && texture->masked();
+
+                // set any per-texture uniforms
+                shader.set("GridColor", gridColorForTexture(texture));
+                shader.set("EnableMasked", enableMasked);
+
+                func.before(texture);
+                brushIndexHolderPtr->setupIndices();
+                brushIndexHolderPtr->render(PrimType::Triangles);
+                brushIndexHolderPtr->cleanupIndices();
+                func.after(texture);
+            }
+        }
+
+        void FaceRenderer::renderTextureArrays(RenderContext& context, const bool applyTexture) {
+            ActiveShader shader(context.shaderManager(), Shaders::FaceArrayShader);
+            setupShader(shader, context, applyTexture);
+
+            // the layer and the average color of each face's texture are passed with its vertices
+            shader.set("UseUniformColor", false);
+
+            // packed textures are opaque and use the default culling and blend modes, see TextureCollection
+            for (const auto& [arrayTextureId, brushIndexHolderPtr] : *m_arrayIndexArrayMap) {
+                if (!brushIndexHolderPtr->hasValidIndices()) {
+                    continue;
+                }
+
+                glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, arrayTextureId));
+                brushIndexHolderPtr->setupIndices();
+                brushIndexHolderPtr->render(PrimType::Triangles);
+                brushIndexHolderPtr->cleanupIndices();
+            }
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY_EXT, 0));
+        }
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/GL.h"
 #include "Renderer/Renderable.h"
 
 #include <vecmath/forward.h>
@@ -34,18 +35,27 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class ActiveShader;
         class BrushIndexArray;
         class BrushVertexArray;
         class RenderBatch;
 
+        /**
+         * Renders the faces of the textures in the given index array map with one draw call per texture. Faces whose
+         * textures are packed into a texture array are stored in a separate map with one index array per texture
+         * array, and each of these is rendered with one draw call. For these faces, the vertices provide the layer and
+         * the average color of the texture.
+         */
         class FaceRenderer : public IndexedRenderable {
         private:
             struct RenderFunc;
 
             using TextureToBrushIndicesMap = const std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+            using TextureArrayToBrushIndicesMap = const std::unordered_map<GLuint, std::shared_ptr<BrushIndexArray>>;
 
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> m_arrayIndexArrayMap;
             Color m_faceColor;
             bool m_grayscale;
             bool m_tint;
@@ -53,7 +63,7 @@ namespace TrenchBroom {
             float m_alpha;
         public:
             FaceRenderer();
-            FaceRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap, const Color& faceColor);
+            FaceRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap, std::shared_ptr<TextureArrayToBrushIndicesMap> arrayIndexArrayMap, const Color& faceColor);
 
             FaceRenderer(const FaceRenderer& other);
             FaceRenderer& operator=(FaceRenderer other);
@@ -69,6 +79,10 @@ namespace TrenchBroom {
         private:
             void prepareVerticesAndIndices(VboManager& vboManager) override;
             void doRender(RenderContext& context) override;
+
+            void setupShader(ActiveShader& shader, RenderContext& context, bool applyTexture) const;
+            void renderTextures(RenderContext& context, bool applyTexture);
+            void renderTextureArrays(RenderContext& context, bool applyTexture);
         };
 
         void swap(FaceRenderer& left, FaceRenderer& right);
@@ -181,7 +181,9 @@ namespace TrenchBroom {
             using P3  = GLVertexAttributePosition<GL_FLOAT, 3>;
             using N   = GLVertexAttributeNormal<GL_FLOAT, 3>;
             using T02 = GLVertexAttributeTexCoord0<GL_FLOAT, 2>;
+            using T03 = GLVertexAttributeTexCoord0<GL_FLOAT, 3>;
             using C4  = GLVertexAttributeColor<GL_FLOAT, 4>;
+            using C4UB = GLVertexAttributeColor<GL_UNSIGNED_BYTE, 4>;
         }
     }
 }
@@ -172,6 +172,7 @@ namespace TrenchBroom {
             using P3N    = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N>;
             using P3NC4  = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N, GLVertexAttributeTypes::C4>;
             using P3NT2  = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N, GLVertexAttributeTypes::T02>;
+            using P3NT3C4UB = GLVertexType<GLVertexAttributeTypes::P3, GLVertexAttributeTypes::N, GLVertexAttributeTypes::T03, GLVertexAttributeTypes::C4UB>;
         }
     }
 }
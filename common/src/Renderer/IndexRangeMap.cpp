@@ -22,8 +22,6 @@
 #include "Renderer/PrimType.h"
 #include "Renderer/VertexArray.h"
 
-#include <kdl/vector_utils.h>
-
 namespace TrenchBroom {
     namespace Renderer {
         IndexRangeMap::IndicesAndCounts::IndicesAndCounts() :
@@ -53,9 +51,10 @@ namespace TrenchBroom {
                 case PrimType::Lines:
                 case PrimType::Triangles:
                 case PrimType::Quads: {
-                    if (size() == 1) {
-                        const auto myIndex = indices.front();
-                        auto& myCount = counts.front();
+                    // independent primitives in adjacent ranges can be rendered as one range
+                    if (!empty()) {
+                        const auto myIndex = indices.back();
+                        auto& myCount = counts.back();
 
                         if (index == static_cast<size_t>(myIndex) + static_cast<size_t>(myCount)) {
                             myCount += static_cast<GLsizei>(count);
@@ -77,10 +76,11 @@ namespace TrenchBroom {
             }
         }
 
-        void IndexRangeMap::IndicesAndCounts::add(const IndicesAndCounts& other, [[maybe_unused]] const bool dynamicGrowth) {
+        void IndexRangeMap::IndicesAndCounts::add(const PrimType primType, const IndicesAndCounts& other, const bool dynamicGrowth) {
             assert(dynamicGrowth || indices.capacity() >= indices.size() + other.indices.size());
-            indices = kdl::vec_concat(std::move(indices), other.indices);
-            counts = kdl::vec_concat(std::move(counts), other.counts);
+            for (size_t i = 0; i < other.size(); ++i) {
+                add(primType, static_cast<size_t>(other.indices[i]), static_cast<size_t>(other.counts[i]), true);
+            }
         }
 
         void IndexRangeMap::Size::inc(const PrimType primType, const size_t count) {
@@ -133,7 +133,7 @@ namespace TrenchBroom {
                 const auto& indicesToAdd = other.m_data->get(primType);
 
                 auto& indicesAndCounts = m_data->get(primType);
-                indicesAndCounts.add(indicesToAdd, m_dynamicGrowth);
+                indicesAndCounts.add(primType, indicesToAdd, m_dynamicGrowth);
             }
         }
 
@@ -147,6 +147,16 @@ namespace TrenchBroom {
             }
         }
 
+        void IndexRangeMap::renderInstanced(VertexArray& vertexArray, const size_t instanceCount) const {
+            for (const auto& primType : PrimTypeValues) {
+                const auto& indicesAndCounts = m_data->get(primType);
+                if (!indicesAndCounts.empty()) {
+                    const auto primCount = static_cast<GLsizei>(indicesAndCounts.size());
+                    vertexArray.renderInstanced(primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount, static_cast<GLsizei>(instanceCount));
+                }
+            }
+        }
+
         void IndexRangeMap::forEachPrimitive(std::function<void(PrimType, size_t, size_t)> func) const {
             for (const auto& primType : PrimTypeValues) {
                 const auto& indicesAndCounts = m_data->get(primType);
@@ -55,7 +55,7 @@ namespace TrenchBroom {
                 size_t size() const;
                 void reserve(size_t capacity);
                 void add(PrimType primType, size_t index, size_t count, bool dynamicGrowth);
-                void add(const IndicesAndCounts& other, bool dynamicGrowth);
+                void add(PrimType primType, const IndicesAndCounts& other, bool dynamicGrowth);
             };
 
             using PrimTypeToIndexData = kdl::enum_array<IndicesAndCounts, PrimType, PrimTypeCount>;
@@ -145,6 +145,15 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray) const;
 
+            /**
+             * Renders the primitives stored in this index range map the given number of times using instanced draw
+             * calls, see VertexArray::renderInstanced.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param instanceCount the number of instances to render
+             */
+            void renderInstanced(VertexArray& vertexArray, size_t instanceCount) const;
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
@@ -36,6 +36,7 @@
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderStatistics.h"
 #include "Renderer/RenderUtils.h"
 #include "View/Selection.h"
 #include "View/MapDocument.h"
@@ -187,7 +188,10 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
-            commitPendingChanges();
+            {
+                TimeRenderSection timer(renderBatch.statistics(), RenderSection::CommitPendingChanges);
+                commitPendingChanges();
+            }
             setupGL(renderBatch);
             renderDefaultOpaque(renderContext, renderBatch);
             renderLockedOpaque(renderContext, renderBatch);
@@ -392,7 +396,6 @@ namespace TrenchBroom {
                                              lockedNodes.entities,
                                              lockedNodes.brushes);
             }
-            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::invalidateRenderers(Renderer renderers) {
@@ -444,6 +447,7 @@ namespace TrenchBroom {
             document->textureCollectionsWillChangeNotifier.addObserver(this, &MapRenderer::textureCollectionsWillChange);
             document->entityDefinitionsDidChangeNotifier.addObserver(this, &MapRenderer::entityDefinitionsDidChange);
             document->modsDidChangeNotifier.addObserver(this, &MapRenderer::modsDidChange);
+            document->entityModelsDidLoadNotifier.addObserver(this, &MapRenderer::entityModelsDidLoad);
             document->editorContextDidChangeNotifier.addObserver(this, &MapRenderer::editorContextDidChange);
 
             PreferenceManager& prefs = PreferenceManager::instance();
@@ -468,6 +472,7 @@ namespace TrenchBroom {
                 document->textureCollectionsWillChangeNotifier.removeObserver(this, &MapRenderer::textureCollectionsWillChange);
                 document->entityDefinitionsDidChangeNotifier.removeObserver(this, &MapRenderer::entityDefinitionsDidChange);
                 document->modsDidChangeNotifier.removeObserver(this, &MapRenderer::modsDidChange);
+                document->entityModelsDidLoadNotifier.removeObserver(this, &MapRenderer::entityModelsDidLoad);
                 document->editorContextDidChangeNotifier.removeObserver(this, &MapRenderer::editorContextDidChange);
             }
 
@@ -486,31 +491,37 @@ namespace TrenchBroom {
 
         void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>&) {
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>&) {
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
 
-        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
 
         void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>&) {
             invalidateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>&) {
             updateRenderers(Renderer_Default_Locked);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::groupWasOpened(Model::GroupNode*) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::groupWasClosed(Model::GroupNode*) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&) {
@@ -520,6 +531,9 @@ namespace TrenchBroom {
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
             updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
 
+            // only the links of the selected and deselected entities change their color
+            m_entityLinkRenderer->invalidateNodes(kdl::vec_concat(selection.selectedNodes(), selection.deselectedNodes()));
+
             // selecting faces needs to invalidate the brushes
             if (!selection.selectedBrushFaces().empty()
                 || !selection.deselectedBrushFaces().empty()) {
@@ -548,6 +562,25 @@ namespace TrenchBroom {
             invalidateEntityLinkRenderer();
         }
 
+        void MapRenderer::entityModelsDidLoad(const std::vector<Model::Node*>& nodes) {
+            // models are loaded in many batches, so only the affected entities are updated; brushes are unaffected
+            auto entities = std::vector<Model::EntityNode*>{};
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [](Model::WorldNode*) {},
+                    [](Model::LayerNode*) {},
+                    [](Model::GroupNode*) {},
+                    [&](Model::EntityNode* entity) { entities.push_back(entity); },
+                    [](Model::BrushNode*) {}
+                ));
+            }
+
+            m_defaultRenderer->reloadModels(entities);
+            m_selectionRenderer->reloadModels(entities);
+            m_lockedRenderer->reloadModels(entities);
+            m_entityLinkRenderer->invalidateNodes(nodes);
+        }
+
         void MapRenderer::editorContextDidChange() {
             invalidateRenderers(Renderer_All);
             invalidateEntityLinkRenderer();
@@ -142,6 +142,7 @@ namespace TrenchBroom {
             void textureCollectionsWillChange();
             void entityDefinitionsDidChange();
             void modsDidChange();
+            void entityModelsDidLoad(const std::vector<Model::Node*>& nodes);
 
             void editorContextDidChange();
 
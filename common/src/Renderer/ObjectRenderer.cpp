@@ -49,6 +49,12 @@ namespace TrenchBroom {
             m_entityRenderer.reloadModels();
         }
 
+        void ObjectRenderer::reloadModels(const std::vector<Model::EntityNode*>& entities) {
+            // the bounds of groups contain the bounds of their entities
+            m_groupRenderer.invalidate();
+            m_entityRenderer.reloadModels(entities);
+        }
+
         void ObjectRenderer::setShowOverlays(const bool showOverlays) {
             m_groupRenderer.setShowOverlays(showOverlays);
             m_entityRenderer.setShowOverlays(showOverlays);
@@ -61,6 +61,7 @@ namespace TrenchBroom {
             void invalidateBrushes(const std::vector<Model::BrushNode*>& brushes);
             void clear();
             void reloadModels();
+            void reloadModels(const std::vector<Model::EntityNode*>& entities);
         public: // configuration
             void setShowOverlays(bool showOverlays);
             void setEntityOverlayTextColor(const Color& overlayTextColor);
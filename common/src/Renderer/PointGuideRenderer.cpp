@@ -48,12 +48,14 @@ namespace TrenchBroom {
             m_spikeRenderer.clear();
 
             auto document = kdl::mem_lock(m_document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::pos_x()), SpikeLength, document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::neg_x()), SpikeLength, document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::pos_y()), SpikeLength, document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::neg_y()), SpikeLength, document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::pos_z()), SpikeLength, document);
-            m_spikeRenderer.add(vm::ray3(position, vm::vec3::neg_z()), SpikeLength, document);
+            m_spikeRenderer.add({
+                vm::ray3(position, vm::vec3::pos_x()),
+                vm::ray3(position, vm::vec3::neg_x()),
+                vm::ray3(position, vm::vec3::pos_y()),
+                vm::ray3(position, vm::vec3::neg_y()),
+                vm::ray3(position, vm::vec3::pos_z()),
+                vm::ray3(position, vm::vec3::neg_z())
+            }, SpikeLength, document);
 
             m_position = position;
         }
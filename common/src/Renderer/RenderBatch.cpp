@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderStatistics.h"
 #include "Renderer/VboManager.h"
 
 #include <kdl/vector_utils.h>
@@ -88,8 +89,18 @@ namespace TrenchBroom {
         }
 
         void RenderBatch::render(RenderContext& renderContext) {
-            prepareRenderables();
-            renderRenderables(renderContext);
+            {
+                TimeRenderSection timer(statistics(), RenderSection::PrepareRenderables);
+                prepareRenderables();
+            }
+            {
+                TimeRenderSection timer(statistics(), RenderSection::RenderRenderables);
+                renderRenderables(renderContext);
+            }
+        }
+
+        RenderStatistics& RenderBatch::statistics() {
+            return m_vboManager.renderStatistics();
         }
 
         void RenderBatch::doAdd(Renderable* renderable) {
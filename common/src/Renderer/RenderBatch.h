@@ -27,6 +27,7 @@ namespace TrenchBroom {
         class DirectRenderable;
         class IndexedRenderable;
         class RenderContext;
+        class RenderStatistics;
         class VboManager;
 
         class RenderBatch {
@@ -61,6 +62,11 @@ namespace TrenchBroom {
             void addOneShot(IndexedRenderable* renderable);
 
             void render(RenderContext& renderContext);
+
+            /**
+             * The statistics collector for the current frame.
+             */
+            RenderStatistics& statistics();
         private:
             void doAdd(Renderable* renderable);
 
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderStatistics.h"
+
+#include "Macros.h"
+
+#include <ostream>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        FrameStatistics::Duration& FrameStatistics::time(const RenderSection section) {
+            switch (section) {
+                case RenderSection::CommitPendingChanges:
+                    return commitPendingChangesTime;
+                case RenderSection::ValidateBrushes:
+                    return validateBrushesTime;
+                case RenderSection::PrepareRenderables:
+                    return prepareRenderablesTime;
+                case RenderSection::RenderRenderables:
+                    return renderRenderablesTime;
+                switchDefault();
+            }
+        }
+
+        static double toMsecs(const FrameStatistics::Duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        std::ostream& operator<<(std::ostream& str, const FrameStatistics& statistics) {
+            str << statistics.drawCalls << " draw calls, "
+                << statistics.vertexCount << " vertices, "
+                << statistics.uploadedBytes / 1024u << " KiB uploaded. "
+                << "Commit " << toMsecs(statistics.commitPendingChangesTime) << "ms, "
+                << "validate " << toMsecs(statistics.validateBrushesTime) << "ms, "
+                << "prepare " << toMsecs(statistics.prepareRenderablesTime) << "ms, "
+                << "render " << toMsecs(statistics.renderRenderablesTime) << "ms";
+            return str;
+        }
+
+        RenderStatistics::RenderStatistics() :
+        m_frameCount(0u) {}
+
+        void RenderStatistics::beginFrame() {
+            m_currentFrame = FrameStatistics();
+        }
+
+        void RenderStatistics::endFrame() {
+            m_lastFrame = m_currentFrame;
+            m_currentFrame = FrameStatistics();
+            ++m_frameCount;
+        }
+
+        void RenderStatistics::countDrawCall(const size_t vertexCount) {
+            ++m_currentFrame.drawCalls;
+            m_currentFrame.vertexCount += vertexCount;
+        }
+
+        void RenderStatistics::countUpload(const size_t bytes) {
+            m_currentFrame.uploadedBytes += bytes;
+        }
+
+        void RenderStatistics::addTime(const RenderSection section, const FrameStatistics::Duration duration) {
+            m_currentFrame.time(section) += duration;
+        }
+
+        const FrameStatistics& RenderStatistics::currentFrame() const {
+            return m_currentFrame;
+        }
+
+        const FrameStatistics& RenderStatistics::lastFrame() const {
+            return m_lastFrame;
+        }
+
+        size_t RenderStatistics::frameCount() const {
+            return m_frameCount;
+        }
+
+        TimeRenderSection::TimeRenderSection(RenderStatistics& statistics, const RenderSection section) :
+        m_statistics(statistics),
+        m_section(section),
+        m_start(Clock::now()) {}
+
+        TimeRenderSection::~TimeRenderSection() {
+            m_statistics.addTime(m_section, Clock::now() - m_start);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef> // for size_t
+#include <iosfwd>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        enum class RenderSection {
+            CommitPendingChanges,
+            ValidateBrushes,
+            PrepareRenderables,
+            RenderRenderables
+        };
+
+        /**
+         * The counters and timings of a single frame.
+         */
+        struct FrameStatistics {
+            using Duration = std::chrono::steady_clock::duration;
+
+            size_t drawCalls = 0;
+            /**
+             * The number of vertices or indices submitted with all draw calls.
+             */
+            size_t vertexCount = 0;
+            size_t uploadedBytes = 0;
+
+            Duration commitPendingChangesTime = Duration::zero();
+            Duration validateBrushesTime = Duration::zero();
+            Duration prepareRenderablesTime = Duration::zero();
+            Duration renderRenderablesTime = Duration::zero();
+
+            Duration& time(RenderSection section);
+        };
+
+        std::ostream& operator<<(std::ostream& str, const FrameStatistics& statistics);
+
+        /**
+         * Collects the counters and timings of the frames rendered using one VboManager. Does not depend on OpenGL, so
+         * it can be used in tests.
+         */
+        class RenderStatistics {
+        private:
+            FrameStatistics m_currentFrame;
+            FrameStatistics m_lastFrame;
+            size_t m_frameCount;
+        public:
+            RenderStatistics();
+
+            /**
+             * Starts collecting the statistics of a new frame. Counts recorded before the first call to beginFrame
+             * are attributed to the first frame.
+             */
+            void beginFrame();
+
+            /**
+             * Finishes the current frame, making its statistics available through lastFrame().
+             */
+            void endFrame();
+
+            void countDrawCall(size_t vertexCount);
+            void countUpload(size_t bytes);
+            void addTime(RenderSection section, FrameStatistics::Duration duration);
+
+            /**
+             * The statistics of the frame that is currently being rendered.
+             */
+            const FrameStatistics& currentFrame() const;
+
+            /**
+             * The statistics of the last finished frame.
+             */
+            const FrameStatistics& lastFrame() const;
+            size_t frameCount() const;
+        };
+
+        /**
+         * Measures the time between its construction and destruction and adds it to the given section.
+         */
+        class TimeRenderSection {
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            RenderStatistics& m_statistics;
+            RenderSection m_section;
+            Clock::time_point m_start;
+        public:
+            TimeRenderSection(RenderStatistics& statistics, RenderSection section);
+            ~TimeRenderSection();
+
+            TimeRenderSection(const TimeRenderSection& other) = delete;
+            TimeRenderSection& operator=(const TimeRenderSection& other) = delete;
+        };
+    }
+}
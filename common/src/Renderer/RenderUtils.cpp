@@ -75,6 +75,14 @@ namespace TrenchBroom {
             }
         }
 
+        InstanceRenderFunc::~InstanceRenderFunc() = default;
+
+        bool InstanceRenderFunc::setupInstances() {
+            return false;
+        }
+
+        void InstanceRenderFunc::cleanupInstances() {}
+
         std::vector<vm::vec2f> circle2D(const float radius, const size_t segments) {
             std::vector<vm::vec2f> vertices = circle2D(radius, 0.0f, vm::Cf::two_pi(), segments);
             vertices.push_back(vm::vec2f::zero());
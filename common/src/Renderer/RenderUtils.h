@@ -22,6 +22,8 @@
 #include <vecmath/forward.h>
 #include <vecmath/util.h>
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -51,6 +53,73 @@ namespace TrenchBroom {
             void after(const Assets::Texture* texture) override;
         };
 
+        /**
+         * Provides callbacks to render the same geometry multiple times, once per instance. The callbacks are
+         * responsible for setting up the per instance state, e.g. the model matrix.
+         */
+        class InstanceRenderFunc {
+        public:
+            virtual ~InstanceRenderFunc();
+            virtual size_t instanceCount() const = 0;
+            virtual void before(size_t instance) = 0;
+            virtual void after(size_t instance) = 0;
+
+            /**
+             * Sets up the per instance state of all instances at once so that they can be rendered with instanced
+             * draw calls. If this returns false, each instance is rendered separately using before and after instead.
+             *
+             * The default implementation returns false.
+             */
+            virtual bool setupInstances();
+
+            /**
+             * Cleans up the state set up by setupInstances. Only called if setupInstances returned true.
+             */
+            virtual void cleanupInstances();
+        };
+
+        /**
+         * A range of instances that share the same renderer.
+         */
+        struct InstanceRange {
+            size_t offset;
+            size_t count;
+        };
+
+        /**
+         * Sorts the given instances by the given key and returns the ranges of consecutive instances that have the same
+         * key, so that each range can be rendered at once.
+         *
+         * @tparam T the instance type
+         * @tparam K the type of the key function, must be of type `auto(const T&)` and return a value that supports
+         * the < and != operators
+         * @param instances the instances to sort
+         * @param key the key function
+         * @return the ranges of instances with the same key, in order
+         */
+        template <typename T, typename K>
+        std::vector<InstanceRange> groupInstances(std::vector<T>& instances, const K& key) {
+            std::sort(std::begin(instances), std::end(instances), [&](const T& lhs, const T& rhs) {
+                return key(lhs) < key(rhs);
+            });
+
+            auto result = std::vector<InstanceRange>{};
+            auto first = std::begin(instances);
+            while (first != std::end(instances)) {
+                const auto currentKey = key(*first);
+                const auto last = std::find_if(first, std::end(instances), [&](const T& instance) {
+                    return key(instance) != currentKey;
+                });
+
+                result.push_back({
+                    static_cast<size_t>(std::distance(std::begin(instances), first)),
+                    static_cast<size_t>(std::distance(first, last))
+                });
+                first = last;
+            }
+            return result;
+        }
+
         std::vector<vm::vec2f> circle2D(float radius, size_t segments);
         std::vector<vm::vec2f> circle2D(float radius, float startAngle, float angleLength, size_t segments);
         std::vector<vm::vec3f> circle2D(float radius, vm::axis::type axis, float startAngle, float angleLength, size_t segments);
@@ -27,7 +27,9 @@ namespace TrenchBroom {
             const ShaderConfig VaryingPUniformCShader     = ShaderConfig("Varying Position / Uniform Color", { "VaryingPUniformC.vertsh" },     { "VaryingPC.fragsh" });
             const ShaderConfig MiniMapEdgeShader          = ShaderConfig("MiniMap Edges",                    { "MiniMapEdge.vertsh" },          { "MiniMapEdge.fragsh" });
             const ShaderConfig EntityModelShader          = ShaderConfig("Entity Model",                     { "EntityModel.vertsh" },          { "MapBounds.fragsh", "EntityModel.fragsh" });
-            const ShaderConfig FaceShader                 = ShaderConfig("Face",                             { "Face.vertsh" },                 { "Grid.fragsh", "MapBounds.fragsh", "Face.fragsh" });
+            const ShaderConfig EntityModelInstancedShader = ShaderConfig("Instanced Entity Model",           { "EntityModelInstanced.vertsh" }, { "MapBounds.fragsh", "EntityModel.fragsh" });
+            const ShaderConfig FaceShader                 = ShaderConfig("Face",                             { "Face.vertsh" },                 { "Grid.fragsh", "MapBounds.fragsh", "FaceTexture.fragsh", "Face.fragsh" });
+            const ShaderConfig FaceArrayShader            = ShaderConfig("Face Texture Array",               { "Face.vertsh" },                 { "Grid.fragsh", "MapBounds.fragsh", "FaceTextureArray.fragsh", "Face.fragsh" });
             const ShaderConfig EdgeShader                 = ShaderConfig("Edge",                             { "Edge.vertsh" },                 { "MapBounds.fragsh", "Edge.fragsh" });
             const ShaderConfig ColoredTextShader          = ShaderConfig("Colored Text",                     { "ColoredText.vertsh" },          { "Text.fragsh" });
             const ShaderConfig TextShader                 = ShaderConfig("Text",                             { "Text.vertsh" },                 { "Text.fragsh" });
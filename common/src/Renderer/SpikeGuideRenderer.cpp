@@ -20,6 +20,7 @@
 #include "SpikeGuideRenderer.h"
 
 #include "Model/Hit.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/BrushNode.h"
 #include "Model/PickResult.h"
@@ -32,6 +33,7 @@
 #include "View/MapDocument.h"
 
 #include <memory>
+#include <vector>
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
@@ -48,16 +50,28 @@ namespace TrenchBroom {
         }
 
         void SpikeGuideRenderer::add(const vm::ray3& ray, const FloatType length, std::shared_ptr<View::MapDocument> document) {
-            Model::PickResult pickResult = Model::PickResult::byDistance(document->editorContext());
-            document->pick(ray, pickResult);
-
-            const Model::Hit& hit = pickResult.query().pickable().type(Model::BrushNode::BrushHitType).occluded().minDistance(1.0).first();
-            if (hit.isMatch()) {
-                if (hit.distance() <= length)
-                    addPoint(vm::point_at_distance(ray, hit.distance() - 0.01));
-                addSpike(ray, vm::min(length, hit.distance()), length);
-            } else {
-                addSpike(ray, length, length);
+            add(std::vector<vm::ray3>{ray}, length, std::move(document));
+        }
+
+        void SpikeGuideRenderer::add(const std::vector<vm::ray3>& rays, const FloatType length, std::shared_ptr<View::MapDocument> document) {
+            // matches the hits that the query below accepts, so that picking can stop at the first of them
+            const auto filter = Model::HitFilterChain(
+                std::make_unique<Model::ContextHitFilter>(document->editorContext()),
+                std::make_unique<Model::HitFilterChain>(
+                    std::make_unique<Model::TypedHitFilter>(Model::BrushNode::BrushHitType),
+                    std::make_unique<Model::MinDistanceHitFilter>(1.0)));
+
+            const auto pickResults = document->pickNearest(rays, length, filter);
+            for (size_t i = 0u; i < rays.size(); ++i) {
+                const auto& ray = rays[i];
+                const Model::Hit& hit = pickResults[i].query().pickable().type(Model::BrushNode::BrushHitType).occluded().minDistance(1.0).first();
+                if (hit.isMatch()) {
+                    if (hit.distance() <= length)
+                        addPoint(vm::point_at_distance(ray, hit.distance() - 0.01));
+                    addSpike(ray, vm::min(length, hit.distance()), length);
+                } else {
+                    addSpike(ray, length, length);
+                }
             }
             m_valid = false;
         }
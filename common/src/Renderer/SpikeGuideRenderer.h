@@ -60,6 +60,7 @@ namespace TrenchBroom {
 
             void setColor(const Color& color);
             void add(const vm::ray3& ray, FloatType length, std::shared_ptr<View::MapDocument> document);
+            void add(const std::vector<vm::ray3>& rays, FloatType length, std::shared_ptr<View::MapDocument> document);
             void clear();
         private:
             void doPrepareVertices(VboManager& vboManager) override;
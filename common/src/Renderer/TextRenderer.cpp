@@ -43,18 +43,17 @@ namespace TrenchBroom {
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
 
-        TextRenderer::Entry::Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
-        size(i_size),
+        TextRenderer::Entry::Entry(std::shared_ptr<const GlyphRun> i_glyphRun, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
+        glyphRun(std::move(i_glyphRun)),
         offset(i_offset),
         textColor(i_textColor),
-        backgroundColor(i_backgroundColor) {
-            using std::swap;
-            swap(vertices, i_vertices);
-        }
+        backgroundColor(i_backgroundColor) {}
 
         TextRenderer::EntryCollection::EntryCollection() :
         textVertexCount(0),
-        rectVertexCount(0) {}
+        rectVertexCount(0),
+        textVertexOffset(0),
+        rectVertexOffset(0) {}
 
         TextRenderer::TextRenderer(const FontDescriptor& fontDescriptor, const float maxViewDistance, const float minZoomFactor, const vm::vec2f& inset) :
         m_fontDescriptor(fontDescriptor),
@@ -77,39 +76,44 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
 
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            // check the distance before the string is laid out
+            if (!isInViewRange(renderContext, distance, onTop))
                 return;
 
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+            auto glyphRun = font.glyphRun(string);
+            if (!isOnScreen(renderContext, round(glyphRun->size), position))
+                return;
+
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
-            const vm::vec3f offset = position.offset(camera, size);
+            const vm::vec3f offset = position.offset(camera, glyphRun->size);
 
             if (onTop)
-                addEntry(m_entriesOnTop, Entry(vertices, size, offset,
+                addEntry(m_entriesOnTop, Entry(std::move(glyphRun), offset,
                                                Color(textColor, alphaFactor * textColor.a()),
                                                Color(backgroundColor, alphaFactor * backgroundColor.a())));
             else
-                addEntry(m_entries, Entry(vertices, size, offset,
+                addEntry(m_entries, Entry(std::move(glyphRun), offset,
                                           Color(textColor, alphaFactor * textColor.a()),
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isInViewRange(RenderContext& renderContext, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
                 if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
                     return false;
             }
+            return true;
+        }
 
+        bool TextRenderer::isOnScreen(RenderContext& renderContext, const vm::vec2f& size, const TextAnchor& position) const {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.viewport();
 
-            const vm::vec2f size = stringSize(renderContext, string);
             const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
             const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -136,42 +140,42 @@ namespace TrenchBroom {
 
         void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry) {
             collection.entries.push_back(entry);
-            collection.textVertexCount += entry.vertices.size();
+            collection.textVertexCount += entry.glyphRun->vertices.size() / 2;
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
         }
 
-        vm::vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return round(font.measure(string));
-        }
-
         void TextRenderer::doPrepareVertices(VboManager& vboManager) {
-            prepare(m_entries, false, vboManager);
-            prepare(m_entriesOnTop, true, vboManager);
-        }
-
-        void TextRenderer::prepare(EntryCollection& collection, const bool onTop, VboManager& vboManager) {
             std::vector<TextVertex> textVertices;
-            textVertices.reserve(collection.textVertexCount);
+            textVertices.reserve(m_entries.textVertexCount + m_entriesOnTop.textVertexCount);
 
             std::vector<RectVertex> rectVertices;
-            rectVertices.reserve(collection.rectVertexCount);
+            rectVertices.reserve(m_entries.rectVertexCount + m_entriesOnTop.rectVertexCount);
+
+            addEntries(m_entries, textVertices, rectVertices);
+            addEntries(m_entriesOnTop, textVertices, rectVertices);
+
+            m_textArray = VertexArray::move(std::move(textVertices));
+            m_rectArray = VertexArray::move(std::move(rectVertices));
+
+            m_textArray.prepare(vboManager);
+            m_rectArray.prepare(vboManager);
+        }
+
+        void TextRenderer::addEntries(EntryCollection& collection, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
+            collection.textVertexOffset = textVertices.size();
+            collection.rectVertexOffset = rectVertices.size();
 
             for (const Entry& entry : collection.entries) {
-                addEntry(entry, onTop, textVertices, rectVertices);
+                addEntry(entry, textVertices, rectVertices);
             }
 
-            collection.textArray = VertexArray::move(std::move(textVertices));
-            collection.rectArray = VertexArray::move(std::move(rectVertices));
-
-            collection.textArray.prepare(vboManager);
-            collection.rectArray.prepare(vboManager);
+            assert(textVertices.size() - collection.textVertexOffset == collection.textVertexCount);
+            assert(rectVertices.size() - collection.rectVertexOffset == collection.rectVertexCount);
         }
 
-        void TextRenderer::addEntry(const Entry& entry, const bool /* onTop */, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
-            const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-            const vm::vec2f& stringSize = entry.size;
+        void TextRenderer::addEntry(const Entry& entry, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
+            const std::vector<vm::vec2f>& stringVertices = entry.glyphRun->vertices;
+            const vm::vec2f& stringSize = entry.glyphRun->size;
 
             const vm::vec3f& offset = entry.offset;
 
@@ -210,20 +214,24 @@ namespace TrenchBroom {
         }
 
         void TextRenderer::render(EntryCollection& collection, RenderContext& renderContext) {
+            if (collection.entries.empty()) {
+                return;
+            }
+
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
             glAssert(glDisable(GL_TEXTURE_2D));
 
             ActiveShader backgroundShader(renderContext.shaderManager(), Shaders::TextBackgroundShader);
-            collection.rectArray.render(PrimType::Triangles);
+            m_rectArray.render(PrimType::Triangles, static_cast<GLint>(collection.rectVertexOffset), static_cast<GLsizei>(collection.rectVertexCount));
 
             glAssert(glEnable(GL_TEXTURE_2D));
 
             ActiveShader textShader(renderContext.shaderManager(), Shaders::ColoredTextShader);
             textShader.set("Texture", 0);
             font.activate();
-            collection.textArray.render(PrimType::Quads);
+            m_textArray.render(PrimType::Quads, static_cast<GLint>(collection.textVertexOffset), static_cast<GLsizei>(collection.textVertexCount));
             font.deactivate();
         }
     }
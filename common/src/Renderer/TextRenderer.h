@@ -28,11 +28,13 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
         class AttrString;
+        struct GlyphRun;
         class RenderContext;
         class TextAnchor;
 
@@ -45,13 +47,12 @@ namespace TrenchBroom {
             static const float RectCornerRadius;
 
             struct Entry {
-                std::vector<vm::vec2f> vertices;
-                vm::vec2f size;
+                std::shared_ptr<const GlyphRun> glyphRun;
                 vm::vec3f offset;
                 Color textColor;
                 Color backgroundColor;
 
-                Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+                Entry(std::shared_ptr<const GlyphRun> i_glyphRun, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
             };
 
             using EntryList = std::vector<Entry>;
@@ -61,8 +62,9 @@ namespace TrenchBroom {
                 size_t textVertexCount;
                 size_t rectVertexCount;
 
-                VertexArray textArray;
-                VertexArray rectArray;
+                // the location of this collection's vertices in the shared vertex arrays
+                size_t textVertexOffset;
+                size_t rectVertexOffset;
 
                 EntryCollection();
             };
@@ -77,6 +79,10 @@ namespace TrenchBroom {
 
             EntryCollection m_entries;
             EntryCollection m_entriesOnTop;
+
+            // the vertices of both entry collections are uploaded together
+            VertexArray m_textArray;
+            VertexArray m_rectArray;
         public:
             explicit TextRenderer(const FontDescriptor& fontDescriptor, float maxViewDistance = DefaultMaxViewDistance, float minZoomFactor = DefaultMinZoomFactor, const vm::vec2f& inset = DefaultInset);
 
@@ -85,16 +91,14 @@ namespace TrenchBroom {
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
 
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isInViewRange(RenderContext& renderContext, float distance, bool onTop) const;
+            bool isOnScreen(RenderContext& renderContext, const vm::vec2f& size, const TextAnchor& position) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
             void addEntry(EntryCollection& collection, const Entry& entry);
-
-            vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
         private:
             void doPrepareVertices(VboManager& vboManager) override;
-            void prepare(EntryCollection& collection, bool onTop, VboManager& vboManager);
-
-            void addEntry(const Entry& entry, bool onTop, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices);
+            void addEntries(EntryCollection& collection, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices);
+            void addEntry(const Entry& entry, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices);
 
             void doRender(RenderContext& renderContext) override;
             void render(EntryCollection& collection, RenderContext& renderContext);
@@ -32,6 +32,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedGlyphRuns = 4096u;
+
         TextureFont::TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(std::move(texture)),
         m_glyphs(glyphs),
@@ -172,6 +174,22 @@ namespace TrenchBroom {
             return measureString.size();
         }
 
+        std::shared_ptr<const GlyphRun> TextureFont::glyphRun(const AttrString& string) const {
+            auto it = m_glyphRuns.find(string);
+            if (it != std::end(m_glyphRuns)) {
+                return it->second;
+            }
+
+            if (m_glyphRuns.size() >= MaxCachedGlyphRuns) {
+                // the cached strings are cheap to recompute, so there is no need for a more elaborate eviction policy
+                m_glyphRuns.clear();
+            }
+
+            auto result = std::make_shared<const GlyphRun>(GlyphRun{ quads(string, true), measure(string) });
+            m_glyphRuns.emplace(string, result);
+            return result;
+        }
+
         std::vector<vm::vec2f> TextureFont::quads(const std::string& string, const bool clockwise, const vm::vec2f& offset) const {
             std::vector<vm::vec2f> result;
             result.reserve(string.length() * 4 * 2);
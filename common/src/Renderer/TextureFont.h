@@ -20,28 +20,42 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class AttrString;
         class FontGlyph;
         class FontTexture;
 
+        /**
+         * The laid out glyphs of a string. The vertices contain the positions and texture coordinates of clockwise
+         * quads, alternating, and they are relative to the bottom left corner of the string.
+         */
+        struct GlyphRun {
+            std::vector<vm::vec2f> vertices;
+            vm::vec2f size;
+        };
+
         class TextureFont {
         private:
+            static const size_t MaxCachedGlyphRuns;
+
             std::unique_ptr<FontTexture> m_texture;
             std::vector<FontGlyph> m_glyphs;
             int m_lineHeight;
 
             unsigned char m_firstChar;
             unsigned char m_charCount;
+
+            mutable std::map<AttrString, std::shared_ptr<const GlyphRun>> m_glyphRuns;
         public:
             TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
@@ -51,6 +65,15 @@ namespace TrenchBroom {
             std::vector<vm::vec2f> quads(const AttrString& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const AttrString& string) const;
 
+            /**
+             * Returns the glyph run of the given string. Glyph runs are cached since they are usually requested for
+             * the same strings in every frame. Since a font is specific to a font descriptor, the cache is effectively
+             * keyed by the string and the font descriptor.
+             *
+             * The returned glyph run remains valid even if it is evicted from the cache.
+             */
+            std::shared_ptr<const GlyphRun> glyphRun(const AttrString& string) const;
+
             std::vector<vm::vec2f> quads(const std::string& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const std::string& string) const;
 
@@ -124,6 +124,34 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeMap::render(VertexArray& vertexArray, TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) {
+            if (instanceFunc.setupInstances()) {
+                for (const auto& entry : *m_data) {
+                    const auto* texture = entry.first;
+                    const auto& indexArray = entry.second;
+
+                    func.before(texture);
+                    indexArray.renderInstanced(vertexArray, instanceFunc.instanceCount());
+                    func.after(texture);
+                }
+                instanceFunc.cleanupInstances();
+                return;
+            }
+
+            for (const auto& entry : *m_data) {
+                const auto* texture = entry.first;
+                const auto& indexArray = entry.second;
+
+                func.before(texture);
+                for (size_t i = 0; i < instanceFunc.instanceCount(); ++i) {
+                    instanceFunc.before(i);
+                    indexArray.render(vertexArray);
+                    instanceFunc.after(i);
+                }
+                func.after(texture);
+            }
+        }
+
         void TexturedIndexRangeMap::forEachPrimitive(std::function<void(const Texture*, PrimType, size_t, size_t)> func) const {
             for (const auto& entry : *m_data) {
                 const auto* texture = entry.first;
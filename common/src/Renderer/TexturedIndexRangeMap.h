@@ -29,6 +29,7 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class InstanceRenderFunc;
         class TextureRenderFunc;
         class VertexArray;
 
@@ -168,6 +169,18 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+            /**
+             * Renders the primitives stored in this index range map once for every instance provided by the given
+             * instance function. Each texture is activated only once for all instances. If the instance function can
+             * set up all instances at once, the instances are rendered with instanced draw calls, otherwise they are
+             * rendered one by one.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param func the texture callbacks
+             * @param instanceFunc the instance callbacks
+             */
+            void render(VertexArray& vertexArray, TextureRenderFunc& func, InstanceRenderFunc& instanceFunc);
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
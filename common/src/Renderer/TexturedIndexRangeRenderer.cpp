@@ -57,6 +57,13 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeRenderer::renderInstances(TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) {
+            if (m_vertexArray.setup()) {
+                m_indexRange.render(m_vertexArray, func, instanceFunc);
+                m_vertexArray.cleanup();
+            }
+        }
+
         MultiTexturedIndexRangeRenderer::MultiTexturedIndexRangeRenderer(std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> renderers) :
         m_renderers(std::move(renderers)) {}
 
@@ -88,5 +95,11 @@ namespace TrenchBroom {
                 renderer->render(func);
             }
         }
+
+        void MultiTexturedIndexRangeRenderer::renderInstances(TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) {
+            for (auto& renderer : m_renderers) {
+                renderer->renderInstances(func, instanceFunc);
+            }
+        }
     }
 }
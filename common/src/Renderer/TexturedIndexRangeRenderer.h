@@ -32,6 +32,7 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class VboManager;
+        class InstanceRenderFunc;
         class TextureRenderFunc;
 
         class TexturedRenderer {
@@ -43,6 +44,12 @@ namespace TrenchBroom {
             virtual void prepare(VboManager& vboManager) = 0;
             virtual void render() = 0;
             virtual void render(TextureRenderFunc& func) = 0;
+
+            /**
+             * Renders this renderer's geometry once per instance. Vertex buffers and textures are set up only once
+             * for all instances.
+             */
+            virtual void renderInstances(TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) = 0;
         };
 
         class TexturedIndexRangeRenderer : public TexturedRenderer {
@@ -60,6 +67,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) override;
         };
 
         class MultiTexturedIndexRangeRenderer : public TexturedRenderer {
@@ -74,6 +82,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) override;
         };
     }
 }
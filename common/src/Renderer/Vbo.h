@@ -100,6 +100,37 @@ namespace TrenchBroom {
 
                 return size;
             }
+
+            /**
+             * Writes the given ranges of a C array to the same positions in the VBO block. The buffer is bound only once
+             * for all ranges.
+             *
+             * @tparam T        element type
+             * @tparam R        range type, must have members `pos` and `size` which are given in elements
+             * @param array     the elements to write from
+             * @param ranges    the ranges to write
+             * @return          number of bytes written
+             */
+            template <typename T, typename R>
+            size_t writeArrayRanges(const T* array, const std::vector<R>& ranges) {
+                static_assert(std::is_trivially_copyable<T>::value);
+                static_assert(std::is_standard_layout<T>::value);
+
+                glAssert(glBindBuffer(m_type, m_bufferId));
+
+                size_t result = 0;
+                for (const auto& range : ranges) {
+                    const size_t address = range.pos * sizeof(T);
+                    const size_t size = range.size * sizeof(T);
+                    assert(address + size <= m_capacity);
+
+                    const GLvoid* ptr = static_cast<const GLvoid*>(array + range.pos);
+                    glAssert(glBufferSubData(m_type, static_cast<GLintptr>(address), static_cast<GLsizeiptr>(size), ptr));
+                    result += size;
+                }
+
+                return result;
+            }
         };
     }
 }
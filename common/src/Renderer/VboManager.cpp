@@ -56,6 +56,7 @@ namespace TrenchBroom {
         m_peakVboCount(0u),
         m_currentVboCount(0u),
         m_currentVboSize(0u),
+        m_uploadedBytes(0u),
         m_shaderManager(shaderManager) {}
 
         Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage) {
@@ -88,6 +89,23 @@ namespace TrenchBroom {
             return m_currentVboSize;
         }
 
+        void VboManager::addUploadedBytes(const size_t bytes) {
+            m_uploadedBytes += bytes;
+            m_renderStatistics.countUpload(bytes);
+        }
+
+        size_t VboManager::uploadedBytes() const {
+            return m_uploadedBytes;
+        }
+
+        RenderStatistics& VboManager::renderStatistics() {
+            return m_renderStatistics;
+        }
+
+        const RenderStatistics& VboManager::renderStatistics() const {
+            return m_renderStatistics;
+        }
+
         ShaderManager& VboManager::shaderManager() {
             return *m_shaderManager;
         }
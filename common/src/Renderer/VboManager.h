@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Renderer/GL.h"
+#include "Renderer/RenderStatistics.h"
 
 #include <cstddef> // for size_t
 
@@ -43,6 +44,8 @@ namespace TrenchBroom {
             size_t m_peakVboCount;
             size_t m_currentVboCount;
             size_t m_currentVboSize;
+            size_t m_uploadedBytes;
+            RenderStatistics m_renderStatistics;
             ShaderManager* m_shaderManager;
         public:
             explicit VboManager(ShaderManager* shaderManager);
@@ -57,6 +60,19 @@ namespace TrenchBroom {
             size_t currentVboCount() const;
             size_t currentVboSize() const;
 
+            /**
+             * Records that the given number of bytes were uploaded to a VBO.
+             */
+            void addUploadedBytes(size_t bytes);
+
+            /**
+             * Returns the total number of bytes uploaded to VBOs as reported via addUploadedBytes.
+             */
+            size_t uploadedBytes() const;
+
+            RenderStatistics& renderStatistics();
+            const RenderStatistics& renderStatistics() const;
+
             ShaderManager& shaderManager();
         };
     }
@@ -20,6 +20,7 @@
 #include "VertexArray.h"
 
 #include "Renderer/PrimType.h"
+#include "Renderer/VboManager.h"
 
 #include <cassert>
 
@@ -28,6 +29,7 @@ namespace TrenchBroom {
         VertexArray::BaseHolder::~BaseHolder() = default;
 
         VertexArray::VertexArray() :
+        m_vboManager(nullptr),
         m_prepared(false),
         m_setup(false) {}
 
@@ -51,6 +53,7 @@ namespace TrenchBroom {
             if (!prepared() && !empty()) {
                 m_holder->prepare(vboManager);
             }
+            m_vboManager = &vboManager;
             m_prepared = true;
         }
 
@@ -83,13 +86,23 @@ namespace TrenchBroom {
             if (!m_setup) {
                 if (setup()) {
                     glAssert(glDrawArrays(toGL(primType), index, count));
+                    countDrawCall(static_cast<size_t>(count));
                     cleanup();
                 }
             } else {
                 glAssert(glDrawArrays(toGL(primType), index, count));
+                countDrawCall(static_cast<size_t>(count));
             }
         }
 
+        static size_t countVertices(const GLCounts& counts, const GLint primCount) {
+            size_t result = 0;
+            for (GLint i = 0; i < primCount; ++i) {
+                result += static_cast<size_t>(counts[static_cast<size_t>(i)]);
+            }
+            return result;
+        }
+
         void VertexArray::render(const PrimType primType, const GLIndices& indices, const GLCounts& counts, const GLint primCount) {
             assert(prepared());
             if (!m_setup) {
@@ -97,33 +110,66 @@ namespace TrenchBroom {
                     const auto* indexArray = indices.data();
                     const auto* countArray = counts.data();
                     glAssert(glMultiDrawArrays(toGL(primType), indexArray, countArray, primCount));
+                    countDrawCall(countVertices(counts, primCount));
                     cleanup();
                 }
             } else {
                 const auto* indexArray = indices.data();
                 const auto* countArray = counts.data();
                 glAssert(glMultiDrawArrays(toGL(primType), indexArray, countArray, primCount));
+                countDrawCall(countVertices(counts, primCount));
             }
 
         }
 
+        static void drawArraysInstanced(const PrimType primType, const GLIndices& indices, const GLCounts& counts, const GLint primCount, const GLsizei instanceCount) {
+            // there is no instanced variant of glMultiDrawArrays
+            for (size_t i = 0; i < static_cast<size_t>(primCount); ++i) {
+                glAssert(glDrawArraysInstancedARB(toGL(primType), indices[i], counts[i], instanceCount));
+            }
+        }
+
+        void VertexArray::renderInstanced(const PrimType primType, const GLIndices& indices, const GLCounts& counts, const GLint primCount, const GLsizei instanceCount) {
+            assert(prepared());
+            const auto vertexCount = countVertices(counts, primCount) * static_cast<size_t>(instanceCount);
+            if (!m_setup) {
+                if (setup()) {
+                    drawArraysInstanced(primType, indices, counts, primCount, instanceCount);
+                    countDrawCall(vertexCount);
+                    cleanup();
+                }
+            } else {
+                drawArraysInstanced(primType, indices, counts, primCount, instanceCount);
+                countDrawCall(vertexCount);
+            }
+        }
+
         void VertexArray::render(const PrimType primType, const GLIndices& indices, const GLsizei count) {
             assert(prepared());
             if (!m_setup) {
                 if (setup()) {
                     const auto* indexArray = indices.data();
                     glAssert(glDrawElements(toGL(primType), count, GL_UNSIGNED_INT, indexArray));
+                    countDrawCall(static_cast<size_t>(count));
                     cleanup();
                 }
             } else {
                 const auto* indexArray = indices.data();
                 glAssert(glDrawElements(toGL(primType), count, GL_UNSIGNED_INT, indexArray));
+                countDrawCall(static_cast<size_t>(count));
             }
         }
 
         VertexArray::VertexArray(std::shared_ptr<BaseHolder> holder) :
         m_holder(std::move(holder)),
+        m_vboManager(nullptr),
         m_prepared(false),
         m_setup(false) {}
+
+        void VertexArray::countDrawCall(const size_t vertexCount) {
+            if (m_vboManager != nullptr) {
+                m_vboManager->renderStatistics().countDrawCall(vertexCount);
+            }
+        }
     }
 }
@@ -76,7 +76,8 @@ namespace TrenchBroom {
                     if (m_vertexCount > 0 && m_vbo == nullptr) {
                         m_vboManager = &vboManager;
                         m_vbo = vboManager.allocateVbo(VboType::ArrayBuffer, sizeInBytes());;
-                        m_vbo->writeBuffer(0, doGetVertices());
+                        const size_t bytes = m_vbo->writeBuffer(0, doGetVertices());
+                        vboManager.addUploadedBytes(bytes);
                     }
                 }
 
@@ -151,6 +152,7 @@ namespace TrenchBroom {
             };
         private:
             std::shared_ptr<BaseHolder> m_holder;
+            VboManager* m_vboManager;
             bool m_prepared;
             bool m_setup;
         public:
@@ -277,6 +279,19 @@ namespace TrenchBroom {
              */
             void render(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
 
+            /**
+             * Renders a number of sub ranges of this vertex array as in render(PrimType, const GLIndices&, const
+             * GLCounts&, GLint), but renders each range the given number of times using one instanced draw call per
+             * range. Requires the ARB_draw_instanced extension.
+             *
+             * @param primType the primitive type to render
+             * @param indices the start indices of the ranges to render
+             * @param counts the lengths of the ranges to render
+             * @param primCount the number of ranges to render
+             * @param instanceCount the number of instances to render
+             */
+            void renderInstanced(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount, GLsizei instanceCount);
+
             /**
              * Renders a number of primitives of the given type, the vertices of which are indicates by the given
              * index array.
@@ -289,6 +304,8 @@ namespace TrenchBroom {
             void cleanup();
         private:
             explicit VertexArray(std::shared_ptr<BaseHolder> holder);
+
+            void countDrawCall(size_t vertexCount);
         };
     }
 }
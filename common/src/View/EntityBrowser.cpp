@@ -36,6 +36,7 @@
 #include <QLineEdit>
 #include <QScrollBar>
 #include <QHBoxLayout>
+#include <QTimer>
 
 // for use in QVariant
 Q_DECLARE_METATYPE(TrenchBroom::Assets::EntityDefinitionSortOrder)
@@ -50,7 +51,12 @@ namespace TrenchBroom {
         m_usedButton(nullptr),
         m_filterBox(nullptr),
         m_scrollBar(nullptr),
-        m_view(nullptr) {
+        m_view(nullptr),
+        m_reloadTimer(new QTimer(this)) {
+            m_reloadTimer->setSingleShot(true);
+            m_reloadTimer->setInterval(100);
+            connect(m_reloadTimer, &QTimer::timeout, this, &EntityBrowser::reload);
+
             createGui(contextManager);
             bindObservers();
         }
@@ -139,6 +145,7 @@ namespace TrenchBroom {
             document->documentWasLoadedNotifier.addObserver(this, &EntityBrowser::documentWasLoaded);
             document->modsDidChangeNotifier.addObserver(this, &EntityBrowser::modsDidChange);
             document->entityDefinitionsDidChangeNotifier.addObserver(this, &EntityBrowser::entityDefinitionsDidChange);
+            document->entityModelsDidLoadNotifier.addObserver(this, &EntityBrowser::entityModelsDidLoad);
 
             PreferenceManager& prefs = PreferenceManager::instance();
             prefs.preferenceDidChangeNotifier.addObserver(this, &EntityBrowser::preferenceDidChange);
@@ -151,6 +158,7 @@ namespace TrenchBroom {
                 document->documentWasLoadedNotifier.removeObserver(this, &EntityBrowser::documentWasLoaded);
                 document->modsDidChangeNotifier.removeObserver(this, &EntityBrowser::modsDidChange);
                 document->entityDefinitionsDidChangeNotifier.removeObserver(this, &EntityBrowser::entityDefinitionsDidChange);
+                document->entityModelsDidLoadNotifier.removeObserver(this, &EntityBrowser::entityModelsDidLoad);
             }
 
             PreferenceManager& prefs = PreferenceManager::instance();
@@ -173,6 +181,13 @@ namespace TrenchBroom {
             reload();
         }
 
+        void EntityBrowser::entityModelsDidLoad(const std::vector<Model::Node*>&) {
+            // models finish loading in many small batches, so reload at most once per timer interval
+            if (!m_reloadTimer->isActive()) {
+                m_reloadTimer->start();
+            }
+        }
+
         void EntityBrowser::preferenceDidChange(const IO::Path& path) {
             auto document = kdl::mem_lock(m_document);
             if (document->isGamePathPreference(path)) {
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <QWidget>
 
@@ -27,12 +28,17 @@ class QPushButton;
 class QComboBox;
 class QLineEdit;
 class QScrollBar;
+class QTimer;
 
 namespace TrenchBroom {
     namespace IO {
         class Path;
     }
 
+    namespace Model {
+        class Node;
+    }
+
     namespace View {
         class EntityBrowserView;
         class GLContextManager;
@@ -48,6 +54,8 @@ namespace TrenchBroom {
             QLineEdit* m_filterBox;
             QScrollBar* m_scrollBar;
             EntityBrowserView* m_view;
+            // coalesces the reloads caused by models that finish loading in the background
+            QTimer* m_reloadTimer;
         public:
             EntityBrowser(std::weak_ptr<MapDocument> document, GLContextManager& contextManager, QWidget* parent = nullptr);
             ~EntityBrowser() override;
@@ -64,6 +72,7 @@ namespace TrenchBroom {
 
             void modsDidChange();
             void entityDefinitionsDidChange();
+            void entityModelsDidLoad(const std::vector<Model::Node*>& nodes);
             void preferenceDidChange(const IO::Path& path);
         };
     }
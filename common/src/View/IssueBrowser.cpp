@@ -75,6 +75,7 @@ namespace TrenchBroom {
         void IssueBrowser::bindObservers() {
             auto document = kdl::mem_lock(m_document);
             document->documentWasSavedNotifier.addObserver(this, &IssueBrowser::documentWasSaved);
+            document->documentWasClearedNotifier.addObserver(this, &IssueBrowser::documentWasCleared);
             document->documentWasNewedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
             document->documentWasLoadedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
             document->nodesWereAddedNotifier.addObserver(this, &IssueBrowser::nodesWereAdded);
@@ -87,6 +88,7 @@ namespace TrenchBroom {
             if (!kdl::mem_expired(m_document)) {
                 auto document = kdl::mem_lock(m_document);
                 document->documentWasSavedNotifier.removeObserver(this, &IssueBrowser::documentWasSaved);
+                document->documentWasClearedNotifier.removeObserver(this, &IssueBrowser::documentWasCleared);
                 document->documentWasNewedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
                 document->documentWasLoadedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
                 document->nodesWereAddedNotifier.removeObserver(this, &IssueBrowser::nodesWereAdded);
@@ -96,6 +98,10 @@ namespace TrenchBroom {
             }
         }
 
+        void IssueBrowser::documentWasCleared(MapDocument*) {
+            m_view->reload();
+        }
+
         void IssueBrowser::documentWasNewedOrLoaded(MapDocument*) {
 			updateFilterFlags();
             m_view->reload();
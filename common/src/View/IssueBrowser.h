@@ -60,6 +60,7 @@ namespace TrenchBroom {
         private:
             void bindObservers();
             void unbindObservers();
+            void documentWasCleared(MapDocument* document);
             void documentWasNewedOrLoaded(MapDocument* document);
             void documentWasSaved(MapDocument* document);
             void nodesWereAdded(const std::vector<Model::Node*>& nodes);
@@ -34,8 +34,11 @@
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
+#include <QElapsedTimer>
 #include <QHBoxLayout>
 #include <QTableView>
 #include <QMenu>
@@ -49,7 +52,8 @@ namespace TrenchBroom {
         m_document(document),
         m_hiddenGenerators(0),
         m_showHiddenIssues(false),
-        m_valid(false) {
+        m_valid(false),
+        m_pendingValidationScheduled(false) {
             createGui();
             bindEvents();
         }
@@ -113,30 +117,68 @@ namespace TrenchBroom {
             document->select(nodes);
         }
 
+        /**
+         * The maximum time in milliseconds spent validating dirty nodes before control is returned to the event loop.
+         */
+        static const qint64 ValidationTimeSlice = 20;
+
+        /**
+         * The number of dirty nodes that are validated together, see Model::Node::validateIssues.
+         */
+        static const size_t ValidationBatchSize = 1024;
+
         void IssueBrowserView::updateIssues() {
+            m_pendingNodes.clear();
+            m_collectedIssues.clear();
+
             auto document = kdl::mem_lock(m_document);
             if (document->world() != nullptr) {
                 const auto& issueGenerators = document->world()->registeredIssueGenerators();
-                
-                auto issues = std::vector<Model::Issue*>{};
-                const auto collectIssues = [&](auto* node) {
-                    for (auto* issue : node->issues(issueGenerators)) {
-                        if (m_showHiddenIssues || (!issue->hidden() && (issue->type() & m_hiddenGenerators) == 0)) {
-                            issues.push_back(issue);
-                        }
+
+                // only nodes with valid issues are read here, all others are validated later on
+                const auto collectNodeIssues = [&](Model::Node* node) {
+                    if (node->issuesValid()) {
+                        addIssues(node->issues(issueGenerators));
+                    } else {
+                        m_pendingNodes.push_back(node);
                     }
                 };
 
                 document->world()->accept(kdl::overload(
-                    [&](auto&& thisLambda, Model::WorldNode* world)   { collectIssues(world); world->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::LayerNode* layer)   { collectIssues(layer); layer->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::GroupNode* group)   { collectIssues(group); group->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::EntityNode* entity) { collectIssues(entity); entity->visitChildren(thisLambda); },
-                    [&](Model::BrushNode* brush)                      { collectIssues(brush); }
+                    [&](auto&& thisLambda, Model::WorldNode* world)   { collectNodeIssues(world); world->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::LayerNode* layer)   { collectNodeIssues(layer); layer->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::GroupNode* group)   { collectNodeIssues(group); group->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::EntityNode* entity) { collectNodeIssues(entity); entity->visitChildren(thisLambda); },
+                    [&](Model::BrushNode* brush)                      { collectNodeIssues(brush); }
                 ));
 
-                issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) { return lhs->seqId() > rhs->seqId(); });
-                m_tableModel->setIssues(std::move(issues));
+                if (!m_pendingNodes.empty()) {
+                    schedulePendingValidation();
+                }
+            }
+
+            m_tableModel->setIssues(std::move(m_collectedIssues));
+            m_collectedIssues.clear();
+        }
+
+        void IssueBrowserView::addIssues(const std::vector<Model::Issue*>& issues) {
+            for (auto* issue : issues) {
+                if (m_showHiddenIssues || (!issue->hidden() && (issue->type() & m_hiddenGenerators) == 0)) {
+                    m_collectedIssues.push_back(issue);
+                }
+            }
+        }
+
+        void IssueBrowserView::publishIssues() {
+            // the table is not reset here so that it keeps its selection and scroll position while validation continues
+            m_tableModel->addIssues(std::move(m_collectedIssues));
+            m_collectedIssues.clear();
+        }
+
+        void IssueBrowserView::schedulePendingValidation() {
+            if (!m_pendingValidationScheduled) {
+                m_pendingValidationScheduled = true;
+                QMetaObject::invokeMethod(this, "validatePendingNodes", Qt::QueuedConnection);
             }
         }
 
@@ -258,6 +300,10 @@ namespace TrenchBroom {
         void IssueBrowserView::invalidate() {
             m_valid = false;
 
+            // the pending nodes may be removed or deleted and the collected issues may be deleted before we validate again
+            m_pendingNodes.clear();
+            m_collectedIssues.clear();
+
             QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
         }
 
@@ -269,18 +315,76 @@ namespace TrenchBroom {
             }
         }
 
+        void IssueBrowserView::validatePendingNodes() {
+            m_pendingValidationScheduled = false;
+            if (!m_valid || m_pendingNodes.empty()) {
+                return;
+            }
+
+            auto document = kdl::mem_lock(m_document);
+            if (document->world() == nullptr) {
+                return;
+            }
+
+            const auto& issueGenerators = document->world()->registeredIssueGenerators();
+
+            QElapsedTimer timer;
+            timer.start();
+            while (!m_pendingNodes.empty() && !timer.hasExpired(ValidationTimeSlice)) {
+                const auto batchSize = std::min(ValidationBatchSize, m_pendingNodes.size());
+                const auto batchEnd = std::next(std::begin(m_pendingNodes), static_cast<std::ptrdiff_t>(batchSize));
+                const auto batch = std::vector<Model::Node*>(std::begin(m_pendingNodes), batchEnd);
+                m_pendingNodes.erase(std::begin(m_pendingNodes), batchEnd);
+
+                Model::Node::validateIssues(batch, issueGenerators);
+                for (auto* node : batch) {
+                    addIssues(node->issues(issueGenerators));
+                }
+            }
+
+            publishIssues();
+
+            if (!m_pendingNodes.empty()) {
+                schedulePendingValidation();
+            }
+        }
+
         // IssueBrowserModel
 
+        static bool compareIssues(const Model::Issue* lhs, const Model::Issue* rhs) {
+            return lhs->seqId() > rhs->seqId();
+        }
+
         IssueBrowserModel::IssueBrowserModel(QObject* parent)
         : QAbstractTableModel(parent),
           m_issues() {}
 
         void IssueBrowserModel::setIssues(std::vector<Model::Issue*> issues) {
             beginResetModel();
-            m_issues = std::move(issues);
+            m_issues = kdl::vec_sort(std::move(issues), compareIssues);
             endResetModel();
         }
 
+        void IssueBrowserModel::addIssues(std::vector<Model::Issue*> issues) {
+            issues = kdl::vec_sort(std::move(issues), compareIssues);
+
+            // insert runs of new issues that belong between the same two existing rows together
+            auto cur = std::begin(issues);
+            while (cur != std::end(issues)) {
+                const auto pos = std::upper_bound(std::begin(m_issues), std::end(m_issues), *cur, compareIssues);
+                const auto runEnd = pos == std::end(m_issues) ? std::end(issues)
+                    : std::partition_point(cur, std::end(issues), [&](const auto* issue) { return compareIssues(issue, *pos); });
+
+                const auto row = static_cast<int>(std::distance(std::begin(m_issues), pos));
+                const auto count = static_cast<int>(std::distance(cur, runEnd));
+                beginInsertRows(QModelIndex(), row, row + count - 1);
+                m_issues.insert(pos, cur, runEnd);
+                endInsertRows();
+
+                cur = runEnd;
+            }
+        }
+
         const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
             return m_issues;
         }
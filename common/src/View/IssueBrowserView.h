@@ -21,6 +21,7 @@
 
 #include "Model/IssueType.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -34,6 +35,7 @@ namespace TrenchBroom {
     namespace Model {
         class Issue;
         class IssueQuickFix;
+        class Node;
     }
 
     namespace View {
@@ -50,6 +52,15 @@ namespace TrenchBroom {
 
             bool m_valid;
 
+            /**
+             * Nodes whose issues are out of date and still need to be validated, and the issues collected from other
+             * nodes which have not been added to the table yet. Dirty nodes are validated in small time slices so that
+             * the editor stays responsive. They are validated in the order in which they were found.
+             */
+            std::deque<Model::Node*> m_pendingNodes;
+            std::vector<Model::Issue*> m_collectedIssues;
+            bool m_pendingValidationScheduled;
+
             QTableView* m_tableView;
             IssueBrowserModel* m_tableModel;
         public:
@@ -64,6 +75,9 @@ namespace TrenchBroom {
             void deselectAll();
         private:
             void updateIssues();
+            void addIssues(const std::vector<Model::Issue*>& issues);
+            void publishIssues();
+            void schedulePendingValidation();
 
             std::vector<Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
             std::vector<Model::IssueQuickFix*> collectQuickFixes(const QList<QModelIndex>& indices) const;
@@ -84,11 +98,14 @@ namespace TrenchBroom {
             void invalidate();
         public slots:
             void validate();
+        private slots:
+            void validatePendingNodes();
         };
 
         /**
-         * Trivial QAbstractTableModel subclass, when the issues list changes,
-         * it just refreshes the entire list with beginResetModel()/endResetModel().
+         * Trivial QAbstractTableModel subclass that keeps the issues sorted by their sequence ID. When the issues list
+         * is replaced, it refreshes the entire list with beginResetModel()/endResetModel(), while added issues are
+         * inserted with beginInsertRows()/endInsertRows() so that the view keeps its selection and scroll position.
          */
         class IssueBrowserModel : public QAbstractTableModel {
             Q_OBJECT
@@ -98,6 +115,7 @@ namespace TrenchBroom {
             explicit IssueBrowserModel(QObject* parent);
 
             void setIssues(std::vector<Model::Issue*> issues);
+            void addIssues(std::vector<Model::Issue*> issues);
             const std::vector<Model::Issue*>& issues();
         public: // QAbstractTableModel overrides
             int rowCount(const QModelIndex& parent) const override;
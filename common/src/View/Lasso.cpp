@@ -27,10 +27,46 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
-#include <vecmath/intersection.h>
+
+#include <array>
+#include <cassert>
 
 namespace TrenchBroom {
     namespace View {
+        Lasso::Volume::Volume(std::vector<vm::plane3> planes) :
+        m_planes(std::move(planes)) {}
+
+        bool Lasso::Volume::contains(const vm::vec3& point) const {
+            for (const auto& plane : m_planes) {
+                if (plane.point_distance(point) > 0.0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Lasso::Volume::contains(const vm::segment3& edge) const {
+            return contains(edge.center());
+        }
+
+        bool Lasso::Volume::contains(const vm::polygon3& polygon) const {
+            return contains(polygon.center());
+        }
+
+        bool Lasso::Volume::intersects(const vm::bbox3& bounds) const {
+            for (const auto& plane : m_planes) {
+                // the box is disjoint from the volume if even its corner furthest below the plane is above it
+                vm::vec3 corner;
+                for (size_t i = 0u; i < 3u; ++i) {
+                    corner[i] = plane.normal[i] >= 0.0 ? bounds.min[i] : bounds.max[i];
+                }
+                if (plane.point_distance(corner) > 0.0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         Lasso::Lasso(const Renderer::Camera& camera, const FloatType distance, const vm::vec3& point) :
         m_camera(camera),
         m_distance(distance),
@@ -44,28 +80,46 @@ namespace TrenchBroom {
             m_cur = point;
         }
 
-        bool Lasso::selects(const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const {
-            const auto projected = project(point, plane);
-            return !vm::is_nan(projected) && box.contains(vm::vec2(projected));
-        }
+        Lasso::Volume Lasso::volume() const {
+            const auto box = this->box();
+            if (box.min.x() == box.max.x() || box.min.y() == box.max.y()) {
+                // two opposing planes that every point is above of at least one of
+                return Volume({ vm::plane3(0.0, vm::vec3::pos_z()), vm::plane3(-1.0, vm::vec3::neg_z()) });
+            }
 
-        bool Lasso::selects(const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const {
-            return selects(edge.center(), plane, box);
-        }
+            const auto [invertible, inverseTransform] = vm::invert(m_transform);
+            assert(invertible); unused(invertible);
 
-        bool Lasso::selects(const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const {
-            return selects(polygon.center(), plane, box);
-        }
+            const auto corners = std::array<vm::vec3, 4>{
+                inverseTransform * vm::vec3(box.min.x(), box.min.y(), 0.0),
+                inverseTransform * vm::vec3(box.min.x(), box.max.y(), 0.0),
+                inverseTransform * vm::vec3(box.max.x(), box.max.y(), 0.0),
+                inverseTransform * vm::vec3(box.max.x(), box.min.y(), 0.0)
+            };
+            const auto center = inverseTransform * vm::vec3(box.center().x(), box.center().y(), 0.0);
+
+            auto planes = std::vector<vm::plane3>();
+            planes.reserve(5u);
+
+            // every side plane contains one edge of the lasso rectangle and the pick rays through its end points
+            for (size_t i = 0u; i < corners.size(); ++i) {
+                const auto& corner = corners[i];
+                const auto& next = corners[(i + 1u) % corners.size()];
+                const auto rayDirection = vm::vec3(m_camera.pickRay(vm::vec3f(corner)).direction);
+
+                auto plane = vm::plane3(corner, vm::normalize(vm::cross(next - corner, rayDirection)));
+                if (plane.point_distance(center) > 0.0) {
+                    plane = plane.flip();
+                }
+                planes.push_back(plane);
+            }
 
-        vm::vec3 Lasso::project(const vm::vec3& point, const vm::plane3& plane) const {
-            const auto ray = vm::ray3(m_camera.pickRay(vm::vec3f(point)));
-            const auto hitDistance = vm::intersect_ray_plane(ray, plane);
-            if (vm::is_nan(hitDistance)) {
-                return vm::vec3::nan();
+            if (m_camera.perspectiveProjection()) {
+                // the side planes meet at the camera position, exclude everything behind it
+                planes.emplace_back(vm::vec3(m_camera.position()), -vm::vec3(m_camera.direction()));
             }
 
-            const auto hitPoint = vm::point_at_distance(ray, hitDistance);
-            return m_transform * hitPoint;
+            return Volume(std::move(planes));
         }
 
         void Lasso::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
@@ -88,10 +142,6 @@ namespace TrenchBroom {
             renderService.renderFilledPolygon(polygon);
         }
 
-        vm::plane3 Lasso::plane() const {
-            return vm::plane3(vm::vec3(m_camera.defaultPoint(static_cast<float>(m_distance))), vm::vec3(m_camera.direction()));
-        }
-
         vm::bbox2 Lasso::box() const {
             const auto start = m_transform * m_start;
             const auto cur   = m_transform * m_cur;
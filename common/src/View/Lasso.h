@@ -21,9 +21,12 @@
 
 #include "FloatType.h"
 
+#include <vecmath/forward.h>
 #include <vecmath/plane.h>
 #include <vecmath/bbox.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         class Camera;
@@ -33,6 +36,35 @@ namespace TrenchBroom {
 
     namespace View {
         class Lasso {
+        public:
+            /**
+             * The volume of space selected by a lasso. For a perspective camera, this is the sub-frustum spanned by the
+             * camera position and the lasso rectangle, and for an orthographic camera, it is the infinite box spanned by
+             * the lasso rectangle along the view direction.
+             *
+             * The volume is given by the planes that bound it. The plane normals point outwards, so a point is
+             * contained in the volume if it is not above any of the planes.
+             */
+            class Volume {
+            private:
+                std::vector<vm::plane3> m_planes;
+            public:
+                explicit Volume(std::vector<vm::plane3> planes);
+
+                bool contains(const vm::vec3& point) const;
+                bool contains(const vm::segment3& edge) const;
+                bool contains(const vm::polygon3& polygon) const;
+
+                /**
+                 * Indicates whether the given bounding box may contain points that are contained in this volume. This
+                 * test is conservative, it may return true for some boxes that are not actually intersected by this
+                 * volume.
+                 *
+                 * @param bounds the bounding box to test
+                 * @return false if the given box is certainly disjoint from this volume and true otherwise
+                 */
+                bool intersects(const vm::bbox3& bounds) const;
+            };
         private:
             const Renderer::Camera& m_camera;
             const FloatType m_distance;
@@ -46,10 +78,9 @@ namespace TrenchBroom {
 
             template <typename I, typename O>
             void selected(I cur, I end, O out) const {
-                const vm::plane3 plane = this->plane();
-                const vm::bbox2 box = this->box();
+                const Volume volume = this->volume();
                 while (cur != end) {
-                    if (selects(*cur, plane, box))
+                    if (volume.contains(*cur))
                         out = *cur;
                     ++cur;
                 }
@@ -57,19 +88,20 @@ namespace TrenchBroom {
 
             template <typename H>
             bool selects(const H& h) const {
-                return selects(h, plane(), box());
+                return volume().contains(h);
             }
-        private:
-            bool selects(const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
-            bool selects(const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
-            bool selects(const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const;
-            vm::vec3 project(const vm::vec3& point, const vm::plane3& plane) const;
+
+            /**
+             * Returns the volume of space selected by this lasso. The volume is empty if the lasso rectangle is
+             * degenerate.
+             *
+             * @return the selected volume
+             */
+            Volume volume() const;
         public:
             void render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const;
         private:
-            vm::plane3 plane() const;
             vm::bbox2 box() const;
         };
     }
 }
-
@@ -37,6 +37,7 @@
 #include "IO/GameConfigParser.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
+#include "IO/TextureCache.h"
 #include "Model/Brush.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -69,6 +70,7 @@
 #include "Model/Node.h"
 #include "Model/NodeContents.h"
 #include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/PickResult.h"
 #include "Model/PropertyKeyWithDoubleQuotationMarksIssueGenerator.h"
 #include "Model/PropertyValueWithDoubleQuotationMarksIssueGenerator.h"
 #include "Model/WorldBoundsIssueGenerator.h"
@@ -104,6 +106,7 @@
 #include <kdl/overload.h>
 #include "kdl/string_format.h"
 #include <kdl/result.h>
+#include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/polygon.h>
@@ -114,6 +117,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib> // for std::abs
+#include <limits>
 #include <map>
 #include <sstream>
 #include <string>
@@ -224,6 +228,13 @@ namespace TrenchBroom {
             return success;
         }
 
+        static std::shared_ptr<const IO::TextureCache> createTextureCache() {
+            if (!pref(Preferences::CacheTextures)) {
+                return nullptr;
+            }
+            return std::make_shared<IO::TextureCache>(IO::SystemPaths::userDataDirectory() + IO::Path("TextureCache"));
+        }
+
         const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
         const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
@@ -252,6 +263,9 @@ namespace TrenchBroom {
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr),
         m_repeatStack(std::make_unique<RepeatStack>()) {
+            m_textureManager->setPackTextures(pref(Preferences::PackTextures));
+            m_textureManager->setLoadTexturesOnDemand(pref(Preferences::LoadTexturesOnDemand));
+            m_textureManager->setTextureCache(createTextureCache());
             bindObservers();
         }
 
@@ -2399,6 +2413,20 @@ namespace TrenchBroom {
                 m_world->pick(pickRay, pickResult);
         }
 
+        void MapDocument::pickNearest(const vm::ray3& pickRay, const Model::HitFilter& filter, Model::PickResult& pickResult) const {
+            if (m_world != nullptr) {
+                m_world->pickNearest(pickRay, std::numeric_limits<FloatType>::max(), filter, pickResult);
+            }
+        }
+
+        std::vector<Model::PickResult> MapDocument::pickNearest(const std::vector<vm::ray3>& pickRays, const FloatType maxDistance, const Model::HitFilter& filter) const {
+            auto pickResults = std::vector<Model::PickResult>(pickRays.size(), Model::PickResult::byDistance(editorContext()));
+            if (m_world != nullptr) {
+                m_world->pickNearest(pickRays, maxDistance, filter, pickResults);
+            }
+            return pickResults;
+        }
+
         std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const {
             std::vector<Model::Node*> result;
             if (m_world != nullptr) {
@@ -2487,6 +2515,34 @@ namespace TrenchBroom {
             setEntityDefinitionFile(oldSpec);
         }
 
+        void MapDocument::finishLoadingEntityModels() {
+            const auto paths = m_entityModelManager->finishLoadingModels();
+
+            // invalid model specifications were reported when the models were requested
+            auto nullLogger = NullLogger{};
+            auto nodes = std::vector<Model::Node*>{};
+            for (const auto& path : paths) {
+                const auto it = m_entityNodesAwaitingModel.find(path);
+                if (it == std::end(m_entityNodesAwaitingModel)) {
+                    continue;
+                }
+
+                for (auto* entityNode : it->second) {
+                    const auto modelSpec = Assets::safeGetModelSpecification(nullLogger, entityNode->entity().classname(), [&]() {
+                        return entityNode->entity().modelSpecification();
+                    });
+                    entityNode->setModelFrame(m_entityModelManager->frame(modelSpec));
+                    m_modelAwaitedByEntityNode.erase(entityNode);
+                    nodes.push_back(entityNode);
+                }
+                m_entityNodesAwaitingModel.erase(it);
+            }
+
+            if (!nodes.empty()) {
+                entityModelsDidLoadNotifier(nodes);
+            }
+        }
+
         void MapDocument::loadAssets() {
             loadEntityDefinitions();
             setEntityDefinitions();
@@ -2537,6 +2593,7 @@ namespace TrenchBroom {
 
         void MapDocument::reloadTextures() {
             unloadTextures();
+            m_entityModelManager->waitForPendingModels();
             m_game->reloadShaders();
             loadTextures();
         }
@@ -2669,49 +2726,71 @@ namespace TrenchBroom {
 
         void MapDocument::clearEntityModels() {
             unsetEntityModels();
+            m_entityNodesAwaitingModel.clear();
+            m_modelAwaitedByEntityNode.clear();
             m_entityModelManager->clear();
         }
 
-        static auto makeSetEntityModelsVisitor(Logger& logger, Assets::EntityModelManager& manager) {
+        template <typename F>
+        static auto makeEntityModelsVisitor(const F& visitEntityNode) {
             return kdl::overload(
                 [] (auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-                [&](Model::EntityNode* entityNode)                  {
-                    const auto modelSpec = Assets::safeGetModelSpecification(logger, entityNode->entity().classname(), [&]() {
-                        return entityNode->entity().modelSpecification();
-                    });
-                    const auto* frame = manager.frame(modelSpec);
-                    entityNode->setModelFrame(frame);
-                },
+                [&](Model::EntityNode* entityNode)              { visitEntityNode(entityNode); },
                 [] (Model::BrushNode*) {}
             );
         }
 
-        static auto makeUnsetEntityModelsVisitor() {
-            return kdl::overload(
-                [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
-                [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
-                [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-                [](Model::EntityNode* entity)                  { entity->setModelFrame(nullptr); },
-                [](Model::BrushNode*) {}
-            );
-        }
-
         void MapDocument::setEntityModels() {
-            m_world->accept(makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+            m_world->accept(makeEntityModelsVisitor([&](auto* entityNode) { setEntityModel(entityNode); }));
         }
 
         void MapDocument::setEntityModels(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+            Model::Node::visitAll(nodes, makeEntityModelsVisitor([&](auto* entityNode) { setEntityModel(entityNode); }));
         }
 
         void MapDocument::unsetEntityModels() {
-            m_world->accept(makeUnsetEntityModelsVisitor());
+            m_world->accept(makeEntityModelsVisitor([&](auto* entityNode) { unsetEntityModel(entityNode); }));
         }
 
         void MapDocument::unsetEntityModels(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
+            Model::Node::visitAll(nodes, makeEntityModelsVisitor([&](auto* entityNode) { unsetEntityModel(entityNode); }));
+        }
+
+        void MapDocument::setEntityModel(Model::EntityNode* entityNode) {
+            stopAwaitingEntityModel(entityNode);
+
+            const auto modelSpec = Assets::safeGetModelSpecification(*this, entityNode->entity().classname(), [&]() {
+                return entityNode->entity().modelSpecification();
+            });
+            const auto* frame = m_entityModelManager->frame(modelSpec);
+            entityNode->setModelFrame(frame);
+
+            if (frame == nullptr && m_entityModelManager->isLoadingModel(modelSpec.path)) {
+                m_entityNodesAwaitingModel[modelSpec.path].insert(entityNode);
+                m_modelAwaitedByEntityNode.emplace(entityNode, modelSpec.path);
+            }
+        }
+
+        void MapDocument::unsetEntityModel(Model::EntityNode* entityNode) {
+            stopAwaitingEntityModel(entityNode);
+            entityNode->setModelFrame(nullptr);
+        }
+
+        void MapDocument::stopAwaitingEntityModel(Model::EntityNode* entityNode) {
+            const auto it = m_modelAwaitedByEntityNode.find(entityNode);
+            if (it == std::end(m_modelAwaitedByEntityNode)) {
+                return;
+            }
+
+            const auto nodesIt = m_entityNodesAwaitingModel.find(it->second);
+            assert(nodesIt != std::end(m_entityNodesAwaitingModel));
+            nodesIt->second.erase(entityNode);
+            if (nodesIt->second.empty()) {
+                m_entityNodesAwaitingModel.erase(nodesIt);
+            }
+            m_modelAwaitedByEntityNode.erase(it);
         }
 
         std::vector<IO::Path> MapDocument::externalSearchPaths() const {
@@ -3024,9 +3103,10 @@ namespace TrenchBroom {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, logger());
 
+                // clear the models first so that none are being loaded from the old file system
                 clearEntityModels();
+                m_game->setGamePath(newGamePath, logger());
                 setEntityModels();
 
                 reloadTextures();
@@ -3035,6 +3115,16 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::PackTextures.path()) {
+                m_textureManager->setPackTextures(pref(Preferences::PackTextures));
+                reloadTextures();
+                setTextures();
+            } else if (path == Preferences::LoadTexturesOnDemand.path()) {
+                m_textureManager->setLoadTexturesOnDemand(pref(Preferences::LoadTexturesOnDemand));
+                reloadTextures();
+                setTextures();
+            } else if (path == Preferences::CacheTextures.path()) {
+                m_textureManager->setTextureCache(createTextureCache());
             }
         }
 
@@ -32,10 +32,13 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <kdl/vector_set.h>
+
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -58,8 +61,10 @@ namespace TrenchBroom {
         class BrushFaceAttributes;
         class EditorContext;
         class Entity;
+        class EntityNode;
         enum class ExportFormat;
         class Game;
+        class HitFilter;
         class Issue;
         enum class MapFormat;
         class PickResult;
@@ -101,6 +106,13 @@ namespace TrenchBroom {
             std::unique_ptr<Assets::EntityDefinitionManager> m_entityDefinitionManager;
             std::unique_ptr<Assets::EntityModelManager> m_entityModelManager;
             std::unique_ptr<Assets::TextureManager> m_textureManager;
+
+            /**
+             * The entity nodes whose model is being loaded in the background, by model path, and the model path that
+             * each of these nodes awaits. Only these nodes are updated when a model has finished loading.
+             */
+            std::map<IO::Path, kdl::vector_set<Model::EntityNode*>> m_entityNodesAwaitingModel;
+            std::unordered_map<Model::EntityNode*, IO::Path> m_modelAwaitedByEntityNode;
             std::unique_ptr<Model::TagManager> m_tagManager;
 
             std::unique_ptr<Model::EditorContext> m_editorContext;
@@ -182,6 +194,8 @@ namespace TrenchBroom {
             Notifier<> modsWillChangeNotifier;
             Notifier<> modsDidChangeNotifier;
 
+            Notifier<const std::vector<Model::Node*>&> entityModelsDidLoadNotifier;
+
             Notifier<> pointFileWasLoadedNotifier;
             Notifier<> pointFileWasUnloadedNotifier;
 
@@ -479,6 +493,13 @@ namespace TrenchBroom {
             void commitPendingAssets();
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+
+            /**
+             * Picks the world with the given ray, but stops once no closer hit matched by the given filter is possible,
+             * see Model::WorldNode::pickNearest.
+             */
+            void pickNearest(const vm::ray3& pickRay, const Model::HitFilter& filter, Model::PickResult& pickResult) const;
+            std::vector<Model::PickResult> pickNearest(const std::vector<vm::ray3>& pickRays, FloatType maxDistance, const Model::HitFilter& filter) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game);
@@ -498,6 +519,11 @@ namespace TrenchBroom {
             void reloadTextureCollections();
 
             void reloadEntityDefinitions();
+
+            /**
+             * Assigns the entity models that have finished loading in the background to the entities that use them.
+             */
+            void finishLoadingEntityModels();
         private:
             void loadAssets();
             void unloadAssets();
@@ -530,6 +556,10 @@ namespace TrenchBroom {
             void setEntityModels(const std::vector<Model::Node*>& nodes);
             void unsetEntityModels();
             void unsetEntityModels(const std::vector<Model::Node*>& nodes);
+        private:
+            void setEntityModel(Model::EntityNode* entityNode);
+            void unsetEntityModel(Model::EntityNode* entityNode);
+            void stopAwaitingEntityModel(Model::EntityNode* entityNode);
         protected: // search paths and mods
             std::vector<IO::Path> externalSearchPaths() const;
             void updateGameSearchPaths();
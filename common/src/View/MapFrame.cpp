@@ -25,6 +25,7 @@
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "TrenchBroomApp.h"
+#include "Assets/EntityModelManager.h"
 #include "IO/PathQt.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
@@ -146,6 +147,10 @@ namespace TrenchBroom {
 
             m_document->setParentLogger(m_console);
             m_document->setViewEffectsService(m_mapView);
+            m_document->entityModelManager().setLoadModelsInBackground(true, [this]() {
+                // called on a loading thread, so the loaded models must be taken over on the main thread
+                QMetaObject::invokeMethod(this, "finishLoadingEntityModels", Qt::QueuedConnection);
+            });
 
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
@@ -175,6 +180,10 @@ namespace TrenchBroom {
             unbindObservers();
             removeRecentDocumentsMenu();
 
+            // The model loaded callback refers to this frame, but the document may outlive it. Disabling background
+            // loading waits for the running loads, so the callback is not invoked anymore afterwards.
+            m_document->entityModelManager().setLoadModelsInBackground(false);
+
             // The order of deletion here is important because both the document and the children
             // need the context manager (and its embedded VBO) to clean up their resources.
 
@@ -1843,6 +1852,10 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::finishLoadingEntityModels() {
+            m_document->finishLoadingEntityModels();
+        }
+
         // DebugPaletteWindow
 
         DebugPaletteWindow::DebugPaletteWindow(QWidget *parent)
@@ -375,6 +375,8 @@ namespace TrenchBroom {
             bool eventFilter(QObject* target, QEvent* event) override;
         private:
             void triggerAutosave();
+        private slots:
+            void finishLoadingEntityModels();
         };
 
         class DebugPaletteWindow : public QDialog {
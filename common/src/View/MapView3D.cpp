@@ -30,6 +30,7 @@
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
 #include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/PickResult.h"
 #include "Model/PointFile.h"
@@ -69,6 +70,8 @@
 
 #include <vecmath/util.h>
 
+#include <memory>
+
 namespace TrenchBroom {
     namespace View {
         MapView3D::MapView3D(std::weak_ptr<MapDocument> document, MapViewToolBox& toolBox, Renderer::MapRenderer& renderer,
@@ -190,12 +193,29 @@ namespace TrenchBroom {
             return PickRequest(vm::ray3(m_camera->pickRay(x, y)), *m_camera);
         }
 
+        /**
+         * Returns a filter for the hits at which picking for the tools can stop. The tools query the world for the
+         * closest pickable brush or entity, some of them only beyond a minimum distance of 3 units (see CameraTool3D)
+         * and some of them only among the selected objects. A hit that matches this filter is at least as close as every
+         * hit that these queries look for. Drilling the selection needs all hits and picks again, see
+         * SelectionTool::drillSelection.
+         */
+        static std::unique_ptr<const Model::HitFilter> makeToolPickFilter(const MapDocument& document) {
+            auto filter = std::unique_ptr<const Model::HitFilter>(std::make_unique<Model::MinDistanceHitFilter>(3.0));
+            filter = std::make_unique<Model::HitFilterChain>(std::make_unique<Model::TypedHitFilter>(Model::BrushNode::BrushHitType), std::move(filter));
+            filter = std::make_unique<Model::HitFilterChain>(std::make_unique<Model::ContextHitFilter>(document.editorContext()), std::move(filter));
+            if (document.hasSelectedNodes() || document.hasSelectedBrushFaces()) {
+                filter = std::make_unique<Model::HitFilterChain>(std::make_unique<Model::SelectionHitFilter>(), std::move(filter));
+            }
+            return filter;
+        }
+
         Model::PickResult MapView3D::doPick(const vm::ray3& pickRay) const {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
 
-            document->pick(pickRay, pickResult);
+            document->pickNearest(pickRay, *makeToolPickFilter(*document), pickResult);
             return pickResult;
         }
 
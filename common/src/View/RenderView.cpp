@@ -72,6 +72,8 @@
 #ifdef _WIN32
 #endif
 
+#include <kdl/string_utils.h>
+
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
@@ -107,8 +109,8 @@ namespace TrenchBroom {
                     std::to_string(maxFrameTime) + "ms. " +
                     std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs (" +
                     std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling " +
-                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
-
+                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB. Last frame: " +
+                    kdl::str_to_string(m_glContext->vboManager().renderStatistics().lastFrame());
 
             });
 
@@ -158,7 +160,10 @@ namespace TrenchBroom {
         void RenderView::paintGL() {
             if (TrenchBroom::View::isReportingCrash()) return;
 
+            auto& statistics = vboManager().renderStatistics();
+            statistics.beginFrame();
             render();
+            statistics.endFrame();
 
             // Update stats
             m_framesRendered++;
@@ -306,13 +306,19 @@ namespace TrenchBroom {
         }
 
         void SelectionTool::drillSelection(const InputState& inputState) {
-            const auto hits = inputState.pickResult().query().pickable().type(Model::EntityNode::EntityHitType | Model::BrushNode::BrushHitType).occluded().all();
+            auto document = kdl::mem_lock(m_document);
+
+            // the pick result of the input state need not contain the hits behind the closest one, see MapView3D::doPick
+            auto pickResult = inputState.pickResult();
+            pickResult.clear();
+            document->pick(inputState.pickRay(), pickResult);
+
+            const auto hits = pickResult.query().pickable().type(Model::EntityNode::EntityHitType | Model::BrushNode::BrushHitType).occluded().all();
 
             // Hits may contain multiple brush/entity hits that are inside closed groups. These need to be converted
             // to group hits using findOutermostClosedGroupOrNode() and multiple hits on the same Group need to be collapsed.
             const std::vector<Model::Node*> hitNodes = hitsToNodesWithGroupPicking(hits);
 
-            auto document = kdl::mem_lock(m_document);
             const auto& editorContext = document->editorContext();
 
             const auto forward = (inputState.scrollY() > 0.0f) != (pref(Preferences::CameraMouseWheelInvert));
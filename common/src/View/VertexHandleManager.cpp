@@ -25,41 +25,90 @@
 #include "Model/Polyhedron.h"
 #include "View/Grid.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/distance.h>
 #include <vecmath/vec.h>
 #include <vecmath/ray.h>
 #include <vecmath/plane.h>
 #include <vecmath/intersection.h>
 
+#include <cmath>
+
 namespace TrenchBroom {
     namespace View {
+        const FloatType VertexHandleManagerBase::CellSize = 64.0;
+
         VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
+        VertexHandleManagerBase::CellKey VertexHandleManagerBase::cellKey(const vm::vec3& point) {
+            return CellKey{
+                static_cast<long>(std::floor(point.x() / CellSize)),
+                static_cast<long>(std::floor(point.y() / CellSize)),
+                static_cast<long>(std::floor(point.z() / CellSize))
+            };
+        }
+
+        vm::vec3 VertexHandleManagerBase::handleAnchor(const vm::vec3& handle) {
+            return handle;
+        }
+
+        vm::vec3 VertexHandleManagerBase::handleAnchor(const vm::segment3& handle) {
+            return handle.center();
+        }
+
+        vm::vec3 VertexHandleManagerBase::handleAnchor(const vm::polygon3& handle) {
+            return handle.center();
+        }
+
+        vm::bbox3 VertexHandleManagerBase::handleBounds(const vm::vec3& handle) {
+            return vm::bbox3(handle, handle);
+        }
+
+        vm::bbox3 VertexHandleManagerBase::handleBounds(const vm::segment3& handle) {
+            return vm::bbox3(vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end()));
+        }
+
+        vm::bbox3 VertexHandleManagerBase::handleBounds(const vm::polygon3& handle) {
+            return vm::bbox3::merge_all(std::begin(handle), std::end(handle));
+        }
+
+        vm::bbox3 VertexHandleManagerBase::pickBounds(const vm::bbox3& bounds, const Renderer::Camera& camera, const FloatType handleRadius) {
+            // the pick radius grows with the distance to the camera, so we take the largest one at any corner
+            auto maxScalingFactor = static_cast<FloatType>(0.0);
+            for (const auto& corner : bounds.vertices()) {
+                const auto scalingFactor = static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f(corner)));
+                maxScalingFactor = vm::max(maxScalingFactor, scalingFactor);
+            }
+
+            const auto radius = static_cast<FloatType>(2.0) * handleRadius * maxScalingFactor;
+            return vm::bbox3(bounds.min - vm::vec3::fill(radius), bounds.max + vm::vec3::fill(radius));
+        }
+
         const Model::HitType::Type VertexHandleManager::HandleHitType = Model::HitType::freeType();
 
         void VertexHandleManager::pick(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-                const auto distance = camera.pickPointHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::vec3& position) {
+                const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(distance)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, distance);
                     const auto error = vm::squared_distance(pickRay, position).distance;
                     pickResult.addHit(Model::Hit::hit(HandleHitType, distance, hitPoint, position, error));
                 }
-            }
+            });
         }
 
         void VertexHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushVertex* vertex : brush.vertices()) {
-                add(vertex->position());
+                add(vertex->position(), brushNode);
             }
         }
 
         void VertexHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushVertex* vertex : brush.vertices()) {
-                assertResult(remove(vertex->position()))
+                assertResult(remove(vertex->position(), brushNode))
             }
         }
 
@@ -75,44 +124,44 @@ namespace TrenchBroom {
         const Model::HitType::Type EdgeHandleManager::HandleHitType = Model::HitType::freeType();
 
         void EdgeHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
-                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
+                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(edgeDist)) {
                     const vm::vec3 pointHandle = grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
                     }
                 }
-            }
+            });
         }
 
         void EdgeHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
                 const vm::vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushEdge* edge : brush.edges()) {
-                add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()));
+                add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()), brushNode);
             }
         }
 
         void EdgeHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushEdge* edge : brush.edges()) {
-                assertResult(remove(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position())))
+                assertResult(remove(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()), brushNode))
             }
         }
 
@@ -128,51 +177,50 @@ namespace TrenchBroom {
         const Model::HitType::Type FaceHandleManager::HandleHitType = Model::HitType::freeType();
 
         void FaceHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
                 const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
                 if (!valid) {
-                    continue;
+                    return;
                 }
 
                 const auto distance = vm::intersect_ray_polygon(pickRay, plane, std::begin(position), std::end(position));
                 if (!vm::is_nan(distance)) {
                     const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
 
-                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
                     }
                 }
-            }
+            });
         }
 
         void FaceHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const auto& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
                 const auto pointHandle = position.center();
 
-                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void FaceHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushFace& face : brush.faces()) {
-                add(face.polygon());
+                add(face.polygon(), brushNode);
             }
         }
 
         void FaceHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushFace& face : brush.faces()) {
-                assertResult(remove(face.polygon()))
+                assertResult(remove(face.polygon(), brushNode))
             }
         }
 
@@ -27,11 +27,18 @@
 #include "Renderer/Camera.h"
 
 #include <kdl/vector_set.h>
+#include <kdl/vector_utils.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/polygon.h>
+#include <vecmath/ray.h>
 #include <vecmath/segment.h>
 
+#include <algorithm>
 #include <iterator>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -43,6 +50,31 @@ namespace TrenchBroom {
         class Grid;
 
         class VertexHandleManagerBase {
+        protected:
+            /**
+             * The size of the cells of the grid that the handles are bucketed into.
+             */
+            static const FloatType CellSize;
+
+            /**
+             * Identifies a grid cell by its integer coordinates.
+             */
+            struct CellKey {
+                long x;
+                long y;
+                long z;
+
+                bool operator==(const CellKey& other) const {
+                    return x == other.x && y == other.y && z == other.z;
+                }
+            };
+
+            struct CellKeyHash {
+                size_t operator()(const CellKey& key) const {
+                    // large primes, see "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+                    return (static_cast<size_t>(key.x) * 73856093u) ^ (static_cast<size_t>(key.y) * 19349663u) ^ (static_cast<size_t>(key.z) * 83492791u);
+                }
+            };
         public:
             virtual ~VertexHandleManagerBase();
         public:
@@ -89,6 +121,32 @@ namespace TrenchBroom {
              * @param brushNode the brush whose handles to remove
              */
             virtual void removeHandles(const Model::BrushNode* brushNode) = 0;
+        protected:
+            /**
+             * Returns the key of the grid cell that contains the given point.
+             */
+            static CellKey cellKey(const vm::vec3& point);
+
+            /**
+             * Returns the point by which a handle is bucketed into the grid. For edge and face handles, this is their
+             * center, which is also the point at which they are picked.
+             */
+            static vm::vec3 handleAnchor(const vm::vec3& handle);
+            static vm::vec3 handleAnchor(const vm::segment3& handle);
+            static vm::vec3 handleAnchor(const vm::polygon3& handle);
+
+            /**
+             * Returns the bounds of the given handle.
+             */
+            static vm::bbox3 handleBounds(const vm::vec3& handle);
+            static vm::bbox3 handleBounds(const vm::segment3& handle);
+            static vm::bbox3 handleBounds(const vm::polygon3& handle);
+
+            /**
+             * Returns the given bounds enlarged by the radius of a pick sphere of the given handle radius anywhere
+             * within the bounds, see Renderer::Camera::pickPointHandle.
+             */
+            static vm::bbox3 pickBounds(const vm::bbox3& bounds, const Renderer::Camera& camera, FloatType handleRadius);
         };
 
         template <typename H>
@@ -99,13 +157,19 @@ namespace TrenchBroom {
         private:
         protected:
             /**
-             * Represents the status of a handle, i.e., how many duplicates exist at the same coordinates and whether
-             * or not all of these are selected.
+             * Represents the status of a handle, i.e., how many duplicates exist at the same coordinates, whether
+             * or not all of these are selected and which brushes they belong to.
              */
             struct HandleInfo {
                 size_t count;
                 bool selected;
 
+                /**
+                 * The brushes that added this handle. If a handle was added without a brush, the number of brushes is
+                 * less than the count.
+                 */
+                std::vector<const Model::BrushNode*> brushNodes;
+
                 HandleInfo() :
                 count(0),
                 selected(false) {}
@@ -157,13 +221,34 @@ namespace TrenchBroom {
                 }
             };
 
-            using HandleMap = std::map<H, HandleInfo>;
-            using HandleEntry = typename HandleMap::value_type;
+            struct HandleEntry {
+                Handle handle;
+                HandleInfo info;
+
+                explicit HandleEntry(const Handle& i_handle) :
+                handle(i_handle) {}
+            };
+
+            /**
+             * A grid cell contains the handles whose anchor points are contained in it, and the bounds of these handles.
+             * The bounds may exceed the cell itself if the handles are edges or faces.
+             */
+            struct Cell {
+                std::vector<HandleEntry> entries;
+                vm::bbox3 bounds;
+            };
+
+            using CellMap = std::unordered_map<CellKey, Cell, CellKeyHash>;
 
             /**
-             * Maps a handle position to its info.
+             * Maps the keys of the non-empty grid cells to the cells.
              */
-            HandleMap m_handles;
+            CellMap m_cells;
+
+            /**
+             * The total number of handles, not counting duplicates.
+             */
+            size_t m_handleCount;
 
             /**
              * The total number of selected handles, not counting duplicates.
@@ -171,6 +256,7 @@ namespace TrenchBroom {
             size_t m_selectedHandleCount;
         public:
             VertexHandleManagerBaseT() :
+            m_handleCount(0),
             m_selectedHandleCount(0) {}
 
             virtual ~VertexHandleManagerBaseT() {}
@@ -206,11 +292,11 @@ namespace TrenchBroom {
              * @return the total number of handles
              */
             size_t totalHandleCount() const {
-                return m_handles.size();
+                return m_handleCount;
             }
         public:
             /**
-             * Returns all handles contained in this manager.
+             * Returns all handles contained in this manager in no particular order.
              *
              * @return a list containing all handles
              */
@@ -222,7 +308,7 @@ namespace TrenchBroom {
             }
 
             /**
-             * Returns all selected handles contained in this manager.
+             * Returns all selected handles contained in this manager in no particular order.
              *
              * @return a list containing all selected handles
              */
@@ -234,7 +320,7 @@ namespace TrenchBroom {
             }
 
             /**
-             * Returns all unselected handles contained in this manager.
+             * Returns all unselected handles contained in this manager in no particular order.
              *
              * @return a list containing all unselected handles
              */
@@ -244,14 +330,60 @@ namespace TrenchBroom {
                 collectHandles([](const HandleInfo& info) { return !info.selected; }, std::back_inserter(result));
                 return result;
             }
+
+            /**
+             * Finds all handles contained in the given volume and appends them to the given output iterator. Grid cells
+             * whose bounds do not intersect the volume are skipped entirely.
+             *
+             * @tparam V the type of the volume, must provide member functions `bool contains(const H&) const` and
+             * `bool intersects(const vm::bbox3&) const`
+             * @tparam O the type of the output iterator
+             * @param volume the volume to test the handles against
+             * @param out the output iterator to append to
+             */
+            template <typename V, typename O>
+            void findHandles(const V& volume, O out) const {
+                for (const auto& [key, cell] : m_cells) {
+                    if (volume.intersects(cell.bounds)) {
+                        for (const HandleEntry& entry : cell.entries) {
+                            if (volume.contains(entry.handle)) {
+                                out++ = entry.handle;
+                            }
+                        }
+                    }
+                }
+            }
         private:
             template <typename T, typename O>
             void collectHandles(const T& test, O out) const {
-                for (const HandleEntry& entry : m_handles) {
-                    const Handle& handle = entry.first;
-                    const HandleInfo& info = entry.second;
-                    if (test(info)) {
-                        out++ = handle;
+                for (const auto& [key, cell] : m_cells) {
+                    for (const HandleEntry& entry : cell.entries) {
+                        if (test(entry.info)) {
+                            out++ = entry.handle;
+                        }
+                    }
+                }
+            }
+        protected:
+            /**
+             * Calls the given function for every handle in the grid cells that could be hit by the given pick ray,
+             * that is, every cell whose bounds, enlarged by the size of a pick sphere with the given handle radius,
+             * are intersected by the ray.
+             *
+             * @tparam F the type of the function to call, must be callable as `void(const H&)`
+             * @param pickRay the pick ray
+             * @param camera the camera to scale the handle radius with
+             * @param handleRadius the handle radius
+             * @param fun the function to call
+             */
+            template <typename F>
+            void forEachHandleNearRay(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, F fun) const {
+                for (const auto& [key, cell] : m_cells) {
+                    const auto bounds = pickBounds(cell.bounds, camera, handleRadius);
+                    if (bounds.contains(pickRay.origin) || !vm::is_nan(vm::intersect_ray_bbox(pickRay, bounds))) {
+                        for (const HandleEntry& entry : cell.entries) {
+                            fun(entry.handle);
+                        }
                     }
                 }
             }
@@ -263,7 +395,7 @@ namespace TrenchBroom {
              * @return true if and only if the given handle is contained in this manager
              */
             bool contains(const Handle& handle) const {
-                return m_handles.count(handle) > 0;
+                return findEntry(handle) != nullptr;
             }
 
             /**
@@ -273,10 +405,10 @@ namespace TrenchBroom {
              * @return true if and only if the given handle is contained in this manager and it is selected
              */
             bool selected(const Handle& handle) const {
-                const auto it = m_handles.find(handle);
-                if (it == std::end(m_handles))
+                const auto* entry = findEntry(handle);
+                if (entry == nullptr)
                     return false;
-                return it->second.selected;
+                return entry->info.selected;
             }
 
             /**
@@ -295,43 +427,97 @@ namespace TrenchBroom {
             bool allSelected() const {
                 return selectedHandleCount() == totalHandleCount();
             }
+        private:
+            const HandleEntry* findEntry(const Handle& handle) const {
+                const auto cellIt = m_cells.find(cellKey(handleAnchor(handle)));
+                if (cellIt == std::end(m_cells)) {
+                    return nullptr;
+                }
+
+                for (const HandleEntry& entry : cellIt->second.entries) {
+                    if (entry.handle == handle) {
+                        return &entry;
+                    }
+                }
+                return nullptr;
+            }
         public:
             /**
              * Adds the given handle to this manager.
              *
              * @param handle the handle to add
-             */
-            void add(const Handle& handle) {
-                m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+             * @param brushNode the brush that the handle belongs to, or null if it does not belong to any brush
+             */
+            void add(const Handle& handle, const Model::BrushNode* brushNode = nullptr) {
+                Cell& cell = m_cells[cellKey(handleAnchor(handle))];
+
+                auto it = std::find_if(std::begin(cell.entries), std::end(cell.entries), [&](const HandleEntry& entry) { return entry.handle == handle; });
+                if (it == std::end(cell.entries)) {
+                    const auto bounds = handleBounds(handle);
+                    cell.bounds = cell.entries.empty() ? bounds : vm::merge(cell.bounds, bounds);
+                    cell.entries.emplace_back(handle);
+                    it = std::prev(std::end(cell.entries));
+                    ++m_handleCount;
+                }
+
+                HandleInfo& info = it->info;
+                info.inc();
+                if (brushNode != nullptr) {
+                    info.brushNodes.push_back(brushNode);
+                }
             }
 
             /**
              * Removes the given handle from this manager.
              *
              * @param handle the handle to remove
+             * @param brushNode the brush that the handle was added for, or null if it was added without a brush
              * @return true if the given handle was contained in this manager (and therefore removed) and false otherwise
              */
-            bool remove(const Handle& handle) {
-                const auto it = m_handles.find(handle);
-                if (it != std::end(m_handles)) {
-                    HandleInfo& info = it->second;
-                    info.dec();
+            bool remove(const Handle& handle, const Model::BrushNode* brushNode = nullptr) {
+                const auto cellIt = m_cells.find(cellKey(handleAnchor(handle)));
+                if (cellIt == std::end(m_cells)) {
+                    return false;
+                }
 
-                    if (info.count == 0) {
-                        deselect(info);
-                        m_handles.erase(it);
+                Cell& cell = cellIt->second;
+                const auto it = std::find_if(std::begin(cell.entries), std::end(cell.entries), [&](const HandleEntry& entry) { return entry.handle == handle; });
+                if (it == std::end(cell.entries)) {
+                    return false;
+                }
+
+                HandleInfo& info = it->info;
+                info.dec();
+                if (brushNode != nullptr) {
+                    const auto brushIt = std::find(std::begin(info.brushNodes), std::end(info.brushNodes), brushNode);
+                    if (brushIt != std::end(info.brushNodes)) {
+                        info.brushNodes.erase(brushIt);
                     }
-                    return true;
                 }
 
-                return false;
+                if (info.count == 0) {
+                    deselect(info);
+                    cell.entries.erase(it);
+                    --m_handleCount;
+
+                    if (cell.entries.empty()) {
+                        m_cells.erase(cellIt);
+                    } else {
+                        cell.bounds = handleBounds(cell.entries.front().handle);
+                        for (const HandleEntry& entry : cell.entries) {
+                            cell.bounds = vm::merge(cell.bounds, handleBounds(entry.handle));
+                        }
+                    }
+                }
+                return true;
             }
 
             /**
              * Removes all handles from this manager.
              */
             void clear() {
-                m_handles.clear();
+                m_cells.clear();
+                m_handleCount = 0;
                 m_selectedHandleCount = 0;
             }
 
@@ -389,8 +575,10 @@ namespace TrenchBroom {
              * Deselects all currently selected handles
              */
             void deselectAll() {
-                for (auto& entry : m_handles) {
-                    deselect(entry.second);
+                for (auto& [key, cell] : m_cells) {
+                    for (HandleEntry& entry : cell.entries) {
+                        deselect(entry.info);
+                    }
                 }
             }
 
@@ -422,9 +610,24 @@ namespace TrenchBroom {
             template <typename F>
             void forEachCloseHandle(const H& handle, F fun) {
                 static const auto epsilon = 0.001 * 0.001;
-                for (auto& entry : m_handles) {
-                    if (compare(handle, entry.first, epsilon) == 0) {
-                        fun(entry.second);
+
+                // the anchors of close handles are close, too, but they may be in a neighbouring cell
+                const auto anchor = handleAnchor(handle);
+                const auto minKey = cellKey(anchor - vm::vec3::fill(epsilon));
+                const auto maxKey = cellKey(anchor + vm::vec3::fill(epsilon));
+
+                for (long x = minKey.x; x <= maxKey.x; ++x) {
+                    for (long y = minKey.y; y <= maxKey.y; ++y) {
+                        for (long z = minKey.z; z <= maxKey.z; ++z) {
+                            const auto cellIt = m_cells.find(CellKey{x, y, z});
+                            if (cellIt != std::end(m_cells)) {
+                                for (HandleEntry& entry : cellIt->second.entries) {
+                                    if (compare(handle, entry.handle, epsilon) == 0) {
+                                        fun(entry.info);
+                                    }
+                                }
+                            }
+                        }
                     }
                 }
             }
@@ -463,10 +666,12 @@ namespace TrenchBroom {
              */
             template <typename P>
             void pick(const P& test, Model::PickResult& pickResult) const {
-                for (const auto& entry : m_handles) {
-                    const auto hit = test(entry.first);
-                    if (hit.isMatch()) {
-                        pickResult.addHit(hit);
+                for (const auto& [key, cell] : m_cells) {
+                    for (const HandleEntry& entry : cell.entries) {
+                        const auto hit = test(entry.handle);
+                        if (hit.isMatch()) {
+                            pickResult.addHit(hit);
+                        }
                     }
                 }
             }
@@ -482,9 +687,9 @@ namespace TrenchBroom {
              */
             template <typename I>
             std::vector<Model::BrushNode*> findIncidentBrushes(const Handle& handle, I begin, I end) const {
-                kdl::vector_set<Model::BrushNode*> result;
-                findIncidentBrushes(handle, begin, end, std::inserter(result, result.end()));
-                return result.release_data();
+                std::vector<Model::BrushNode*> result;
+                findIncidentBrushes(handle, begin, end, std::back_inserter(result));
+                return kdl::vec_sort_and_remove_duplicates(std::move(result));
             }
 
             /**
@@ -500,10 +705,12 @@ namespace TrenchBroom {
              */
             template <typename I1, typename I2>
             std::vector<Model::BrushNode*> findIncidentBrushes(I1 hBegin, I1 hEnd, I2 bBegin, I2 bEnd) const {
+                const kdl::vector_set<Model::BrushNode*> brushes(bBegin, bEnd);
+
                 kdl::vector_set<Model::BrushNode*> result;
                 auto out = std::inserter(result, std::end(result));
                 for (auto hCur = hBegin; hCur != hEnd; ++hCur) {
-                    findIncidentBrushes(*hCur, bBegin, bEnd, out);
+                    findIncidentBrushes(*hCur, brushes, out);
                 }
                 return result.release_data();
             }
@@ -520,9 +727,51 @@ namespace TrenchBroom {
              */
             template <typename I, typename O>
             void findIncidentBrushes(const Handle& handle, I begin, I end, O out) const {
-                for (auto cur = begin; cur != end; ++cur) {
-                    if (isIncident(handle, *cur)) {
-                        out++ = *cur;
+                // this is called for every handle, so the given range is not copied into a set; a handle is usually
+                // shared by only a few brushes, so looking each brush up among them is cheap
+                const auto* entry = findEntry(handle);
+                if (entry != nullptr && entry->info.brushNodes.size() == entry->info.count) {
+                    const auto& brushNodes = entry->info.brushNodes;
+                    for (auto cur = begin; cur != end; ++cur) {
+                        if (std::find(std::begin(brushNodes), std::end(brushNodes), *cur) != std::end(brushNodes)) {
+                            out++ = *cur;
+                        }
+                    }
+                } else {
+                    for (auto cur = begin; cur != end; ++cur) {
+                        if (isIncident(handle, *cur)) {
+                            out++ = *cur;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Finds all brushes in the given set which are incident to the given handle.
+             *
+             * If the handle is contained in this manager and all of its duplicates were added by brushes, the incident
+             * brushes are looked up directly, otherwise every brush in the given set is checked.
+             *
+             * @tparam O an output iterator to append the resulting brushes to
+             * @param handle the handle
+             * @param brushes the brushes to consider
+             * @param out an output iterator that accepts the incident brushes
+             */
+            template <typename O>
+            void findIncidentBrushes(const Handle& handle, const kdl::vector_set<Model::BrushNode*>& brushes, O out) const {
+                const auto* entry = findEntry(handle);
+                if (entry != nullptr && entry->info.brushNodes.size() == entry->info.count) {
+                    for (const auto* brushNode : entry->info.brushNodes) {
+                        const auto it = std::lower_bound(std::begin(brushes), std::end(brushes), brushNode);
+                        if (it != std::end(brushes) && *it == brushNode) {
+                            out++ = *it;
+                        }
+                    }
+                } else {
+                    for (auto* brushNode : brushes) {
+                        if (isIncident(handle, brushNode)) {
+                            out++ = brushNode;
+                        }
                     }
                 }
             }
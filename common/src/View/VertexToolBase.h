@@ -110,31 +110,33 @@ namespace TrenchBroom {
             template <typename M, typename I>
             std::map<typename M::Handle, std::vector<Model::BrushNode*>> buildBrushMap(const M& manager, I cur, I end) const {
                 using H2 = typename M::Handle;
+                const kdl::vector_set<Model::BrushNode*> brushes(selectedBrushes());
+
                 std::map<H2, std::vector<Model::BrushNode*>> result;
                 while (cur != end) {
                     const H2& handle = *cur++;
-                    result[handle] = findIncidentBrushes(manager, handle);
+                    kdl::vector_set<Model::BrushNode*> incidentBrushes;
+                    manager.findIncidentBrushes(handle, brushes, std::inserter(incidentBrushes, std::end(incidentBrushes)));
+                    result[handle] = incidentBrushes.release_data();
                 }
                 return result;
             }
 
-            // FIXME: use vector_set
             template <typename M, typename H2>
             std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, const H2& handle) const {
                 const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
                 return manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes));
             }
 
-            // FIXME: use vector_set
             template <typename M, typename I>
             std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, I cur, I end) const {
-                const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
+                const kdl::vector_set<Model::BrushNode*> brushes(selectedBrushes());
                 kdl::vector_set<Model::BrushNode*> result;
                 auto out = std::inserter(result, std::end(result));
 
                 while (cur != end) {
                     const auto& handle = *cur;
-                    manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes), out);
+                    manager.findIncidentBrushes(handle, brushes, out);
                     ++cur;
                 }
 
@@ -177,10 +179,8 @@ namespace TrenchBroom {
             void select(const Lasso& lasso, const bool modifySelection) {
                 using HandleList = std::vector<H>;
 
-                const HandleList allHandles = handleManager().allHandles();
                 HandleList selectedHandles;
-
-                lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+                handleManager().findHandles(lasso.volume(), std::back_inserter(selectedHandles));
                 if (!modifySelection) {
                     handleManager().deselectAll();
                 }
@@ -24,6 +24,7 @@
 
 #include <set>
 #include <sstream>
+#include <vector>
 
 #include "Catch2.h"
 #include "GTestCompat.h"
@@ -489,6 +490,61 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST_CASE("AABBTreeTest.findIntersectorsByDistance", "[AABBTreeTest]") {
+        AABB tree;
+        tree.insert(BOX(VEC(+5.0, -1.0, -1.0), VEC(+6.0, +1.0, +1.0)), 3u);
+        tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+1.0, +2.0, -1.0), VEC(+2.0, +3.0, +1.0)), 4u);
+
+        std::vector<AABB::DataType> actual;
+        std::vector<double> distances;
+        tree.findIntersectorsByDistance(RAY(VEC(-3.0, 0.0, 0.0), VEC::pos_x()), [&](const auto data, const auto distance) {
+            actual.push_back(data);
+            distances.push_back(distance);
+            return true;
+        });
+
+        ASSERT_EQ(std::vector<AABB::DataType>({ 1u, 2u, 3u }), actual);
+        ASSERT_EQ(std::vector<double>({ 1.0, 4.0, 8.0 }), distances);
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsByDistanceFromInside", "[AABBTreeTest]") {
+        AABB tree;
+        tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+3.0, +1.0, +1.0)), 2u);
+
+        std::vector<AABB::DataType> actual;
+        std::vector<double> distances;
+        tree.findIntersectorsByDistance(RAY(VEC(0.0, 0.0, 0.0), VEC::pos_x()), [&](const auto data, const auto distance) {
+            actual.push_back(data);
+            distances.push_back(distance);
+            return true;
+        });
+
+        ASSERT_EQ(std::vector<AABB::DataType>({ 1u, 2u }), actual);
+        ASSERT_EQ(std::vector<double>({ 0.0, 2.0 }), distances);
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsByDistanceStopsEarly", "[AABBTreeTest]") {
+        AABB tree;
+        for (size_t i = 0u; i < 16u; ++i) {
+            const auto min = static_cast<double>(2u * i);
+            tree.insert(BOX(VEC(min, -1.0, -1.0), VEC(min + 1.0, +1.0, +1.0)), i);
+        }
+
+        std::vector<AABB::DataType> actual;
+        tree.findIntersectorsByDistance(RAY(VEC(-1.0, 0.0, 0.0), VEC::pos_x()), [&](const auto data, const auto distance) {
+            if (distance > 5.0) {
+                return false;
+            }
+            actual.push_back(data);
+            return true;
+        });
+
+        ASSERT_EQ(std::vector<AABB::DataType>({ 0u, 1u, 2u }), actual);
+    }
+
     void assertTree(const std::string& exp, const AABB& actual) {
         std::stringstream str;
         actual.print(str);
@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GTestCompat.h"
+
+#include "Assets/EntityModelLod.h"
+#include "Renderer/PrimType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static EntityModelVertex vertex(const float x, const float y, const float z) {
+            return EntityModelVertex(vm::vec3f(x, y, z), vm::vec2f(x, y));
+        }
+
+        static std::vector<vm::vec3f> positions(const std::vector<EntityModelVertex>& vertices) {
+            std::vector<vm::vec3f> result;
+            for (const auto& v : vertices) {
+                result.push_back(Renderer::getVertexComponent<0>(v));
+            }
+            return result;
+        }
+
+        /**
+         * Returns the triangles of a flat grid of n * n quads in the XY plane.
+         */
+        static std::vector<EntityModelVertex> grid(const size_t n) {
+            std::vector<EntityModelVertex> result;
+            for (size_t x = 0; x < n; ++x) {
+                for (size_t y = 0; y < n; ++y) {
+                    const auto x0 = static_cast<float>(x), x1 = static_cast<float>(x + 1u);
+                    const auto y0 = static_cast<float>(y), y1 = static_cast<float>(y + 1u);
+                    result.push_back(vertex(x0, y0, 0.0f));
+                    result.push_back(vertex(x1, y0, 0.0f));
+                    result.push_back(vertex(x1, y1, 0.0f));
+                    result.push_back(vertex(x0, y0, 0.0f));
+                    result.push_back(vertex(x1, y1, 0.0f));
+                    result.push_back(vertex(x0, y1, 0.0f));
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE("EntityModelLodTest.selectEntityModelLod", "[EntityModelLodTest]") {
+            ASSERT_EQ(EntityModelLod::Full, selectEntityModelLod(FullLodMinProjectedSize));
+            ASSERT_EQ(EntityModelLod::Simplified, selectEntityModelLod(FullLodMinProjectedSize - 1.0f));
+            ASSERT_EQ(EntityModelLod::Simplified, selectEntityModelLod(SimplifiedLodMinProjectedSize));
+            ASSERT_EQ(EntityModelLod::Proxy, selectEntityModelLod(SimplifiedLodMinProjectedSize - 1.0f));
+        }
+
+        TEST_CASE("EntityModelLodTest.appendTriangles", "[EntityModelLodTest]") {
+            const auto vertices = std::vector<EntityModelVertex>{
+                vertex(0, 0, 0),
+                vertex(1, 0, 0),
+                vertex(1, 1, 0),
+                vertex(0, 1, 0),
+            };
+
+            std::vector<EntityModelVertex> triangles;
+
+            SECTION("Lines are ignored") {
+                appendTriangles(vertices, Renderer::PrimType::Lines, 0u, 4u, triangles);
+                ASSERT_TRUE(triangles.empty());
+            }
+
+            SECTION("Triangle fan") {
+                appendTriangles(vertices, Renderer::PrimType::TriangleFan, 0u, 4u, triangles);
+                ASSERT_EQ(std::vector<vm::vec3f>({
+                    vm::vec3f(0, 0, 0), vm::vec3f(1, 0, 0), vm::vec3f(1, 1, 0),
+                    vm::vec3f(0, 0, 0), vm::vec3f(1, 1, 0), vm::vec3f(0, 1, 0),
+                }), positions(triangles));
+            }
+
+            SECTION("Triangle strip keeps the winding order") {
+                appendTriangles(vertices, Renderer::PrimType::TriangleStrip, 0u, 4u, triangles);
+                ASSERT_EQ(std::vector<vm::vec3f>({
+                    vm::vec3f(0, 0, 0), vm::vec3f(1, 0, 0), vm::vec3f(1, 1, 0),
+                    vm::vec3f(1, 0, 0), vm::vec3f(0, 1, 0), vm::vec3f(1, 1, 0),
+                }), positions(triangles));
+            }
+
+            SECTION("Quads") {
+                appendTriangles(vertices, Renderer::PrimType::Quads, 0u, 4u, triangles);
+                ASSERT_EQ(6u, triangles.size());
+            }
+        }
+
+        TEST_CASE("EntityModelLodTest.decimateTriangles", "[EntityModelLodTest]") {
+            SECTION("Empty input") {
+                ASSERT_TRUE(decimateTriangles({}, 4u).empty());
+            }
+
+            SECTION("Coarse grid keeps a single triangle") {
+                const auto triangle = std::vector<EntityModelVertex>{
+                    vertex(0, 0, 0),
+                    vertex(8, 0, 0),
+                    vertex(8, 8, 0),
+                };
+                ASSERT_EQ(positions(triangle), positions(decimateTriangles(triangle, 2u)));
+            }
+
+            SECTION("Fine mesh is simplified") {
+                const auto triangles = grid(16u);
+                const auto simplified = decimateTriangles(triangles, 4u);
+
+                ASSERT_FALSE(simplified.empty());
+                ASSERT_EQ(0u, simplified.size() % 3u);
+                ASSERT_LT(simplified.size(), triangles.size());
+
+                // a 4 * 4 grid of cells yields at most two triangles per cell
+                ASSERT_LE(simplified.size(), 4u * 4u * 2u * 3u);
+
+                for (size_t i = 0; i < simplified.size(); i += 3u) {
+                    const auto& p1 = Renderer::getVertexComponent<0>(simplified[i + 0u]);
+                    const auto& p2 = Renderer::getVertexComponent<0>(simplified[i + 1u]);
+                    const auto& p3 = Renderer::getVertexComponent<0>(simplified[i + 2u]);
+                    ASSERT_NE(p1, p2);
+                    ASSERT_NE(p2, p3);
+                    ASSERT_NE(p3, p1);
+
+                    // the winding order of the grid is retained
+                    ASSERT_GT(vm::cross(p2 - p1, p3 - p1).z(), 0.0f);
+                }
+            }
+        }
+
+        TEST_CASE("EntityModelLodTest.buildProxyTriangles", "[EntityModelLodTest]") {
+            const auto bounds = vm::bbox3f(vm::vec3f(-8, -8, 0), vm::vec3f(8, 8, 32));
+            const auto triangles = buildProxyTriangles(bounds);
+
+            ASSERT_EQ(36u, triangles.size());
+
+            for (const auto& position : positions(triangles)) {
+                ASSERT_TRUE(position.x() == bounds.min.x() || position.x() == bounds.max.x());
+                ASSERT_TRUE(position.y() == bounds.min.y() || position.y() == bounds.max.y());
+                ASSERT_TRUE(position.z() == bounds.min.z() || position.z() == bounds.max.z());
+            }
+
+            // entity models use clockwise front faces, so every triangle's normal points into the box
+            for (size_t i = 0; i < triangles.size(); i += 3u) {
+                const auto& p1 = Renderer::getVertexComponent<0>(triangles[i + 0u]);
+                const auto& p2 = Renderer::getVertexComponent<0>(triangles[i + 1u]);
+                const auto& p3 = Renderer::getVertexComponent<0>(triangles[i + 2u]);
+                const auto normal = vm::cross(p2 - p1, p3 - p1);
+                const auto toCenter = bounds.center() - (p1 + p2 + p3) / 3.0f;
+                ASSERT_GT(vm::dot(normal, toCenter), 0.0f);
+            }
+        }
+    }
+}
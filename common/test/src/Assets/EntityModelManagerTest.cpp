@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+
+#include <vecmath/bbox.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TestEntityModelLoader : public IO::EntityModelLoader {
+        public:
+            mutable std::atomic<size_t> initializeCount{0};
+        private:
+            std::unique_ptr<EntityModel> doInitializeModel(const IO::Path& path, Logger&) const override {
+                ++initializeCount;
+                if (path == IO::Path("missing.mdl")) {
+                    throw GameException("Could not load " + path.asString());
+                }
+
+                auto model = std::make_unique<EntityModel>(path.asString(), PitchType::Normal);
+                model->addFrames(2);
+                return model;
+            }
+
+            void doLoadFrame(const IO::Path&, const size_t frameIndex, EntityModel& model, Logger&) const override {
+                model.loadFrame(frameIndex, "frame", vm::bbox3f(8.0f));
+            }
+        };
+
+        TEST_CASE("EntityModelManagerTest.loadModel", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            TestEntityModelLoader loader;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+
+            const auto spec = ModelSpecification(IO::Path("model.mdl"), 0, 1);
+            const auto* frame = manager.frame(spec);
+            ASSERT_NE(nullptr, frame);
+            ASSERT_TRUE(frame->loaded());
+            ASSERT_EQ(1u, frame->index());
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadModelInBackground", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            TestEntityModelLoader loader;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadModelsInBackground(true);
+
+            const auto spec = ModelSpecification(IO::Path("model.mdl"), 0, 1);
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_TRUE(manager.hasPendingModels());
+            ASSERT_TRUE(manager.isLoadingModel(IO::Path("model.mdl")));
+            ASSERT_FALSE(manager.isLoadingModel(IO::Path("other.mdl")));
+
+            manager.waitForPendingModels();
+            ASSERT_EQ(std::vector<IO::Path>{IO::Path("model.mdl")}, manager.finishLoadingModels());
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_FALSE(manager.isLoadingModel(IO::Path("model.mdl")));
+            ASSERT_EQ(1u, loader.initializeCount.load());
+
+            const auto* frame = manager.frame(spec);
+            ASSERT_NE(nullptr, frame);
+            ASSERT_TRUE(frame->loaded());
+            ASSERT_EQ(1u, frame->index());
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadMissingModelInBackground", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            TestEntityModelLoader loader;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadModelsInBackground(true);
+
+            const auto spec = ModelSpecification(IO::Path("missing.mdl"));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+
+            manager.waitForPendingModels();
+            ASSERT_EQ(std::vector<IO::Path>{IO::Path("missing.mdl")}, manager.finishLoadingModels());
+
+            // the model is not requested again
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+        }
+
+        TEST_CASE("EntityModelManagerTest.clearWhileLoadingInBackground", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            TestEntityModelLoader loader;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadModelsInBackground(true);
+
+            ASSERT_EQ(nullptr, manager.frame(ModelSpecification(IO::Path("model.mdl"))));
+            manager.clear();
+
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_TRUE(manager.finishLoadingModels().empty());
+        }
+    }
+}
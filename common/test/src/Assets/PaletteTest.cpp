@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GTestCompat.h"
+
+#include "Color.h"
+#include "Assets/Palette.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/Reader.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static Palette makeTestPalette() {
+            auto data = std::vector<unsigned char>();
+            data.reserve(768);
+            for (size_t i = 0; i < 256; ++i) {
+                data.push_back(static_cast<unsigned char>(i));
+                data.push_back(static_cast<unsigned char>(255 - i));
+                data.push_back(static_cast<unsigned char>(i / 2));
+            }
+            return Palette(data);
+        }
+
+        TEST_CASE("PaletteTest.indexedToRgba", "[PaletteTest]") {
+            const auto palette = makeTestPalette();
+
+            // the pixel count is not a multiple of 4 to exercise the tail of the conversion
+            const unsigned char indices[] = { 0, 1, 2, 255, 255, 3 };
+            const auto pixelCount = sizeof(indices);
+
+            const auto transparency = GENERATE(PaletteTransparency::Opaque, PaletteTransparency::Index255Transparent);
+
+            auto reader = IO::Reader::from(reinterpret_cast<const char*>(indices), reinterpret_cast<const char*>(indices) + pixelCount).buffer();
+            auto rgbaImage = TextureBuffer(4 * pixelCount);
+            auto averageColor = Color();
+
+            const auto hasTransparency = palette.indexedToRgba(reader, pixelCount, rgbaImage, transparency, averageColor);
+            ASSERT_EQ(transparency == PaletteTransparency::Index255Transparent, hasTransparency);
+            ASSERT_EQ(pixelCount, reader.position());
+
+            for (size_t i = 0; i < pixelCount; ++i) {
+                const auto index = indices[i];
+                const auto* pixel = rgbaImage.data() + 4 * i;
+                ASSERT_EQ(index, pixel[0]);
+                ASSERT_EQ(255 - index, pixel[1]);
+                ASSERT_EQ(index / 2, pixel[2]);
+
+                const auto expectedAlpha = (index == 255 && transparency == PaletteTransparency::Index255Transparent) ? 0 : 255;
+                ASSERT_EQ(expectedAlpha, pixel[3]);
+            }
+
+            ASSERT_FLOAT_EQ(516.0f / (255.0f * 6.0f), averageColor.r());
+            ASSERT_FLOAT_EQ(1014.0f / (255.0f * 6.0f), averageColor.g());
+            ASSERT_FLOAT_EQ(256.0f / (255.0f * 6.0f), averageColor.b());
+            ASSERT_FLOAT_EQ(1.0f, averageColor.a());
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GTestCompat.h"
+
+#include "Assets/TextureArrayLayout.h"
+
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        using Entry = TextureArrayLayout::Entry;
+        using Slot = TextureArrayLayout::Slot;
+
+        TEST_CASE("TextureArrayLayoutTest.emptyLayout", "[TextureArrayLayoutTest]") {
+            const auto layout = TextureArrayLayout(std::vector<Entry>{}, 16u);
+            ASSERT_TRUE(layout.arrays().empty());
+            ASSERT_EQ(0u, layout.packedTextureCount());
+        }
+
+        TEST_CASE("TextureArrayLayoutTest.groupBySize", "[TextureArrayLayoutTest]") {
+            const auto layout = TextureArrayLayout({
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+                Entry{ 32u, 32u, GL_RGBA, 4u, true },
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+                Entry{ 32u, 32u, GL_RGBA, 4u, true },
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+            }, 16u);
+
+            ASSERT_EQ(2u, layout.arrays().size());
+            ASSERT_EQ(5u, layout.packedTextureCount());
+
+            const auto& first = layout.arrays()[0];
+            ASSERT_EQ(64u, first.width);
+            ASSERT_EQ(64u, first.height);
+            ASSERT_EQ(std::vector<size_t>({ 0u, 2u, 4u }), first.textures);
+
+            const auto& second = layout.arrays()[1];
+            ASSERT_EQ(32u, second.width);
+            ASSERT_EQ(std::vector<size_t>({ 1u, 3u }), second.textures);
+
+            ASSERT_EQ(std::optional<Slot>(Slot{ 0u, 2u }), layout.slot(4u));
+            ASSERT_EQ(std::optional<Slot>(Slot{ 1u, 1u }), layout.slot(3u));
+        }
+
+        TEST_CASE("TextureArrayLayoutTest.requireSameFormatAndMipLevels", "[TextureArrayLayoutTest]") {
+            const auto layout = TextureArrayLayout({
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+                Entry{ 64u, 64u, GL_BGRA, 4u, true },
+                Entry{ 64u, 64u, GL_RGBA, 1u, true },
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+            }, 16u);
+
+            ASSERT_EQ(1u, layout.arrays().size());
+            ASSERT_EQ(std::vector<size_t>({ 0u, 3u }), layout.arrays()[0].textures);
+            ASSERT_EQ(std::nullopt, layout.slot(1u));
+            ASSERT_EQ(std::nullopt, layout.slot(2u));
+        }
+
+        TEST_CASE("TextureArrayLayoutTest.skipUnpackableTextures", "[TextureArrayLayoutTest]") {
+            const auto layout = TextureArrayLayout({
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+                Entry{ 64u, 64u, GL_RGBA, 4u, false },
+                Entry{ 64u, 64u, GL_RGBA, 4u, true },
+            }, 16u);
+
+            ASSERT_EQ(2u, layout.packedTextureCount());
+            ASSERT_EQ(std::nullopt, layout.slot(1u));
+            ASSERT_EQ(std::optional<Slot>(Slot{ 0u, 1u }), layout.slot(2u));
+        }
+
+        TEST_CASE("TextureArrayLayoutTest.splitAtMaxLayers", "[TextureArrayLayoutTest]") {
+            const auto entries = std::vector<Entry>(5u, Entry{ 16u, 16u, GL_RGBA, 4u, true });
+
+            SECTION("Last array is large enough") {
+                const auto layout = TextureArrayLayout(entries, 3u);
+                ASSERT_EQ(2u, layout.arrays().size());
+                ASSERT_EQ(std::vector<size_t>({ 0u, 1u, 2u }), layout.arrays()[0].textures);
+                ASSERT_EQ(std::vector<size_t>({ 3u, 4u }), layout.arrays()[1].textures);
+            }
+
+            SECTION("Last array is too small") {
+                const auto layout = TextureArrayLayout(entries, 4u);
+                ASSERT_EQ(1u, layout.arrays().size());
+                ASSERT_EQ(4u, layout.packedTextureCount());
+                ASSERT_EQ(std::nullopt, layout.slot(4u));
+            }
+        }
+    }
+}
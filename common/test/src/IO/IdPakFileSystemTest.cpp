@@ -139,5 +139,24 @@ namespace TrenchBroom {
 
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST_CASE("IdPakFileSystemTest.lookupIgnoresCaseAndRelativeComponents", "[IdPakFileSystemTest]") {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Pak/pak1.pak");
+
+            const IdPakFileSystem fs(pakPath);
+            ASSERT_TRUE(fs.fileExists(Path("TEXTURES/E1U1/BrLava.WAL")));
+            ASSERT_TRUE(fs.fileExists(Path("pics/../textures/e1u1/brlava.wal")));
+            ASSERT_FALSE(fs.fileExists(Path("textures/e1u1")));
+            ASSERT_FALSE(fs.directoryExists(Path("textures/e1u1/brlava.wal")));
+
+            ASSERT_TRUE(fs.openFile(Path("Textures/E1U2/Angle1_1.wal")) != nullptr);
+            ASSERT_TRUE(fs.openFile(Path("pics/./tag1.pcx")) != nullptr);
+            ASSERT_THROW(fs.openFile(Path("textures/e1u1/missing.wal")), FileSystemException);
+
+            const auto items = fs.findItems(Path("TEXTURES/E1U3"));
+            ASSERT_EQ(2u, items.size());
+            ASSERT_TRUE(std::find(std::begin(items), std::end(items), Path("TEXTURES/E1U3/stairs1_3.wal")) != std::end(items));
+            ASSERT_TRUE(std::find(std::begin(items), std::end(items), Path("TEXTURES/E1U3/stflr1_5.wal")) != std::end(items));
+        }
     }
 }
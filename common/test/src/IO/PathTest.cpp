@@ -328,6 +328,25 @@ namespace TrenchBroom {
             ASSERT_FALSE(Path("dir/dir2/dir3") < Path("dir/dir2"));
         }
 
+        TEST_CASE("PathTest.hash", "[PathTest]") {
+            ASSERT_EQ(Path("").hash(), Path().hash());
+            ASSERT_EQ(Path("asdf/test").hash(), Path("ASDF/Test").hash());
+            ASSERT_EQ(Path("asdf/test").hash(), Path("asdf/./blah/../test").makeCanonical().hash());
+            ASSERT_EQ(Path("asdf/Test").hash(), Path("asdf/Test").makeLowerCase().hash());
+            ASSERT_NE(Path("/asdf/test").hash(), Path("asdf/test").hash());
+            ASSERT_NE(Path("asdf/test").hash(), Path("asdft/est").hash());
+        }
+
+        TEST_CASE("PathTest.copyAndMove", "[PathTest]") {
+            auto path = Path("/asdf/test");
+            const auto copy = path;
+            ASSERT_EQ(path, copy);
+
+            const auto moved = std::move(path);
+            ASSERT_EQ(copy, moved);
+            ASSERT_EQ(std::string("/asdf/test"), moved.asString("/"));
+        }
+
         TEST_CASE("PathTest.pathAsQString", "[PathTest]") {
             ASSERT_EQ(QString::fromLatin1("/asdf/test"), pathAsQString(Path("/asdf/test")));
             ASSERT_EQ(QString::fromLatin1("asdf/test"), pathAsQString(Path("asdf/test")));
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GTestCompat.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "IO/Path.h"
+#include "IO/SkinCache.h"
+
+#include <memory>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST_CASE("SkinCacheTest.shareSkin", "[SkinCacheTest]") {
+            size_t loadCount = 0u;
+            const auto loadSkin = [&]() {
+                ++loadCount;
+                return Assets::Texture("skin", 16, 16);
+            };
+
+            SkinCache cache;
+            const auto skin1 = cache.skin(Path("models/skin.pcx"), loadSkin);
+            const auto skin2 = cache.skin(Path("models/skin.pcx"), loadSkin);
+            const auto skin3 = cache.skin(Path("models/other.pcx"), loadSkin);
+
+            ASSERT_EQ(2u, loadCount);
+            ASSERT_EQ(skin1, skin2);
+            ASSERT_NE(skin1, skin3);
+            ASSERT_EQ(1u, skin1->textureCount());
+            ASSERT_EQ(2u, cache.size());
+        }
+
+        TEST_CASE("SkinCacheTest.releaseUnusedSkin", "[SkinCacheTest]") {
+            size_t loadCount = 0u;
+            const auto loadSkin = [&]() {
+                ++loadCount;
+                return Assets::Texture("skin", 16, 16);
+            };
+
+            SkinCache cache;
+            auto skin = cache.skin(Path("models/skin.pcx"), loadSkin);
+            ASSERT_EQ(1u, cache.size());
+
+            skin.reset();
+            ASSERT_EQ(0u, cache.size());
+
+            skin = cache.skin(Path("models/skin.pcx"), loadSkin);
+            ASSERT_EQ(2u, loadCount);
+        }
+
+        TEST_CASE("SkinCacheTest.clear", "[SkinCacheTest]") {
+            const auto loadSkin = []() { return Assets::Texture("skin", 16, 16); };
+
+            SkinCache cache;
+            const auto skin1 = cache.skin(Path("models/skin.pcx"), loadSkin);
+            cache.clear();
+
+            // the skin is still valid, but it is not shared anymore
+            ASSERT_EQ(0u, cache.size());
+            ASSERT_EQ(1u, skin1->textureCount());
+
+            const auto skin2 = cache.skin(Path("models/skin.pcx"), loadSkin);
+            ASSERT_NE(skin1, skin2);
+        }
+
+        TEST_CASE("SkinCacheTest.loadWithoutCache", "[SkinCacheTest]") {
+            const auto loadSkin = []() { return Assets::Texture("skin", 16, 16); };
+
+            const auto skin1 = loadCachedSkin(nullptr, Path("models/skin.pcx"), loadSkin);
+            const auto skin2 = loadCachedSkin(nullptr, Path("models/skin.pcx"), loadSkin);
+            ASSERT_NE(skin1, skin2);
+            ASSERT_EQ(1u, skin1->textureCount());
+        }
+    }
+}
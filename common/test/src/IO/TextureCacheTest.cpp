@@ -0,0 +1,182 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST_CASE("TextureCacheTest.makeKey", "[TextureCacheTest]") {
+            const auto data1 = std::string("some texture data");
+            const auto data2 = std::string("some other texture data");
+            const auto path1 = Path("textures/a.wal");
+            const auto path2 = Path("textures/b.wal");
+
+            const auto makeKey = [](const std::string& data, const Path& path, const std::string& salt) {
+                return TextureCache::makeKey(data.data(), data.data() + data.size(), path, salt);
+            };
+
+            ASSERT_EQ(makeKey(data1, path1, "wal"), makeKey(data1, path1, "wal"));
+            ASSERT_NE(makeKey(data1, path1, "wal"), makeKey(data2, path1, "wal"));
+            ASSERT_NE(makeKey(data1, path1, "wal"), makeKey(data1, path2, "wal"));
+            ASSERT_NE(makeKey(data1, path1, "wal"), makeKey(data1, path1, "idmip"));
+        }
+
+        static Assets::Texture createTexture(const std::string& name) {
+            auto buffers = Assets::TextureBufferList();
+            buffers.emplace_back(4 * 4 * 2);
+            std::memset(buffers.front().data(), 0x7f, buffers.front().size());
+            return Assets::Texture(name, 4, 2, Color(), std::move(buffers), GL_RGBA, Assets::TextureType::Opaque);
+        }
+
+        TEST_CASE("TextureCacheTest.writeAndRead", "[TextureCacheTest]") {
+            const auto env = TestEnvironment("TextureCacheTest");
+            const auto cache = TextureCache(env.dir() + Path("cache"));
+
+            const auto key = std::string("0123456789abcdef-42");
+            ASSERT_FALSE(cache.read(key).has_value());
+
+            auto buffers = Assets::TextureBufferList();
+            buffers.emplace_back(4 * 4 * 2);
+            buffers.emplace_back(4 * 2 * 1);
+            for (auto& buffer : buffers) {
+                for (size_t i = 0; i < buffer.size(); ++i) {
+                    buffer.data()[i] = static_cast<unsigned char>(i);
+                }
+            }
+
+            const auto averageColor = Color(0.25f, 0.5f, 0.75f, 1.0f);
+            const auto texture = Assets::Texture("some_texture", 4, 2, averageColor, std::move(buffers), GL_RGBA, Assets::TextureType::Masked);
+            cache.write(key, texture);
+
+            const auto cached = cache.read(key);
+            ASSERT_TRUE(cached.has_value());
+            ASSERT_EQ(texture.name(), cached->name());
+            ASSERT_EQ(texture.width(), cached->width());
+            ASSERT_EQ(texture.height(), cached->height());
+            ASSERT_EQ(texture.format(), cached->format());
+            ASSERT_EQ(texture.type(), cached->type());
+            ASSERT_EQ(texture.averageColor(), cached->averageColor());
+
+            const auto& expectedBuffers = texture.buffersIfUnprepared();
+            const auto& cachedBuffers = cached->buffersIfUnprepared();
+            ASSERT_EQ(expectedBuffers.size(), cachedBuffers.size());
+            for (size_t i = 0; i < expectedBuffers.size(); ++i) {
+                ASSERT_EQ(expectedBuffers[i].size(), cachedBuffers[i].size());
+                ASSERT_EQ(0, std::memcmp(expectedBuffers[i].data(), cachedBuffers[i].data(), expectedBuffers[i].size()));
+            }
+        }
+
+        TEST_CASE("TextureCacheTest.doNotWriteTextureWithoutPixels", "[TextureCacheTest]") {
+            const auto env = TestEnvironment("TextureCacheTest");
+            const auto cache = TextureCache(env.dir() + Path("cache"));
+
+            const auto key = std::string("0123456789abcdef-42");
+            cache.write(key, Assets::Texture("some_texture", 16, 16));
+            ASSERT_FALSE(cache.read(key).has_value());
+        }
+
+        TEST_CASE("TextureCacheTest.rejectInvalidEntries", "[TextureCacheTest]") {
+            const auto env = TestEnvironment("TextureCacheTest");
+            const auto cache = TextureCache(env.dir() + Path("cache"));
+
+            const auto key = std::string("0123456789abcdef-42");
+            cache.write(key, createTexture("some_texture"));
+            ASSERT_TRUE(cache.read(key).has_value());
+
+            const auto entryPath = (env.dir() + Path("cache/01/0123456789abcdef-42.tbtx")).asString();
+            const auto entry = [&]() {
+                auto stream = std::ifstream(entryPath, std::ios::binary);
+                return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            }();
+
+            const auto readModified = [&](const std::string& modifiedEntry) {
+                {
+                    auto stream = std::ofstream(entryPath, std::ios::binary | std::ios::trunc);
+                    stream.write(modifiedEntry.data(), static_cast<std::streamsize>(modifiedEntry.size()));
+                }
+                return cache.read(key);
+            };
+
+            const auto replaceAt = [&](const size_t offset, const std::string& bytes) {
+                auto result = entry;
+                result.replace(offset, bytes.size(), bytes);
+                return result;
+            };
+
+            // magic, version, name length and name
+            const auto widthOffset = size_t(4 + 4 + 4 + 12);
+            // width, height, format, type and average color
+            const auto mipCountOffset = widthOffset + 4 * 4 + 4 * 4;
+            const auto mipSizeOffset = mipCountOffset + 4;
+
+            ASSERT_FALSE(readModified(replaceAt(8, "\xff\xff\xff\x7f")).has_value());
+            ASSERT_FALSE(readModified(replaceAt(widthOffset, "\xff\xff\xff\xff")).has_value());
+            ASSERT_FALSE(readModified(replaceAt(mipCountOffset, "\xff\xff\xff\xff")).has_value());
+            ASSERT_FALSE(readModified(replaceAt(mipCountOffset, std::string("\x04\x00\x00\x00", 4))).has_value());
+            ASSERT_FALSE(readModified(replaceAt(mipSizeOffset, "\xff\xff\xff\xff\xff\xff\xff\xff")).has_value());
+            ASSERT_FALSE(readModified(replaceAt(mipSizeOffset, std::string("\x10\x00\x00\x00\x00\x00\x00\x00", 8))).has_value());
+            ASSERT_FALSE(readModified(entry.substr(0, entry.size() - 1)).has_value());
+
+            ASSERT_TRUE(readModified(entry).has_value());
+        }
+
+        TEST_CASE("TextureCacheTest.evictEntries", "[TextureCacheTest]") {
+            const auto env = TestEnvironment("TextureCacheTest");
+
+            // each entry takes 100 bytes
+            const auto cache = TextureCache(env.dir() + Path("cache"), 250);
+
+            const auto keys = std::vector<std::string>{
+                "0123456789abcdef-1",
+                "0123456789abcdef-2",
+                "0123456789abcdef-3"
+            };
+
+            cache.write(keys[0], createTexture("some_texture"));
+            cache.write(keys[1], createTexture("some_texture"));
+            ASSERT_TRUE(cache.read(keys[0]).has_value());
+            ASSERT_TRUE(cache.read(keys[1]).has_value());
+
+            // exceeding the maximum size reduces the cache to three quarters of it
+            cache.write(keys[2], createTexture("some_texture"));
+
+            size_t remaining = 0;
+            for (const auto& key : keys) {
+                if (cache.read(key).has_value()) {
+                    ++remaining;
+                }
+            }
+            ASSERT_EQ(1u, remaining);
+        }
+    }
+}
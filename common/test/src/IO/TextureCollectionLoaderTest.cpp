@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/File.h"
+#include "IO/FileMatcher.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureCollectionLoader.h"
+#include "IO/TextureReader.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Reads textures from files containing "ok", "flaky" or "bad". Flaky textures can only be read on the second
+         * attempt, bad textures cannot be read at all.
+         */
+        class TestTextureReader : public TextureReader {
+        private:
+            mutable std::mutex m_mutex;
+            mutable std::map<std::string, size_t> m_readCounts;
+        public:
+            TestTextureReader(const FileSystem& fs, Logger& logger) :
+            TextureReader(PathSuffixNameStrategy(1), fs, logger) {}
+
+            size_t readCount(const std::string& name) const {
+                const auto lock = std::lock_guard<std::mutex>(m_mutex);
+                const auto it = m_readCounts.find(name);
+                return it != std::end(m_readCounts) ? it->second : 0u;
+            }
+        private:
+            Assets::Texture doReadTexture(std::shared_ptr<File> file) const override {
+                const auto name = textureName(file->path());
+                const auto contents = file->reader().readString(file->size());
+
+                const auto lock = std::lock_guard<std::mutex>(m_mutex);
+                const auto readCount = ++m_readCounts[name];
+                if (contents == "bad" || (contents == "flaky" && readCount == 1u)) {
+                    throw AssetException("Cannot read texture " + name);
+                }
+                return Assets::Texture(name, 1, 1);
+            }
+        };
+
+        TEST_CASE("TextureCollectionLoaderTest.readTexturesFromDirectory", "[TextureCollectionLoaderTest]") {
+            TestEnvironment env("TextureCollectionLoaderTest");
+            env.createDirectory(Path("textures"));
+
+            for (size_t i = 0; i < 64u; ++i) {
+                const auto name = std::string(i < 10u ? "tex_0" : "tex_") + std::to_string(i);
+                const auto contents = i == 7u ? "bad" : i % 5u == 3u ? "flaky" : "ok";
+                env.createFile(Path("textures") + Path(name + ".tst"), contents);
+            }
+
+            auto logger = NullLogger();
+            const DiskFileSystem fs(env.dir());
+            const auto textureReader = std::make_shared<TestTextureReader>(fs, logger);
+            REQUIRE(textureReader->canReadConcurrently());
+
+            DirectoryTextureCollectionLoader directoryLoader(logger, fs, {});
+            auto& loader = static_cast<TextureCollectionLoader&>(directoryLoader);
+            const auto collection = loader.loadTextureCollection(Path("textures"), {"tst"}, textureReader, false);
+
+            const auto texturePaths = fs.findItems(Path("textures"), FileExtensionMatcher("tst"));
+            const auto& textures = collection.textures();
+            REQUIRE(textures.size() == texturePaths.size());
+
+            for (size_t i = 0; i < texturePaths.size(); ++i) {
+                const auto name = texturePaths[i].lastComponent().deleteExtension().asString();
+                CHECK(textures[i].name() == name);
+                CHECK(textures[i].relativePath() == texturePaths[i]);
+
+                if (name == "tex_07") {
+                    // the bad texture is replaced by the default texture after the second attempt failed
+                    CHECK(textureReader->readCount(name) == 2u);
+                    CHECK(textures[i].width() == 32u);
+                } else if (std::stoul(name.substr(4)) % 5u == 3u) {
+                    // flaky textures are read again on the calling thread after reading them in parallel failed
+                    CHECK(textureReader->readCount(name) == 2u);
+                    CHECK(textures[i].width() == 1u);
+                } else {
+                    CHECK(textureReader->readCount(name) == 1u);
+                    CHECK(textures[i].width() == 1u);
+                }
+            }
+        }
+    }
+}
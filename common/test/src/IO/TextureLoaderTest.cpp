@@ -23,6 +23,8 @@
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureCache.h"
 #include "IO/TextureLoader.h"
 #include "Model/GameConfig.h"
 
@@ -139,5 +141,108 @@ namespace TrenchBroom {
             assertTexture("blowjob_machine", 128, 128, textureManager);
             assertTexture("lasthopeofhuman", 128, 128, textureManager);
         }
+
+        TEST_CASE("TextureLoaderTest.testLoadOnDemand", "[TextureLoaderTest]") {
+            const std::vector<IO::Path> paths({ Path("fixture/test/IO/Wad/cr8_czg.wad") });
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(
+                    Model::PackageFormatConfig("wad", "idmip")),
+                    Model::PackageFormatConfig("D", "idmip"),
+                    IO::Path("fixture/test/palette.lmp"),
+                    "wad",
+                    IO::Path(),
+                    {});
+
+            auto logger = NullLogger();
+            auto textureManager = Assets::TextureManager(0, 0, logger);
+            textureManager.setLoadTexturesOnDemand(true);
+
+            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
+            textureLoader.loadTextures(paths, textureManager);
+
+            assertTexture("cr8_czg_1", 64, 64, textureManager);
+            assertTexture("cr8_czg_3", 64, 128, textureManager);
+            assertTexture("speedM_1", 128, 128, textureManager);
+
+            auto* texture = textureManager.texture("cr8_czg_3");
+            ASSERT_TRUE(texture->pixelsPending());
+            ASSERT_TRUE(texture->buffersIfUnprepared().empty());
+
+            texture->incUsageCount();
+            ASSERT_FALSE(texture->pixelsPending());
+            ASSERT_FALSE(texture->buffersIfUnprepared().empty());
+            ASSERT_EQ(64u, texture->width());
+            ASSERT_EQ(128u, texture->height());
+            texture->decUsageCount();
+
+            ASSERT_TRUE(textureManager.texture("cr8_czg_1")->pixelsPending());
+        }
+
+        TEST_CASE("TextureLoaderTest.testLoadWithCache", "[TextureLoaderTest]") {
+            const std::vector<IO::Path> paths({ Path("fixture/test/IO/Image") });
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(IO::Path("fixture/test/IO")),
+                    Model::PackageFormatConfig(std::vector<std::string>{ "png", "jpg" }, "image"),
+                    IO::Path(),
+                    "",
+                    IO::Path(),
+                    {});
+
+            const auto env = TestEnvironment("TextureLoaderTest");
+            const auto textureCache = std::make_shared<TextureCache>(env.dir() + Path("cache"));
+
+            auto logger = NullLogger();
+
+            // the first load populates the cache, the second load reads from it
+            for (size_t i = 0; i < 2; ++i) {
+                auto textureManager = Assets::TextureManager(0, 0, logger);
+
+                IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger, textureCache);
+                textureLoader.loadTextures(paths, textureManager);
+
+                assertTexture("Image/5x5", 5, 5, textureManager);
+                assertTexture("Image/707x710", 707, 710, textureManager);
+                ASSERT_TRUE(env.directoryExists(Path("cache")));
+            }
+        }
+
+        TEST_CASE("TextureLoaderTest.testLoadPalettedTexturesWithoutCache", "[TextureLoaderTest]") {
+            const std::vector<IO::Path> paths({ Path("fixture/test/IO/Wad/cr8_czg.wad") });
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(
+                    Model::PackageFormatConfig("wad", "idmip")),
+                    Model::PackageFormatConfig("D", "idmip"),
+                    IO::Path("fixture/test/palette.lmp"),
+                    "wad",
+                    IO::Path(),
+                    {});
+
+            const auto env = TestEnvironment("TextureLoaderTest");
+            const auto textureCache = std::make_shared<TextureCache>(env.dir() + Path("cache"));
+
+            auto logger = NullLogger();
+            auto textureManager = Assets::TextureManager(0, 0, logger);
+
+            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger, textureCache);
+            textureLoader.loadTextures(paths, textureManager);
+
+            assertTexture("cr8_czg_1", 64, 64, textureManager);
+            ASSERT_FALSE(env.directoryExists(Path("cache")));
+        }
     }
 }
@@ -20,11 +20,16 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/ZipFileSystem.h"
 
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
 #include <algorithm>
 #include <cassert>
+#include <string>
 
 #include "Catch2.h"
 #include "GTestCompat.h"
@@ -141,5 +146,19 @@ namespace TrenchBroom {
 
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST_CASE("ZipFileSystemTest.openFilesConcurrently", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            const auto paths = fs.findItemsRecursively(Path(""), FileTypeMatcher(true, false));
+            const auto readContents = [&](const Path& path) {
+                return std::string(fs.openFile(path)->reader().buffer().stringView());
+            };
+
+            const auto expected = kdl::vec_transform(paths, readContents);
+            const auto actual = kdl::vec_parallel_transform(paths, [&](Path&& path) { return readContents(path); });
+            ASSERT_EQ(expected, actual);
+        }
     }
 }
@@ -26,11 +26,15 @@
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
 #include "Model/Node.h"
 #include "Model/Object.h"
 #include "Model/PickResult.h"
+#include "Model/WorldBoundsIssueGenerator.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
@@ -45,6 +49,7 @@
 #include <vecmath/mat_io.h>
 #include <vecmath/mat_ext.h>
 
+#include <memory>
 #include <vector>
 #include <variant>
 
@@ -344,6 +349,73 @@ namespace TrenchBroom {
             ASSERT_EQ(3u, child->familySize());
         }
 
+        TEST_CASE("NodeTest.issuesValid", "[NodeTest]") {
+            TestNode root;
+            TestNode* child = new TestNode();
+            root.addChild(child);
+
+            ASSERT_FALSE(root.issuesValid());
+            ASSERT_FALSE(child->issuesValid());
+
+            root.issues({});
+            child->issues({});
+            ASSERT_TRUE(root.issuesValid());
+            ASSERT_TRUE(child->issuesValid());
+
+            // adding a child only invalidates the issues of its ancestors
+            TestNode* sibling = new TestNode();
+            root.addChild(sibling);
+            ASSERT_FALSE(root.issuesValid());
+            ASSERT_TRUE(child->issuesValid());
+            ASSERT_FALSE(sibling->issuesValid());
+        }
+
+        TEST_CASE("NodeTest.validateIssuesInParallel", "[NodeTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            WorldNode world(Entity(), MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            // enough nodes to be validated in parallel, every third one has non integer vertices and every fifth one
+            // is outside of the bounds checked by the (not thread safe) world bounds issue generator
+            const auto createBrushNodes = [&]() {
+                auto result = std::vector<std::unique_ptr<BrushNode>>{};
+                for (size_t i = 0u; i < 300u; ++i) {
+                    const auto offset = i % 3u == 0u ? 0.5 : 0.0;
+                    const auto x = i % 5u == 0u ? 2048.0 : 0.0;
+                    const auto min = vm::vec3(x + offset, 0.0, 0.0);
+                    result.push_back(std::make_unique<BrushNode>(builder.createCuboid(vm::bbox3(min, min + vm::vec3(32.0, 32.0, 32.0)), "texture").value()));
+                }
+                return result;
+            };
+
+            NonIntegerVerticesIssueGenerator nonIntegerVerticesIssueGenerator;
+            WorldBoundsIssueGenerator worldBoundsIssueGenerator(vm::bbox3(1024.0));
+            const auto issueGenerators = std::vector<IssueGenerator*>{ &nonIntegerVerticesIssueGenerator, &worldBoundsIssueGenerator };
+            ASSERT_TRUE(nonIntegerVerticesIssueGenerator.threadSafe());
+            ASSERT_FALSE(worldBoundsIssueGenerator.threadSafe());
+
+            const auto expectedBrushNodes = createBrushNodes();
+            const auto brushNodes = createBrushNodes();
+            const auto nodes = kdl::vec_transform(brushNodes, [](const auto& brushNode) { return static_cast<Node*>(brushNode.get()); });
+
+            Node::validateIssues(nodes, issueGenerators);
+
+            auto lastSeqId = size_t(0);
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                ASSERT_TRUE(nodes[i]->issuesValid());
+
+                const auto& issues = nodes[i]->issues(issueGenerators);
+                const auto& expectedIssues = expectedBrushNodes[i]->issues(issueGenerators);
+                ASSERT_EQ(expectedIssues.size(), issues.size());
+
+                for (size_t j = 0u; j < issues.size(); ++j) {
+                    ASSERT_EQ(expectedIssues[j]->type(), issues[j]->type());
+                    ASSERT_TRUE(issues[j]->seqId() > lastSeqId);
+                    lastSeqId = issues[j]->seqId();
+                }
+            }
+        }
+
         TEST_CASE("NodeTest.partialSelection", "[NodeTest]") {
             TestNode root;
             TestNode* child1 = new TestNode();
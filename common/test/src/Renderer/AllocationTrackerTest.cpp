@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 #include "Catch2.h"
@@ -246,6 +247,100 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE("AllocationTrackerTest.stats", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+
+            AllocationTracker::Block* a = t.allocate(10);
+            AllocationTracker::Block* b = t.allocate(20);
+            AllocationTracker::Block* c = t.allocate(30);
+            ASSERT_NE(nullptr, a);
+            ASSERT_NE(nullptr, b);
+            ASSERT_NE(nullptr, c);
+
+            t.free(b);
+
+            const auto stats = t.stats();
+            EXPECT_EQ(100u, stats.capacity);
+            EXPECT_EQ(40u, stats.usedSize);
+            EXPECT_EQ(60u, stats.freeSize);
+            EXPECT_EQ(2u, stats.freeBlockCount);
+            EXPECT_EQ(40u, stats.largestFreeBlock);
+            EXPECT_EQ(40u, stats.trailingFreeSize);
+            EXPECT_EQ(20u, stats.holeSize());
+            EXPECT_DOUBLE_EQ(1.0 / 3.0, stats.fragmentation());
+
+            t.free(a);
+            t.free(c);
+            EXPECT_EQ(0u, t.stats().usedSize);
+            EXPECT_EQ(1u, t.stats().freeBlockCount);
+            EXPECT_DOUBLE_EQ(0.0, t.stats().fragmentation());
+        }
+
+        TEST_CASE("AllocationTrackerTest.compact", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+
+            AllocationTracker::Block* blocks[5];
+            for (size_t i = 0; i < 5; ++i) {
+                blocks[i] = t.allocate(10);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[0]);
+            t.free(blocks[2]);
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 10}, {20, 10}, {50, 50}}), t.freeBlocks());
+
+            // the amount of moved data is bounded
+            const auto firstRelocations = t.compact(10);
+            ASSERT_EQ(1u, firstRelocations.size());
+            EXPECT_EQ(blocks[1], firstRelocations[0].block);
+            EXPECT_EQ(10u, firstRelocations[0].oldPos);
+            EXPECT_EQ(0u, blocks[1]->pos);
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{10, 20}, {50, 50}}), t.freeBlocks());
+
+            const auto secondRelocations = t.compact(100);
+            ASSERT_EQ(2u, secondRelocations.size());
+            EXPECT_EQ(blocks[3], secondRelocations[0].block);
+            EXPECT_EQ(30u, secondRelocations[0].oldPos);
+            EXPECT_EQ(blocks[4], secondRelocations[1].block);
+            EXPECT_EQ(40u, secondRelocations[1].oldPos);
+
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 10}, {10, 10}, {20, 10}}), t.usedBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{30, 70}}), t.freeBlocks());
+            EXPECT_EQ(0u, t.stats().holeSize());
+
+            // nothing left to do
+            EXPECT_TRUE(t.compact(100).empty());
+        }
+
+        TEST_CASE("AllocationTrackerTest.shrink", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+
+            AllocationTracker::Block* a = t.allocate(30);
+            ASSERT_NE(nullptr, a);
+
+            EXPECT_THROW(t.shrink(20), std::invalid_argument);
+            EXPECT_THROW(t.shrink(100), std::invalid_argument);
+
+            t.shrink(50);
+            EXPECT_EQ(50u, t.capacity());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{30, 20}}), t.freeBlocks());
+            EXPECT_EQ(20u, t.largestPossibleAllocation());
+
+            t.shrink(30);
+            EXPECT_EQ(30u, t.capacity());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{}), t.freeBlocks());
+            EXPECT_EQ(0u, t.stats().freeBlockCount);
+            EXPECT_EQ(nullptr, t.allocate(1));
+
+            t.free(a);
+            t.shrink(0);
+            EXPECT_EQ(0u, t.capacity());
+            EXPECT_FALSE(t.hasAllocations());
+
+            t.expand(10);
+            EXPECT_NE(nullptr, t.allocate(10));
+        }
+
         static constexpr size_t NumBrushes = 64'000;
 
         // between 12 and 140, inclusive.
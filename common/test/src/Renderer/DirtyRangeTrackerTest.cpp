@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/BrushRendererArrays.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Range = DirtyRangeTracker::Range;
+
+        TEST_CASE("DirtyRangeTrackerTest.constructor", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            ASSERT_EQ(100u, t.capacity());
+            ASSERT_TRUE(t.clean());
+            ASSERT_EQ(0u, t.dirtySize());
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.expand", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.expand(150);
+            ASSERT_EQ(150u, t.capacity());
+            ASSERT_EQ((std::vector<Range>{{100, 50}}), t.dirtyRanges());
+
+            ASSERT_THROW(t.expand(150), std::invalid_argument);
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.markDirtyOutOfBounds", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            ASSERT_THROW(t.markDirty(90, 11), std::invalid_argument);
+            ASSERT_TRUE(t.clean());
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.markDirtySeparateRanges", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.markDirty(50, 10);
+            t.markDirty(0, 10);
+            t.markDirty(90, 10);
+
+            ASSERT_FALSE(t.clean());
+            ASSERT_EQ((std::vector<Range>{{0, 10}, {50, 10}, {90, 10}}), t.dirtyRanges());
+            ASSERT_EQ(30u, t.dirtySize());
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.markDirtyMergesOverlappingRanges", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.markDirty(10, 10);
+            t.markDirty(50, 10);
+            t.markDirty(15, 40);
+
+            ASSERT_EQ((std::vector<Range>{{10, 50}}), t.dirtyRanges());
+            ASSERT_EQ(50u, t.dirtySize());
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.markDirtyCoalescesCloseRanges", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100, 5);
+            t.markDirty(0, 10);
+            t.markDirty(15, 5);
+            t.markDirty(40, 10);
+            t.markDirty(26, 4);
+
+            ASSERT_EQ((std::vector<Range>{{0, 20}, {26, 4}, {40, 10}}), t.dirtyRanges());
+
+            t.markDirty(34, 2);
+            ASSERT_EQ((std::vector<Range>{{0, 20}, {26, 24}}), t.dirtyRanges());
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.reset", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.markDirty(10, 10);
+            t.markDirty(50, 10);
+            t.reset();
+
+            ASSERT_TRUE(t.clean());
+            ASSERT_EQ(100u, t.capacity());
+            ASSERT_EQ((std::vector<Range>{}), t.dirtyRanges());
+        }
+    }
+}
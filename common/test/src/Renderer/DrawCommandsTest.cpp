@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/DrawCommands.h"
+
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("DrawCommandsTest.empty", "[DrawCommandsTest]") {
+            const DrawCommandList list(0);
+            ASSERT_EQ((std::vector<DrawCommand>{}), list.commands());
+        }
+
+        TEST_CASE("DrawCommandsTest.addMergesAdjacentRanges", "[DrawCommandsTest]") {
+            DrawCommandList list(0);
+            list.add(0, 10);
+            list.add(10, 5);
+            list.add(20, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 15}, {20, 10}}), list.commands());
+        }
+
+        TEST_CASE("DrawCommandsTest.addMergesRangesWithSmallGaps", "[DrawCommandsTest]") {
+            const auto build = [](const size_t maxGap) {
+                DrawCommandList list(maxGap);
+                list.add(40, 10);
+                list.add(5, 10);
+                list.add(52, 3);
+                list.add(20, 5);
+                return list.commands();
+            };
+
+            ASSERT_EQ((std::vector<DrawCommand>{{5, 10}, {20, 5}, {40, 10}, {52, 3}}), build(1));
+            ASSERT_EQ((std::vector<DrawCommand>{{5, 20}, {40, 15}}), build(5));
+            ASSERT_EQ((std::vector<DrawCommand>{{5, 50}}), build(15));
+        }
+
+        TEST_CASE("DrawCommandsTest.addBridgesCommands", "[DrawCommandsTest]") {
+            DrawCommandList list(2);
+            list.add(0, 10);
+            list.add(20, 10);
+            list.add(40, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 10}, {20, 10}, {40, 10}}), list.commands());
+
+            list.add(12, 7);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 30}, {40, 10}}), list.commands());
+
+            list.add(31, 8);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 50}}), list.commands());
+        }
+
+        TEST_CASE("DrawCommandsTest.addWithinCommand", "[DrawCommandsTest]") {
+            DrawCommandList list(5);
+            list.add(0, 10);
+            list.add(20, 10);
+            list.remove(0, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{20, 10}}), list.commands());
+
+            list.add(0, 10);
+            list.add(12, 3);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 30}}), list.commands());
+
+            list.remove(12, 3);
+            list.add(11, 4);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 30}}), list.commands());
+        }
+
+        TEST_CASE("DrawCommandsTest.remove", "[DrawCommandsTest]") {
+            DrawCommandList list(10);
+            list.add(0, 10);
+            list.add(10, 10);
+            list.add(20, 10);
+            list.add(50, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 30}, {50, 10}}), list.commands());
+
+            // a range in the middle of a command is rendered as degenerate primitives
+            list.remove(10, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 30}, {50, 10}}), list.commands());
+
+            list.remove(0, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{10, 20}, {50, 10}}), list.commands());
+
+            list.remove(50, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{10, 20}}), list.commands());
+
+            list.remove(20, 10);
+            ASSERT_EQ((std::vector<DrawCommand>{{10, 10}}), list.commands());
+        }
+
+        TEST_CASE("DrawCommandsTest.truncate", "[DrawCommandsTest]") {
+            DrawCommandList list(0);
+            list.add(0, 10);
+            list.add(20, 10);
+            list.add(40, 10);
+
+            list.truncate(25);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 10}, {20, 5}}), list.commands());
+
+            list.truncate(20);
+            ASSERT_EQ((std::vector<DrawCommand>{{0, 10}}), list.commands());
+        }
+    }
+}
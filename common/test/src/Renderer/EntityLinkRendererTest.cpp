@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/GL.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentTest.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <string>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class EntityLinkRendererTest : public View::MapDocumentTest {
+        protected:
+            EntityLinkRendererTest() {
+                setPref(Preferences::EntityLinkMode, Preferences::entityLinkModeAll());
+            }
+
+            ~EntityLinkRendererTest() override {
+                resetPref(Preferences::EntityLinkMode);
+            }
+
+            Model::EntityNode* addEntity(const std::string& origin, const std::string& key, const std::string& value) {
+                auto* entityNode = new Model::EntityNode({
+                    {Model::PropertyKeys::Classname, "test"},
+                    {Model::PropertyKeys::Origin, origin},
+                    {key, value}
+                });
+                document->addNode(entityNode, document->parentForNodes());
+                return entityNode;
+            }
+        };
+
+        static PerspectiveCamera cameraLookingAt(const vm::vec3f& direction) {
+            return PerspectiveCamera(90.0f, 1.0f, 8192.0f, Camera::Viewport(0, 0, 1024, 768), vm::vec3f::zero(), direction, vm::vec3f::pos_z());
+        }
+
+        // the number of link vertices of each visible link group, sorted
+        static GLCounts visibleLinkCounts(const EntityLinkRenderer& renderer, const Camera& camera) {
+            GLIndices linkIndices, arrowIndices;
+            GLCounts linkCounts, arrowCounts;
+            renderer.collectVisibleGroups(camera, linkIndices, linkCounts, arrowIndices, arrowCounts);
+
+            std::sort(std::begin(linkCounts), std::end(linkCounts));
+            return linkCounts;
+        }
+
+        TEST_CASE_METHOD(EntityLinkRendererTest, "EntityLinkRendererTest.cullLinkGroups", "[EntityLinkRendererTest]") {
+            addEntity("100 0 0", Model::PropertyKeys::Target, "front");
+            addEntity("200 0 0", Model::PropertyKeys::Targetname, "front");
+            addEntity("-100 0 0", Model::PropertyKeys::Target, "back");
+            addEntity("-200 0 0", Model::PropertyKeys::Target, "back");
+            addEntity("-300 0 0", Model::PropertyKeys::Targetname, "back");
+
+            EntityLinkRenderer renderer(document);
+            renderer.validate();
+
+            // every link contributes two vertices, and the links of each source are grouped
+            CHECK(visibleLinkCounts(renderer, cameraLookingAt(vm::vec3f::pos_x())) == GLCounts{ 2 });
+            CHECK(visibleLinkCounts(renderer, cameraLookingAt(vm::vec3f::neg_x())) == GLCounts{ 2, 2 });
+            CHECK(visibleLinkCounts(renderer, cameraLookingAt(vm::vec3f::pos_y())).empty());
+        }
+
+        TEST_CASE_METHOD(EntityLinkRendererTest, "EntityLinkRendererTest.groupLinksBySource", "[EntityLinkRendererTest]") {
+            const auto camera = cameraLookingAt(vm::vec3f::pos_x());
+
+            auto* source = addEntity("100 0 0", Model::PropertyKeys::Target, "target");
+            addEntity("200 0 0", Model::PropertyKeys::Targetname, "target");
+            auto* target = addEntity("300 0 0", Model::PropertyKeys::Targetname, "target");
+
+            EntityLinkRenderer renderer(document);
+            renderer.validate();
+            CHECK(visibleLinkCounts(renderer, camera) == GLCounts{ 4 });
+
+            // the group of the source is rebuilt when a former target changes
+            target->setEntity(Model::Entity({
+                {Model::PropertyKeys::Classname, "test"},
+                {Model::PropertyKeys::Origin, "300 0 0"}
+            }));
+            renderer.invalidateNodes({ target });
+            renderer.validate();
+            CHECK(visibleLinkCounts(renderer, camera) == GLCounts{ 2 });
+
+            // a new source adds a group of its own
+            auto* otherSource = addEntity("400 0 0", Model::PropertyKeys::Target, "target");
+            renderer.invalidateNodes({ otherSource });
+            renderer.validate();
+            CHECK(visibleLinkCounts(renderer, camera) == GLCounts{ 2, 2 });
+
+            // changing the selection only rebuilds the groups of the selected entities: the other source loses its
+            // link without notifying the renderer, so its group is only gone if it was rebuilt
+            otherSource->setEntity(Model::Entity({
+                {Model::PropertyKeys::Classname, "test"},
+                {Model::PropertyKeys::Origin, "400 0 0"}
+            }));
+            document->select(source);
+            renderer.invalidateNodes({ source });
+            renderer.validate();
+            CHECK(visibleLinkCounts(renderer, camera) == GLCounts{ 2, 2 });
+
+            renderer.invalidateNodes({ otherSource });
+            renderer.validate();
+            CHECK(visibleLinkCounts(renderer, camera) == GLCounts{ 2 });
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/IndexRangeMap.h"
+#include "Renderer/PrimType.h"
+
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Range = std::tuple<PrimType, size_t, size_t>;
+
+        static std::vector<Range> ranges(const IndexRangeMap& indexRangeMap) {
+            std::vector<Range> result;
+            indexRangeMap.forEachPrimitive([&](const PrimType primType, const size_t index, const size_t count) {
+                result.emplace_back(primType, index, count);
+            });
+            return result;
+        }
+
+        TEST_CASE("IndexRangeMapTest.addMergesAdjacentIndependentPrimitives", "[IndexRangeMapTest]") {
+            IndexRangeMap indexRangeMap;
+            indexRangeMap.add(PrimType::Triangles, 0, 3);
+            indexRangeMap.add(PrimType::Triangles, 6, 3);
+            indexRangeMap.add(PrimType::Triangles, 9, 6);
+            indexRangeMap.add(PrimType::Triangles, 15, 3);
+
+            ASSERT_EQ((std::vector<Range>{
+                {PrimType::Triangles, 0, 3},
+                {PrimType::Triangles, 6, 12}}), ranges(indexRangeMap));
+        }
+
+        TEST_CASE("IndexRangeMapTest.addKeepsAdjacentStripsSeparate", "[IndexRangeMapTest]") {
+            IndexRangeMap indexRangeMap;
+            indexRangeMap.add(PrimType::TriangleFan, 0, 4);
+            indexRangeMap.add(PrimType::TriangleFan, 4, 5);
+
+            ASSERT_EQ((std::vector<Range>{
+                {PrimType::TriangleFan, 0, 4},
+                {PrimType::TriangleFan, 4, 5}}), ranges(indexRangeMap));
+        }
+
+        TEST_CASE("IndexRangeMapTest.addMapMergesAdjacentIndependentPrimitives", "[IndexRangeMapTest]") {
+            IndexRangeMap indexRangeMap;
+            indexRangeMap.add(PrimType::Triangles, 0, 3);
+            indexRangeMap.add(PrimType::Triangles, 6, 3);
+
+            IndexRangeMap other;
+            other.add(PrimType::Triangles, 9, 3);
+            other.add(PrimType::Triangles, 15, 3);
+
+            indexRangeMap.add(other);
+            ASSERT_EQ((std::vector<Range>{
+                {PrimType::Triangles, 0, 3},
+                {PrimType::Triangles, 6, 6},
+                {PrimType::Triangles, 15, 3}}), ranges(indexRangeMap));
+        }
+
+        TEST_CASE("IndexRangeMapTest.addToPresizedMap", "[IndexRangeMapTest]") {
+            IndexRangeMap::Size size;
+            size.inc(PrimType::Triangles, 3);
+
+            IndexRangeMap indexRangeMap(size);
+            indexRangeMap.add(PrimType::Triangles, 0, 3);
+            indexRangeMap.add(PrimType::Triangles, 3, 3);
+            indexRangeMap.add(PrimType::Triangles, 9, 3);
+
+            ASSERT_EQ((std::vector<Range>{
+                {PrimType::Triangles, 0, 6},
+                {PrimType::Triangles, 9, 3}}), ranges(indexRangeMap));
+        }
+    }
+}
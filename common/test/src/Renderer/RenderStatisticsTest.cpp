@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/RenderStatistics.h"
+
+#include <chrono>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("RenderStatisticsTest.countFrame", "[RenderStatisticsTest]") {
+            RenderStatistics statistics;
+            ASSERT_EQ(0u, statistics.frameCount());
+
+            statistics.beginFrame();
+            statistics.countDrawCall(6);
+            statistics.countDrawCall(36);
+            statistics.countUpload(1024);
+            statistics.addTime(RenderSection::ValidateBrushes, std::chrono::milliseconds(3));
+            statistics.addTime(RenderSection::ValidateBrushes, std::chrono::milliseconds(2));
+
+            ASSERT_EQ(2u, statistics.currentFrame().drawCalls);
+            ASSERT_EQ(42u, statistics.currentFrame().vertexCount);
+            ASSERT_EQ(1024u, statistics.currentFrame().uploadedBytes);
+            ASSERT_EQ(std::chrono::milliseconds(5), statistics.currentFrame().validateBrushesTime);
+            ASSERT_EQ(FrameStatistics::Duration::zero(), statistics.currentFrame().renderRenderablesTime);
+
+            statistics.endFrame();
+            ASSERT_EQ(1u, statistics.frameCount());
+            ASSERT_EQ(2u, statistics.lastFrame().drawCalls);
+            ASSERT_EQ(42u, statistics.lastFrame().vertexCount);
+            ASSERT_EQ(0u, statistics.currentFrame().drawCalls);
+
+            statistics.beginFrame();
+            statistics.countDrawCall(3);
+            statistics.endFrame();
+            ASSERT_EQ(2u, statistics.frameCount());
+            ASSERT_EQ(1u, statistics.lastFrame().drawCalls);
+            ASSERT_EQ(0u, statistics.lastFrame().uploadedBytes);
+        }
+
+        TEST_CASE("RenderStatisticsTest.timeRenderSection", "[RenderStatisticsTest]") {
+            RenderStatistics statistics;
+            statistics.beginFrame();
+            {
+                TimeRenderSection timer(statistics, RenderSection::CommitPendingChanges);
+            }
+            statistics.endFrame();
+
+            ASSERT_GE(statistics.lastFrame().commitPendingChangesTime, FrameStatistics::Duration::zero());
+            ASSERT_EQ(FrameStatistics::Duration::zero(), statistics.lastFrame().validateBrushesTime);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/RenderUtils.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        struct TestInstance {
+            std::string renderer;
+            size_t id;
+        };
+
+        static std::vector<std::vector<size_t>> groupedIds(std::vector<TestInstance> instances) {
+            const auto ranges = groupInstances(instances, [](const TestInstance& instance) { return instance.renderer; });
+
+            auto result = std::vector<std::vector<size_t>>{};
+            for (const auto& range : ranges) {
+                auto ids = std::vector<size_t>{};
+                for (size_t i = range.offset; i < range.offset + range.count; ++i) {
+                    // every instance in a range has the same renderer as the first one
+                    ASSERT_EQ(instances[range.offset].renderer, instances[i].renderer);
+                    ids.push_back(instances[i].id);
+                }
+                std::sort(std::begin(ids), std::end(ids));
+                result.push_back(ids);
+            }
+            return result;
+        }
+
+        TEST_CASE("RenderUtilsTest.groupInstances", "[RenderUtilsTest]") {
+            ASSERT_EQ(std::vector<std::vector<size_t>>{}, groupedIds({}));
+
+            ASSERT_EQ(std::vector<std::vector<size_t>>({ { 0u } }), groupedIds({
+                { "a", 0u }
+            }));
+
+            ASSERT_EQ(std::vector<std::vector<size_t>>({ { 0u, 1u, 2u } }), groupedIds({
+                { "a", 0u },
+                { "a", 1u },
+                { "a", 2u }
+            }));
+
+            // the ranges are ordered by renderer
+            ASSERT_EQ(std::vector<std::vector<size_t>>({ { 1u, 3u }, { 0u, 4u }, { 2u } }), groupedIds({
+                { "b", 0u },
+                { "a", 1u },
+                { "c", 2u },
+                { "a", 3u },
+                { "b", 4u }
+            }));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/Lasso.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace View {
+        TEST_CASE("LassoTest.perspectiveVolume", "[LassoTest]") {
+            const Renderer::PerspectiveCamera camera(90.0f, 1.0f, 1024.0f, Renderer::Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+            Lasso lasso(camera, 64.0, vm::vec3(64.0, 16.0, 16.0));
+            lasso.update(vm::vec3(64.0, -16.0, -16.0));
+
+            const auto volume = lasso.volume();
+            ASSERT_TRUE(volume.contains(vm::vec3(64.0, 0.0, 0.0)));
+            ASSERT_TRUE(volume.contains(vm::vec3(32.0, 4.0, -4.0)));
+            ASSERT_FALSE(volume.contains(vm::vec3(64.0, 20.0, 0.0)));
+
+            // the volume widens with the distance from the camera
+            ASSERT_TRUE(volume.contains(vm::vec3(128.0, 20.0, 0.0)));
+            ASSERT_FALSE(volume.contains(vm::vec3(128.0, 0.0, 40.0)));
+
+            // nothing behind the camera is contained
+            ASSERT_FALSE(volume.contains(vm::vec3(-64.0, 0.0, 0.0)));
+
+            ASSERT_TRUE(volume.intersects(vm::bbox3(vm::vec3(100.0, -100.0, -100.0), vm::vec3(200.0, 100.0, 100.0))));
+            ASSERT_TRUE(volume.intersects(vm::bbox3(vm::vec3(60.0, 10.0, 10.0), vm::vec3(70.0, 20.0, 20.0))));
+            ASSERT_FALSE(volume.intersects(vm::bbox3(vm::vec3(60.0, 20.0, 20.0), vm::vec3(70.0, 30.0, 30.0))));
+            ASSERT_FALSE(volume.intersects(vm::bbox3(vm::vec3(-200.0, -100.0, -100.0), vm::vec3(-100.0, 100.0, 100.0))));
+        }
+
+        TEST_CASE("LassoTest.orthographicVolume", "[LassoTest]") {
+            const Renderer::OrthographicCamera camera(1.0f, 1024.0f, Renderer::Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+            Lasso lasso(camera, 64.0, vm::vec3(64.0, 16.0, 16.0));
+            lasso.update(vm::vec3(64.0, -16.0, -16.0));
+
+            const auto volume = lasso.volume();
+            ASSERT_TRUE(volume.contains(vm::vec3(64.0, 0.0, 0.0)));
+            ASSERT_TRUE(volume.contains(vm::vec3(512.0, 15.0, -15.0)));
+            ASSERT_FALSE(volume.contains(vm::vec3(128.0, 20.0, 0.0)));
+            ASSERT_FALSE(volume.contains(vm::vec3(128.0, 0.0, -20.0)));
+
+            ASSERT_TRUE(volume.intersects(vm::bbox3(vm::vec3(100.0, -100.0, -100.0), vm::vec3(200.0, 100.0, 100.0))));
+            ASSERT_FALSE(volume.intersects(vm::bbox3(vm::vec3(100.0, 20.0, -100.0), vm::vec3(200.0, 100.0, 100.0))));
+        }
+
+        TEST_CASE("LassoTest.degenerateVolume", "[LassoTest]") {
+            const Renderer::PerspectiveCamera camera(90.0f, 1.0f, 1024.0f, Renderer::Camera::Viewport(0, 0, 800, 600), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+            Lasso lasso(camera, 64.0, vm::vec3(64.0, 16.0, 16.0));
+            lasso.update(vm::vec3(64.0, 16.0, -16.0));
+
+            const auto volume = lasso.volume();
+            ASSERT_FALSE(volume.contains(vm::vec3(64.0, 16.0, 0.0)));
+            ASSERT_FALSE(volume.intersects(vm::bbox3(vm::vec3(-100.0, -100.0, -100.0), vm::vec3(100.0, 100.0, 100.0))));
+        }
+    }
+}
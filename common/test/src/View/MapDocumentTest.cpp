@@ -31,6 +31,7 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
@@ -716,6 +717,47 @@ namespace TrenchBroom {
             ASSERT_TRUE(pickResult.query().all().empty());
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.pickNearest") {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* brushNode1 = document->world()->createBrush(builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture").value());
+            auto* brushNode2 = document->world()->createBrush(builder.createCuboid(vm::bbox3(vm::vec3(128, 0, 0), vm::vec3(192, 64, 64)), "texture").value());
+            document->addNode(brushNode1, document->parentForNodes());
+            document->addNode(brushNode2, document->parentForNodes());
+
+            const auto rays = std::vector<vm::ray3>{
+                vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x()),
+                vm::ray3(vm::vec3(96, 32, 32), vm::vec3::pos_x()),
+                vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::neg_x())
+            };
+
+            const auto filter = Model::TypedHitFilter(Model::BrushNode::BrushHitType);
+            const auto pickResults = document->pickNearest(rays, 1024.0, filter);
+            ASSERT_EQ(3u, pickResults.size());
+
+            // the second brush cannot yield a closer hit than the first one and is not picked
+            const auto hits1 = pickResults[0].query().all();
+            ASSERT_EQ(1u, hits1.size());
+            ASSERT_EQ(brushNode1, Model::hitToFaceHandle(hits1.front())->node());
+            ASSERT_DOUBLE_EQ(32.0, hits1.front().distance());
+
+            const auto hits2 = pickResults[1].query().all();
+            ASSERT_EQ(1u, hits2.size());
+            ASSERT_EQ(brushNode2, Model::hitToFaceHandle(hits2.front())->node());
+            ASSERT_DOUBLE_EQ(32.0, hits2.front().distance());
+
+            ASSERT_TRUE(pickResults[2].query().all().empty());
+
+            // a maximum distance that is closer than any hit yields no hits at all
+            const auto limitedPickResults = document->pickNearest(rays, 16.0, filter);
+            ASSERT_TRUE(limitedPickResults[0].query().all().empty());
+            ASSERT_TRUE(limitedPickResults[1].query().all().empty());
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.pickSimpleGroup") {
             // delete default brush
             document->selectAllNodes();
@@ -0,0 +1,137 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+#include "View/VertexHandleManager.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_set.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+#include "GTestCompat.h"
+
+namespace TrenchBroom {
+    namespace View {
+        namespace {
+            struct BoxVolume {
+                vm::bbox3 box;
+
+                bool contains(const vm::vec3& point) const {
+                    return box.contains(point);
+                }
+
+                bool intersects(const vm::bbox3& bounds) const {
+                    return box.intersects(bounds);
+                }
+            };
+        }
+
+        TEST_CASE("VertexHandleManagerTest.addRemoveHandles", "[VertexHandleManagerTest]") {
+            VertexHandleManager manager;
+
+            // these handles end up in different grid cells
+            manager.add(vm::vec3(0.0, 0.0, 0.0));
+            manager.add(vm::vec3(-1.0, -1.0, -1.0));
+            manager.add(vm::vec3(1000.0, 0.0, 0.0));
+            manager.add(vm::vec3(0.0, 0.0, 0.0));
+
+            ASSERT_EQ(3u, manager.totalHandleCount());
+            ASSERT_EQ(3u, manager.allHandles().size());
+            ASSERT_TRUE(manager.contains(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_TRUE(manager.contains(vm::vec3(-1.0, -1.0, -1.0)));
+            ASSERT_TRUE(manager.contains(vm::vec3(1000.0, 0.0, 0.0)));
+            ASSERT_FALSE(manager.contains(vm::vec3(1.0, 0.0, 0.0)));
+
+            // the first removal only removes a duplicate
+            ASSERT_TRUE(manager.remove(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_TRUE(manager.contains(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_TRUE(manager.remove(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_FALSE(manager.contains(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_FALSE(manager.remove(vm::vec3(0.0, 0.0, 0.0)));
+            ASSERT_EQ(2u, manager.totalHandleCount());
+
+            manager.clear();
+            ASSERT_EQ(0u, manager.totalHandleCount());
+            ASSERT_TRUE(manager.allHandles().empty());
+        }
+
+        TEST_CASE("VertexHandleManagerTest.selectCloseHandleInNeighbouringCell", "[VertexHandleManagerTest]") {
+            VertexHandleManager manager;
+            manager.add(vm::vec3(64.0, 0.0, 0.0));
+            manager.add(vm::vec3(128.0, 0.0, 0.0));
+
+            // this point is within the selection epsilon of the first handle, but lies in the cell below it
+            manager.select(vm::vec3(64.0 - 0.0000001, 0.0, 0.0));
+            ASSERT_EQ(1u, manager.selectedHandleCount());
+            ASSERT_TRUE(manager.selected(vm::vec3(64.0, 0.0, 0.0)));
+            ASSERT_FALSE(manager.selected(vm::vec3(128.0, 0.0, 0.0)));
+
+            ASSERT_TRUE(manager.remove(vm::vec3(64.0, 0.0, 0.0)));
+            ASSERT_EQ(0u, manager.selectedHandleCount());
+        }
+
+        TEST_CASE("VertexHandleManagerTest.findHandles", "[VertexHandleManagerTest]") {
+            VertexHandleManager manager;
+            manager.add(vm::vec3(0.0, 0.0, 0.0));
+            manager.add(vm::vec3(16.0, 16.0, 16.0));
+            manager.add(vm::vec3(512.0, 0.0, 0.0));
+
+            std::vector<vm::vec3> handles;
+            manager.findHandles(BoxVolume{vm::bbox3(vm::vec3(-8.0, -8.0, -8.0), vm::vec3(8.0, 8.0, 8.0))}, std::back_inserter(handles));
+            ASSERT_EQ(std::vector<vm::vec3>({vm::vec3(0.0, 0.0, 0.0)}), handles);
+        }
+
+        TEST_CASE("VertexHandleManagerTest.findIncidentBrushes", "[VertexHandleManagerTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            Model::WorldNode world(Model::Entity(), Model::MapFormat::Standard);
+            Model::BrushBuilder builder(&world, worldBounds);
+
+            auto brushNode1 = std::make_unique<Model::BrushNode>(builder.createCuboid(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(32.0, 32.0, 32.0)), "texture").value());
+            auto brushNode2 = std::make_unique<Model::BrushNode>(builder.createCuboid(vm::bbox3(vm::vec3(32.0, 0.0, 0.0), vm::vec3(64.0, 32.0, 32.0)), "texture").value());
+
+            VertexHandleManager manager;
+            manager.addHandles(brushNode1.get());
+            manager.addHandles(brushNode2.get());
+
+            const kdl::vector_set<Model::BrushNode*> brushes({ brushNode1.get(), brushNode2.get() });
+
+            ASSERT_EQ(std::vector<Model::BrushNode*>({ brushNode1.get() }), manager.findIncidentBrushes(vm::vec3(0.0, 0.0, 0.0), std::begin(brushes), std::end(brushes)));
+            ASSERT_EQ(std::vector<Model::BrushNode*>(std::begin(brushes), std::end(brushes)), manager.findIncidentBrushes(vm::vec3(32.0, 0.0, 0.0), std::begin(brushes), std::end(brushes)));
+
+            manager.removeHandles(brushNode2.get());
+            ASSERT_EQ(std::vector<Model::BrushNode*>({ brushNode1.get() }), manager.findIncidentBrushes(vm::vec3(32.0, 0.0, 0.0), std::begin(brushes), std::end(brushes)));
+
+            // a handle that was not added by a brush falls back to checking the brushes
+            manager.add(vm::vec3(64.0, 0.0, 0.0));
+            ASSERT_EQ(std::vector<Model::BrushNode*>({ brushNode2.get() }), manager.findIncidentBrushes(vm::vec3(64.0, 0.0, 0.0), std::begin(brushes), std::end(brushes)));
+        }
+    }
+}
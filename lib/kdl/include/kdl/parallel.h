@@ -21,7 +21,7 @@
 #include <atomic>
 #include <future> // for std::async
 #include <thread>
-#include <utility> // for std::declval
+#include <utility> // for std::declval, std::forward
 #include <vector>
 
 namespace kdl {
@@ -66,6 +66,37 @@ namespace kdl {
         }
     }
 
+    /**
+     * The minimum number of indices for which parallel_for_large spawns threads.
+     *
+     * Spawning and joining a thread with std::async costs in the order of tens of microseconds, and parallel_for
+     * spawns one thread per hardware thread on every call. The callers of parallel_for_large spend a few
+     * microseconds per index (triangulating a brush, generating the issues of a node), so a batch must contain a few
+     * hundred indices before the saved time outweighs the cost of the threads.
+     */
+    constexpr size_t parallel_for_min_count = 256;
+
+    /**
+     * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+     *
+     * If `count` is at least parallel_for_min_count, the lambda is executed in parallel as in parallel_for. Otherwise,
+     * it is executed sequentially on the calling thread, in order of increasing indices.
+     *
+     * @tparam L type of lambda
+     * @param count the maximum value (exclusive) to pass to lambda
+     * @param lambda the lambda to run
+     */
+    template<class L>
+    void parallel_for_large(const size_t count, L&& lambda) {
+        if (count < parallel_for_min_count) {
+            for (size_t i = 0; i < count; ++i) {
+                lambda(i);
+            }
+        } else {
+            parallel_for(count, std::forward<L>(lambda));
+        }
+    }
+
     /**
      * Applies the given lambda to each element of the input (passing elements as rvalue references),
      * and returns a vector of the resulting values, in their original order.
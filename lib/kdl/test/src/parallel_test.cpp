@@ -61,6 +61,27 @@ namespace kdl {
         }
     }
 
+    TEST_CASE("for_large", "[parallel_test]") {
+        // small counts are run sequentially and in order
+        std::vector<size_t> indices;
+        kdl::parallel_for_large(10, [&](const size_t i) { indices.push_back(i); });
+        CHECK(indices == std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+        const size_t largeSize = kdl::parallel_for_min_count * 4;
+        std::vector<std::atomic<size_t>> counts(largeSize);
+        for (auto& count : counts) {
+            count = 0;
+        }
+
+        kdl::parallel_for_large(largeSize, [&](const size_t i) {
+            std::atomic_fetch_add(&counts[i], static_cast<size_t>(1));
+        });
+
+        for (size_t i = 0; i < largeSize; ++i) {
+            CHECK(counts[i] == 1u);
+        }
+    }
+
     TEST_CASE("transform", "[parallel_test]") {
         const auto L = [](const int& v) { return v * 10; };
 